@@ -0,0 +1,412 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Allocator throughput benchmark
+ *
+ * exec's first-fit allocator walks the free list of each MemHeader, so its
+ * speed depends on fragmentation, region order and patches such as TLSFMem
+ * or PoolMem. The rate comes from whole batches, every call is also
+ * timed on its own to catch the worst case.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/execbase.h>
+#include <exec/memory.h>
+
+#include <proto/exec.h>
+#include <proto/graphics.h>
+
+#include "xsysinfo.h"
+#include "allocbench.h"
+#include "benchmark.h"
+#include "memory.h"
+#include "software.h"
+#include "profile.h"
+#include "gui.h"
+#include "locale_str.h"
+#include "debug.h"
+
+/* Global allocator benchmark results */
+AllocBenchmark alloc_bench;
+
+/* Block sizes per allocator */
+static const ULONG alloc_sizes[ALLOC_SIZE_COUNT] = {
+    16, 64, 256, 1024, 4096, 16384
+};
+
+/* Timer reads averaged to get the cost of one read */
+#define TIMER_READ_SAMPLES  256
+
+/* Column positions: results left, fragmentation right */
+#define ALLOC_COL_TYPE      28
+#define ALLOC_COL_FUNCTION  76
+#define ALLOC_COL_RATE      172
+#define ALLOC_COL_WORST     252
+#define ALLOC_COL_REGION    340
+#define ALLOC_COL_CHUNKS    420
+#define ALLOC_COL_LARGEST   476
+#define ALLOC_COL_FRAG      572
+#define ALLOC_ROW_HEIGHT    10
+
+/* External references */
+extern struct ExecBase *SysBase;
+extern AppContext *app;
+
+/*
+ * Get allocator name
+ */
+const char *get_allocator_string(AllocatorKind kind)
+{
+    switch (kind) {
+        case ALLOCATOR_ALLOCMEM: return "AllocMem";
+        case ALLOCATOR_ALLOCVEC: return "AllocVec";
+        case ALLOCATOR_POOL:     return "AllocPooled";
+        default:                 return "???";
+    }
+}
+
+/*
+ * Check whether AllocMem() was replaced by a patch in RAM
+ * Patches may live in 32-bit FAST RAM above the ROM, and the extended
+ * ROM is not a patch.
+ */
+BOOL allocmem_patched(void)
+{
+    ULONG vector = alloc_bench.valid ? alloc_bench.allocmem_vector :
+                   get_library_vector((struct Library *)SysBase, LVO_ALLOCMEM);
+
+    return !is_rom_address(vector);
+}
+
+/*
+ * Shortest measurable interval, subtracted from every timed call
+ */
+static ULONG measure_timer_overhead(void)
+{
+    ULONG best = 0xFFFFFFFF;
+    ULONG i;
+
+    for (i = 0; i < 16; i++) {
+        uint64_t start = get_timer_ticks();
+        ULONG elapsed = (ULONG)(get_timer_ticks() - start);
+        if (elapsed < best) best = elapsed;
+    }
+
+    return best;
+}
+
+/*
+ * Average cost of one timer read in nanoseconds
+ * Single reads round to whole microseconds, often to 0 on fast CPUs.
+ */
+static ULONG measure_timer_read_ns(void)
+{
+    uint64_t start = get_timer_ticks();
+    ULONG i;
+
+    for (i = 0; i < TIMER_READ_SAMPLES; i++) get_timer_ticks();
+
+    return (ULONG)((get_timer_ticks() - start) * 1000 / (TIMER_READ_SAMPLES + 1));
+}
+
+/*
+ * Time of a batch without the timer reads between its calls
+ */
+static ULONG batch_time_ns(uint64_t elapsed_us, ULONG calls, ULONG read_ns)
+{
+    uint64_t ns = elapsed_us * 1000;
+    uint64_t reads = (uint64_t)calls * read_ns;
+
+    return ns > reads ? (ULONG)(ns - reads) : 0;
+}
+
+/*
+ * Record the time of a single call for the worst case
+ */
+static void note_call(AllocResult *res, uint64_t start, uint64_t end, ULONG overhead)
+{
+    ULONG elapsed = (ULONG)(end - start);
+
+    elapsed = elapsed > overhead ? elapsed - overhead : 0;
+    if (elapsed > res->worst_us) res->worst_us = elapsed;
+}
+
+/*
+ * Time one allocator against one memory type
+ * Blocks are freed in two interleaved passes so that every other free
+ * has to coalesce with a neighbour, as in a real program. Each call
+ * reads the timer once, the end of one call is the start of the next.
+ * The rate uses the time of whole batches minus those reads.
+ */
+static void run_allocator(AllocatorKind kind, ULONG mem_flags, AllocResult *res)
+{
+    APTR blocks[ALLOC_BATCH];
+    APTR pool = NULL;
+    ULONG overhead = measure_timer_overhead();
+    ULONG read_ns = measure_timer_read_ns();
+    uint64_t total_ns = 0;
+    ULONG pairs = 0;
+    ULONG round, s, i;
+
+    memset(res, 0, sizeof(*res));
+
+    if (kind == ALLOCATOR_POOL) {
+        /* Pools are only in exec from V39 on */
+        if (SysBase->LibNode.lib_Version < 39) return;
+
+        pool = CreatePool(mem_flags, ALLOC_PUDDLE_SIZE, ALLOC_PUDDLE_THRESH);
+        if (!pool) return;
+    }
+
+    for (round = 0; round < ALLOC_ROUNDS; round++) {
+        for (s = 0; s < ALLOC_SIZE_COUNT; s++) {
+            ULONG size = alloc_sizes[s];
+            ULONG count = ALLOC_BATCH_BYTES / size;
+
+            ULONG calls = 0;
+            uint64_t batch_start, last, now;
+
+            if (count > ALLOC_BATCH) count = ALLOC_BATCH;
+
+            batch_start = last = get_timer_ticks();
+
+            for (i = 0; i < count; i++) {
+                switch (kind) {
+                    case ALLOCATOR_ALLOCMEM:
+                        blocks[i] = AllocMem(size, mem_flags);
+                        break;
+                    case ALLOCATOR_ALLOCVEC:
+                        blocks[i] = AllocVec(size, mem_flags);
+                        break;
+                    default:
+                        blocks[i] = AllocPooled(pool, size);
+                        break;
+                }
+
+                now = get_timer_ticks();
+                note_call(res, last, now, overhead);
+                last = now;
+                if (!blocks[i]) res->failed++;
+            }
+
+            total_ns += batch_time_ns(last - batch_start, count, read_ns);
+
+            batch_start = last = get_timer_ticks();
+
+            for (i = 0; i < count; i++) {
+                ULONG n = (i < count / 2) ? i * 2 : (i - count / 2) * 2 + 1;
+
+                if (n >= count || !blocks[n]) continue;
+
+                switch (kind) {
+                    case ALLOCATOR_ALLOCMEM:
+                        FreeMem(blocks[n], size);
+                        break;
+                    case ALLOCATOR_ALLOCVEC:
+                        FreeVec(blocks[n]);
+                        break;
+                    default:
+                        FreePooled(pool, blocks[n], size);
+                        break;
+                }
+
+                now = get_timer_ticks();
+                note_call(res, last, now, overhead);
+                last = now;
+                calls++;
+            }
+
+            total_ns += batch_time_ns(last - batch_start, calls, read_ns);
+            pairs += calls;
+        }
+    }
+
+    if (pool) DeletePool(pool);
+
+    if (total_ns == 0) total_ns = 1;
+    res->pairs_per_sec = (ULONG)(((uint64_t)pairs * 1000000000) / total_ns);
+
+    debug("  alloc: %s flags $%lx: %lu pairs/s, worst %lu us, %lu failed\n",
+          get_allocator_string(kind), (unsigned long)mem_flags,
+          (unsigned long)res->pairs_per_sec, (unsigned long)res->worst_us,
+          (unsigned long)res->failed);
+}
+
+/*
+ * Time all allocators against CHIP and FAST RAM
+ * Free lists are refreshed first, so the fragmentation shown next to the
+ * results is the one the allocators ran against.
+ */
+void run_alloc_benchmark(void)
+{
+    ULONG i, kind;
+
+    memset(&alloc_bench, 0, sizeof(alloc_bench));
+
+    for (i = 0; i < memory_regions.count; i++) {
+        refresh_memory_region(i);
+    }
+
+    alloc_bench.types[alloc_bench.count++].mem_flags = MEMF_CHIP;
+    if (AvailMem(MEMF_FAST) >= ALLOC_BATCH_BYTES * 2) {
+        alloc_bench.types[alloc_bench.count++].mem_flags = MEMF_FAST;
+    }
+
+    for (i = 0; i < alloc_bench.count; i++) {
+        for (kind = 0; kind < ALLOCATOR_COUNT; kind++) {
+            run_allocator((AllocatorKind)kind, alloc_bench.types[i].mem_flags,
+                          &alloc_bench.types[i].result[kind]);
+        }
+    }
+
+    alloc_bench.allocmem_vector = get_library_vector((struct Library *)SysBase, LVO_ALLOCMEM);
+    alloc_bench.valid = TRUE;
+}
+
+/*
+ * Draw allocator benchmark view
+ */
+void draw_alloc_view(void)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[32];
+    ULONG i, kind;
+    WORD y;
+    Button *btn;
+
+    /* Draw title panel */
+    draw_panel(20, 0, 600, 24, NULL);
+
+    SetAPen(rp, COLOR_TEXT);
+    SetBPen(rp, COLOR_PANEL_BG);
+    Move(rp, 220, 14);
+    Text(rp, (CONST_STRPTR)get_string(MSG_ALLOC_BENCHMARK),
+         strlen(get_string(MSG_ALLOC_BENCHMARK)));
+
+    /* Draw column headers */
+    y = 40;
+    SetAPen(rp, COLOR_TEXT);
+
+    TightText(rp, ALLOC_COL_TYPE, y, (CONST_STRPTR)get_string(MSG_ALLOC_TYPE), -1, 4);
+    TightText(rp, ALLOC_COL_FUNCTION, y, (CONST_STRPTR)get_string(MSG_ALLOC_FUNCTION), -1, 4);
+    TightText(rp, ALLOC_COL_RATE, y, (CONST_STRPTR)get_string(MSG_ALLOC_PAIRS), -1, 4);
+    TightText(rp, ALLOC_COL_WORST, y, (CONST_STRPTR)get_string(MSG_ALLOC_WORST), -1, 4);
+    TightText(rp, ALLOC_COL_REGION, y, (CONST_STRPTR)get_string(MSG_PRI_REGION), -1, 4);
+    TightText(rp, ALLOC_COL_CHUNKS, y, (CONST_STRPTR)get_string(MSG_ALLOC_CHUNKS), -1, 4);
+    TightText(rp, ALLOC_COL_LARGEST, y, (CONST_STRPTR)get_string(MSG_ALLOC_LARGEST), -1, 4);
+    TightText(rp, ALLOC_COL_FRAG, y, (CONST_STRPTR)get_string(MSG_ALLOC_FRAG), -1, 4);
+
+    /* Draw separator line */
+    SetAPen(rp, COLOR_BUTTON_DARK);
+    Move(rp, 20, y + 4);
+    Draw(rp, 628, y + 4);
+
+    /* Fragmentation of every region, next to the results */
+    y = 56;
+    for (i = 0; i < memory_regions.count && y < 170; i++) {
+        MemoryRegion *region = &memory_regions.regions[i];
+
+        format_region_label(i, buffer, sizeof(buffer));
+        draw_text(ALLOC_COL_REGION, y, buffer, COLOR_HIGHLIGHT);
+
+        snprintf(buffer, sizeof(buffer), "%lu%s", (unsigned long)region->num_chunks,
+                 region->chunks_truncated ? "+" : "");
+        draw_text(ALLOC_COL_CHUNKS, y, buffer, COLOR_HIGHLIGHT);
+
+        format_size(region->largest_block, buffer, sizeof(buffer));
+        draw_text(ALLOC_COL_LARGEST, y, buffer, COLOR_HIGHLIGHT);
+
+        snprintf(buffer, sizeof(buffer), "%u%%", (unsigned)region->frag_index);
+        draw_text(ALLOC_COL_FRAG, y, buffer, COLOR_HIGHLIGHT);
+
+        y += ALLOC_ROW_HEIGHT;
+    }
+
+    if (!alloc_bench.valid) {
+        draw_text(ALLOC_COL_TYPE, 66, get_string(MSG_SPEED_NOT_MEASURED), COLOR_TEXT);
+    } else {
+        /* One row per memory type and allocator */
+        y = 56;
+        for (i = 0; i < alloc_bench.count; i++) {
+            AllocTypeResult *type = &alloc_bench.types[i];
+
+            for (kind = 0; kind < ALLOCATOR_COUNT; kind++) {
+                AllocResult *res = &type->result[kind];
+
+                if (kind == 0) {
+                    draw_text(ALLOC_COL_TYPE, y,
+                              (type->mem_flags & MEMF_CHIP) ? "CHIP" : "FAST",
+                              COLOR_HIGHLIGHT);
+                }
+                draw_text(ALLOC_COL_FUNCTION, y,
+                          get_allocator_string((AllocatorKind)kind), COLOR_TEXT);
+
+                if (res->pairs_per_sec == 0) {
+                    draw_text(ALLOC_COL_RATE, y, "---", COLOR_HIGHLIGHT);
+                } else {
+                    snprintf(buffer, sizeof(buffer), "%lu",
+                             (unsigned long)res->pairs_per_sec);
+                    draw_text(ALLOC_COL_RATE, y, buffer, COLOR_HIGHLIGHT);
+
+                    /* Failed allocations make the numbers meaningless */
+                    snprintf(buffer, sizeof(buffer), "%lu us",
+                             (unsigned long)res->worst_us);
+                    draw_text(ALLOC_COL_WORST, y, buffer,
+                              res->failed ? COLOR_BAR_YOU : COLOR_HIGHLIGHT);
+                }
+                y += ALLOC_ROW_HEIGHT;
+            }
+        }
+
+        /* Patched AllocMem() explains unusual results */
+        y += ALLOC_ROW_HEIGHT;
+        snprintf(buffer, sizeof(buffer), "$%08lX",
+                 (unsigned long)alloc_bench.allocmem_vector);
+        draw_label_value(ALLOC_COL_TYPE, y, "AllocMem()", buffer, 96);
+        if (allocmem_patched()) {
+            draw_text(ALLOC_COL_TYPE + 184, y, get_string(MSG_ALLOC_PATCHED),
+                      COLOR_BAR_YOU);
+        }
+    }
+
+    /* Draw buttons */
+    btn = find_button(BTN_ALLOC_EXIT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_ALLOC_SPEED);
+    if (btn) draw_button(btn);
+}
+
+/*
+ * Update buttons for allocator benchmark view
+ */
+void alloc_view_update_buttons(void)
+{
+    add_button(20, 188, 60, 12,
+               get_string(MSG_BTN_EXIT), BTN_ALLOC_EXIT, TRUE);
+    add_button(100, 188, 60, 12,
+               get_string(MSG_BTN_SPEED), BTN_ALLOC_SPEED, TRUE);
+}
+
+/*
+ * Handle button press for allocator benchmark view
+ */
+void alloc_view_handle_button(ButtonID id)
+{
+    switch (id) {
+        case BTN_ALLOC_SPEED:
+            show_status_overlay(get_string(MSG_MEASURING_SPEED));
+            run_alloc_benchmark();
+            hide_status_overlay();
+            break;
+
+        case BTN_ALLOC_EXIT:
+            switch_to_view(VIEW_MEMORY);
+            break;
+
+        default:
+            break;
+    }
+}
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Allocator throughput benchmark header
+ */
+
+#ifndef ALLOCBENCH_H
+#define ALLOCBENCH_H
+
+#include "xsysinfo.h"
+
+/* Block sizes tried per allocator (16 bytes to 16K) */
+#define ALLOC_SIZE_COUNT    6
+
+/* Blocks held at once per size, capped by ALLOC_BATCH_BYTES */
+#define ALLOC_BATCH         32
+#define ALLOC_BATCH_BYTES   (64 * 1024)
+#define ALLOC_ROUNDS        8
+
+/* Pool parameters for CreatePool() */
+#define ALLOC_PUDDLE_SIZE   8192
+#define ALLOC_PUDDLE_THRESH 2048
+
+/* Memory types the benchmark runs against */
+#define MAX_ALLOC_TYPES     2
+
+/* Allocators under test */
+typedef enum {
+    ALLOCATOR_ALLOCMEM,     /* AllocMem()/FreeMem() */
+    ALLOCATOR_ALLOCVEC,     /* AllocVec()/FreeVec() */
+    ALLOCATOR_POOL,         /* AllocPooled()/FreePooled(), V39+ */
+    ALLOCATOR_COUNT
+} AllocatorKind;
+
+/* Result of one allocator on one memory type */
+typedef struct {
+    ULONG pairs_per_sec;    /* Allocate+free pairs per second, 0 = n/a */
+    ULONG worst_us;         /* Slowest single call */
+    ULONG failed;           /* Allocations that returned NULL */
+} AllocResult;
+
+/* Results for one memory type */
+typedef struct {
+    ULONG mem_flags;        /* MEMF_CHIP or MEMF_FAST */
+    AllocResult result[ALLOCATOR_COUNT];
+} AllocTypeResult;
+
+/* Allocator benchmark results */
+typedef struct {
+    AllocTypeResult types[MAX_ALLOC_TYPES];
+    ULONG count;
+    ULONG allocmem_vector;  /* Current AllocMem() entry point */
+    BOOL valid;             /* TRUE once measured */
+} AllocBenchmark;
+
+/* Global allocator benchmark results */
+extern AllocBenchmark alloc_bench;
+
+/* Function prototypes */
+
+/* Time all allocators against CHIP and FAST RAM */
+void run_alloc_benchmark(void);
+
+/* Allocator name ("AllocMem") */
+const char *get_allocator_string(AllocatorKind kind);
+
+/* TRUE if the AllocMem() vector points outside the Kickstart and extended ROM */
+BOOL allocmem_patched(void);
+
+/* Draw allocator benchmark view */
+void draw_alloc_view(void);
+
+#endif /* ALLOCBENCH_H */
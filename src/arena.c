@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Memory pool for the enumerated data
+ *
+ * The software, board, drive, SCSI and memory region lists live in one
+ * exec memory pool instead of fixed static arrays, so their footprint
+ * follows the machine and deleting the pool frees all of it. Exec only has
+ * memory pools from V39 on, while intuition V36 and graphics V37 are
+ * enough to run, so the amiga.lib pool functions are used: they call exec
+ * on V39 and emulate the pools with AllocMem() on V36 to V38.
+ */
+
+#include <string.h>
+
+#include <exec/memory.h>
+
+#include <clib/alib_protos.h>
+#include <proto/exec.h>
+
+#include "xsysinfo.h"
+#include "arena.h"
+#include "debug.h"
+
+/* Interned string, the text follows the link */
+typedef struct InternNode {
+    struct InternNode *next;
+    char text[1];
+} InternNode;
+
+static APTR arena_pool = NULL;
+static ULONG arena_bytes = 0;
+static ULONG arena_peak = 0;
+static InternNode *intern_table[ARENA_INTERN_BUCKETS];
+
+/*
+ * Allocate from the pool, creating it on first use
+ */
+APTR arena_alloc(ULONG size)
+{
+    APTR block;
+
+    if (!arena_pool) {
+        arena_pool = LibCreatePool(MEMF_ANY, ARENA_PUDDLE_SIZE, ARENA_PUDDLE_THRESH);
+        if (!arena_pool) return NULL;
+    }
+
+    block = LibAllocPooled(arena_pool, size);
+    if (block) {
+        arena_bytes += size;
+        if (arena_bytes > arena_peak) arena_peak = arena_bytes;
+    }
+
+    return block;
+}
+
+/*
+ * Grow an array to at least needed items, doubling its capacity
+ * The first count items are copied and the old block goes back to the
+ * pool. Never call this under Forbid(): a large block is a plain
+ * AllocMem(), which may run the low-memory handlers, and ramlib's
+ * handler expunges libraries from the lists being walked.
+ */
+APTR arena_grow(APTR items, ULONG count, ULONG *capacity, ULONG needed, ULONG item_size)
+{
+    ULONG new_capacity = *capacity ? *capacity * 2 : ARENA_MIN_ITEMS;
+    APTR grown;
+
+    while (new_capacity < needed) new_capacity *= 2;
+
+    grown = arena_alloc(new_capacity * item_size);
+    if (!grown) return items;
+
+    if (items) {
+        if (count > 0) CopyMem(items, grown, count * item_size);
+        LibFreePooled(arena_pool, items, *capacity * item_size);
+        arena_bytes -= *capacity * item_size;
+    }
+
+    *capacity = new_capacity;
+    return grown;
+}
+
+/*
+ * Nodes in an exec list, counted under Forbid()
+ * Used to size a snapshot buffer before the list is copied.
+ */
+ULONG arena_count_nodes(struct List *list)
+{
+    struct Node *node;
+    ULONG count = 0;
+
+    Forbid();
+    for (node = list->lh_Head; node->ln_Succ != NULL; node = node->ln_Succ) count++;
+    Permit();
+
+    return count;
+}
+
+/*
+ * Pool copy of a string, equal strings share one copy
+ * Re-enumerating a list therefore does not grow the pool.
+ */
+const char *arena_intern(const char *text)
+{
+    const UBYTE *p;
+    InternNode *node;
+    ULONG hash = 5381;
+    ULONG len;
+
+    if (!text) return NULL;
+
+    for (p = (const UBYTE *)text; *p; p++) hash = hash * 33 + *p;
+    hash %= ARENA_INTERN_BUCKETS;
+
+    for (node = intern_table[hash]; node; node = node->next) {
+        if (strcmp(node->text, text) == 0) return node->text;
+    }
+
+    len = strlen(text);
+    node = arena_alloc(sizeof(InternNode) + len);
+    if (!node) return NULL;
+
+    memcpy(node->text, text, len + 1);
+    node->next = intern_table[hash];
+    intern_table[hash] = node;
+
+    return node->text;
+}
+
+/*
+ * Delete the pool and everything allocated from it
+ */
+void arena_free(void)
+{
+    if (!arena_pool) return;
+
+    debug("  arena: %lu bytes in use, peak %lu\n",
+          (unsigned long)arena_bytes, (unsigned long)arena_peak);
+
+    LibDeletePool(arena_pool);
+    arena_pool = NULL;
+    arena_bytes = 0;
+    arena_peak = 0;
+    memset(intern_table, 0, sizeof(intern_table));
+}
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Memory pool for the enumerated data header
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "xsysinfo.h"
+
+/* Pool puddles, blocks above the threshold get their own allocation */
+#define ARENA_PUDDLE_SIZE       4096
+#define ARENA_PUDDLE_THRESH     1024
+
+/* First allocation of a growable array, doubled from then on */
+#define ARENA_MIN_ITEMS         8
+
+/* Hash buckets of the string table */
+#define ARENA_INTERN_BUCKETS    64
+
+/* Spare items reserved for a list that may grow between counting its
+ * nodes and copying them under Forbid() */
+#define ARENA_SNAPSHOT_SLACK    8
+
+/* Attempts to snapshot a list that keeps outgrowing the reserved room */
+#define ARENA_SNAPSHOT_RETRIES  3
+
+/*
+ * Make room for needed items in a growable array, keeping the first count
+ * Evaluates to FALSE if the pool is out of memory, the array is then
+ * left as it was. Not under Forbid(), see arena_grow().
+ */
+#define ARENA_RESERVE_N(items, count, capacity, needed) \
+    ((needed) <= (capacity) || \
+     ((items) = arena_grow((items), (count), &(capacity), (needed), sizeof(*(items))), \
+      (needed) <= (capacity)))
+
+/* Make room for one more item */
+#define ARENA_RESERVE(items, count, capacity) \
+    ARENA_RESERVE_N(items, count, capacity, (count) + 1)
+
+/* Function prototypes */
+
+/* Allocate from the pool, NULL if out of memory */
+APTR arena_alloc(ULONG size);
+
+/* Grow an array to at least needed items, returns the old array if out of memory */
+APTR arena_grow(APTR items, ULONG count, ULONG *capacity, ULONG needed, ULONG item_size);
+
+/* Nodes in an exec list, counted under Forbid() */
+ULONG arena_count_nodes(struct List *list);
+
+/* Pool copy of a string, equal strings share one copy */
+const char *arena_intern(const char *text);
+
+/* Delete the pool and everything allocated from it */
+void arena_free(void);
+
+#endif /* ARENA_H */
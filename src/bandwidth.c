@@ -0,0 +1,255 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Cross-region copy bandwidth matrix and view
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/execbase.h>
+#include <exec/memory.h>
+
+#include <proto/exec.h>
+#include <proto/graphics.h>
+
+#include "xsysinfo.h"
+#include "bandwidth.h"
+#include "benchmark.h"
+#include "memory.h"
+#include "gui.h"
+#include "locale_str.h"
+#include "debug.h"
+
+/* Global copy bandwidth matrix */
+CopyMatrix copy_matrix;
+
+/* Matrix layout */
+#define COPY_LABEL_X        28
+#define COPY_CELL_X         176
+#define COPY_CELL_WIDTH     54
+#define COPY_ROW_HEIGHT     10
+
+/* External references */
+extern struct ExecBase *SysBase;
+extern AppContext *app;
+
+/*
+ * Allocate a 16-byte aligned buffer inside a specific memory region
+ * AllocMem() cannot be told which MemHeader to use, so pick a free
+ * chunk of the region and claim it with AllocAbs().
+ */
+APTR alloc_in_region(const MemoryRegion *region, ULONG size)
+{
+    struct MemHeader *mh;
+    struct MemChunk *mc;
+    APTR result = NULL;
+
+    Forbid();
+
+    for (mh = (struct MemHeader *)SysBase->MemList.lh_Head;
+         (struct Node *)mh != (struct Node *)&SysBase->MemList.lh_Tail;
+         mh = (struct MemHeader *)mh->mh_Node.ln_Succ) {
+
+        if (mh->mh_Lower != region->lower_bound) continue;
+
+        for (mc = mh->mh_First; mc != NULL; mc = mc->mc_Next) {
+            ULONG start = ((ULONG)mc + 15) & ~15;
+
+            if (start + size <= (ULONG)mc + mc->mc_Bytes) {
+                result = AllocAbs(size, (APTR)start);
+                break;
+            }
+        }
+        break;
+    }
+
+    Permit();
+
+    return result;
+}
+
+/*
+ * Find the fastest kernel for one source/destination pair
+ */
+static void measure_copy_pair(ULONG row, ULONG col, APTR src, APTR dst)
+{
+    const MemoryRegion *from = &memory_regions.regions[copy_matrix.region[row]];
+    const MemoryRegion *to = &memory_regions.regions[copy_matrix.region[col]];
+    CopyKernel kernel;
+    ULONG speed;
+
+    copy_matrix.speed[row][col] = 0;
+    copy_matrix.kernel[row][col] = COPY_KERNEL_NONE;
+
+    for (kernel = COPY_KERNEL_MOVEM; kernel <= COPY_KERNEL_COPYMEMQUICK; kernel++) {
+        /* move16 into or out of CHIP RAM hangs some 040 boards */
+        if (kernel == COPY_KERNEL_MOVE16 &&
+            ((from->mem_type | to->mem_type) & MEMF_CHIP)) {
+            continue;
+        }
+
+        speed = measure_copy_speed(dst, src, COPY_BUFFER_SIZE,
+                                   COPY_ITERATIONS, kernel);
+        if (speed > copy_matrix.speed[row][col]) {
+            copy_matrix.speed[row][col] = speed;
+            copy_matrix.kernel[row][col] = (UBYTE)kernel;
+        }
+    }
+
+    debug("  copy: %lu -> %lu: %lu bytes/s (%s)\n",
+          (unsigned long)copy_matrix.region[row],
+          (unsigned long)copy_matrix.region[col],
+          (unsigned long)copy_matrix.speed[row][col],
+          get_copy_kernel_string(copy_matrix.kernel[row][col]));
+}
+
+/*
+ * Measure copy bandwidth between all pairs of memory regions
+ * Each region gets a source and a destination buffer so that copies
+ * within the same region are measured as well.
+ */
+void run_copy_matrix(void)
+{
+    APTR src_buf[MAX_COPY_REGIONS];
+    APTR dst_buf[MAX_COPY_REGIONS];
+    ULONG row, col;
+
+    memset(&copy_matrix, 0, sizeof(copy_matrix));
+
+    for (row = 0; row < memory_regions.count && row < MAX_COPY_REGIONS; row++) {
+        const MemoryRegion *region = &memory_regions.regions[row];
+
+        copy_matrix.region[row] = row;
+        src_buf[row] = alloc_in_region(region, COPY_BUFFER_SIZE);
+        dst_buf[row] = alloc_in_region(region, COPY_BUFFER_SIZE);
+        copy_matrix.count++;
+    }
+
+    for (row = 0; row < copy_matrix.count; row++) {
+        for (col = 0; col < copy_matrix.count; col++) {
+            if (!src_buf[row] || !dst_buf[col]) continue;
+            measure_copy_pair(row, col, src_buf[row], dst_buf[col]);
+        }
+    }
+
+    for (row = 0; row < copy_matrix.count; row++) {
+        if (src_buf[row]) FreeMem(src_buf[row], COPY_BUFFER_SIZE);
+        if (dst_buf[row]) FreeMem(dst_buf[row], COPY_BUFFER_SIZE);
+    }
+
+    copy_matrix.valid = TRUE;
+}
+
+/*
+ * Format a matrix cell in MB/s
+ */
+void format_copy_speed(ULONG speed, char *buffer, ULONG size)
+{
+    if (speed == 0) {
+        snprintf(buffer, size, "---");
+        return;
+    }
+
+    format_scaled(buffer, size, speed / 10000, TRUE);
+}
+
+/*
+ * Draw copy bandwidth view
+ */
+void draw_copy_view(void)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[32];
+    ULONG row, col;
+    WORD y;
+    Button *btn;
+
+    /* Draw title panel */
+    draw_panel(20, 0, 600, 24, NULL);
+
+    SetAPen(rp, COLOR_TEXT);
+    SetBPen(rp, COLOR_PANEL_BG);
+    Move(rp, 220, 14);
+    Text(rp, (CONST_STRPTR)get_string(MSG_COPY_BANDWIDTH),
+         strlen(get_string(MSG_COPY_BANDWIDTH)));
+
+    /* Draw matrix panel */
+    draw_panel(20, 28, 600, 156, NULL);
+
+    /* Column headers: destination regions */
+    y = 40;
+    draw_text(COPY_LABEL_X, y, get_string(MSG_COPY_FROM_TO), COLOR_TEXT);
+    for (col = 0; col < copy_matrix.count; col++) {
+        snprintf(buffer, sizeof(buffer), "%lu",
+                 (unsigned long)(copy_matrix.region[col] + 1));
+        draw_text(COPY_CELL_X + col * COPY_CELL_WIDTH, y, buffer, COLOR_TEXT);
+    }
+
+    SetAPen(rp, COLOR_TEXT);
+    Move(rp, COPY_LABEL_X, y + 3);
+    Draw(rp, 612, y + 3);
+
+    if (!copy_matrix.valid) {
+        draw_text(220, 100, get_string(MSG_SPEED_NOT_MEASURED), COLOR_TEXT);
+    } else {
+        /* One row per source region */
+        y = 54;
+        for (row = 0; row < copy_matrix.count; row++) {
+            format_region_label(copy_matrix.region[row], buffer, sizeof(buffer));
+            draw_text(COPY_LABEL_X, y, buffer, COLOR_TEXT);
+
+            for (col = 0; col < copy_matrix.count; col++) {
+                format_copy_speed(copy_matrix.speed[row][col], buffer, sizeof(buffer));
+                draw_text(COPY_CELL_X + col * COPY_CELL_WIDTH, y, buffer,
+                          COLOR_HIGHLIGHT);
+            }
+            y += COPY_ROW_HEIGHT;
+        }
+
+        /* Kernels that were tried on this CPU */
+        snprintf(buffer, sizeof(buffer), "movem, %sCopyMemQuick",
+                 (SysBase->AttnFlags & AFF_68040) ? "move16, " : "");
+        draw_label_value(COPY_LABEL_X, 172, get_string(MSG_COPY_KERNELS),
+                         buffer, 148);
+    }
+
+    /* Draw buttons */
+    btn = find_button(BTN_COPY_EXIT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_COPY_SPEED);
+    if (btn) draw_button(btn);
+}
+
+/*
+ * Update buttons for copy bandwidth view
+ */
+void copy_view_update_buttons(void)
+{
+    add_button(20, 188, 60, 12,
+               get_string(MSG_BTN_EXIT), BTN_COPY_EXIT, TRUE);
+    add_button(100, 188, 60, 12,
+               get_string(MSG_BTN_SPEED), BTN_COPY_SPEED, TRUE);
+}
+
+/*
+ * Handle button press for copy bandwidth view
+ */
+void copy_view_handle_button(ButtonID id)
+{
+    switch (id) {
+        case BTN_COPY_SPEED:
+            show_status_overlay(get_string(MSG_MEASURING_SPEED));
+            run_copy_matrix();
+            hide_status_overlay();
+            break;
+
+        case BTN_COPY_EXIT:
+            switch_to_view(VIEW_MEMORY);
+            break;
+
+        default:
+            break;
+    }
+}
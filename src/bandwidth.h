@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Cross-region copy bandwidth header
+ */
+
+#ifndef BANDWIDTH_H
+#define BANDWIDTH_H
+
+#include "xsysinfo.h"
+#include "benchmark.h"
+#include "memory.h"
+
+/* Largest matrix that fits the view (8x8) */
+#define MAX_COPY_REGIONS    8
+
+/* Test buffer size per region and copy passes per kernel */
+#define COPY_BUFFER_SIZE    (16 * 1024)
+#define COPY_ITERATIONS     8
+
+/* Copy bandwidth matrix, rows are sources, columns destinations */
+typedef struct {
+    ULONG region[MAX_COPY_REGIONS];     /* Index into memory_regions */
+    ULONG speed[MAX_COPY_REGIONS][MAX_COPY_REGIONS];    /* Bytes/sec, 0 = n/a */
+    UBYTE kernel[MAX_COPY_REGIONS][MAX_COPY_REGIONS];   /* Fastest CopyKernel */
+    ULONG count;
+    BOOL valid;                         /* TRUE once measured */
+} CopyMatrix;
+
+/* Global copy bandwidth matrix */
+extern CopyMatrix copy_matrix;
+
+/* Function prototypes */
+
+/* Measure copy bandwidth between all pairs of memory regions */
+void run_copy_matrix(void);
+
+/* Allocate a 16-byte aligned buffer inside a specific memory region */
+APTR alloc_in_region(const MemoryRegion *region, ULONG size);
+
+/* Format a matrix cell in MB/s ("12.3", "---" if not measured) */
+void format_copy_speed(ULONG speed, char *buffer, ULONG size);
+
+/* Draw copy bandwidth view */
+void draw_copy_view(void);
+
+#endif /* BANDWIDTH_H */
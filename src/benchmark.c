@@ -11,13 +11,19 @@
 #include <exec/execbase.h>
 #include <exec/memory.h>
 #include <devices/timer.h>
+#include <hardware/cia.h>
+#include <resources/cia.h>
 
 #include <proto/exec.h>
+#include <proto/cia.h>
 #include <proto/timer.h>
 
 #include "xsysinfo.h"
 #include "benchmark.h"
 #include "hardware.h"
+#include "software.h"
+#include "mmu.h"
+#include "debug.h"
 
 /* Global benchmark results */
 BenchmarkResults bench_results;
@@ -53,6 +59,17 @@ static struct timerequest *timer_req = NULL;
 struct Device *TimerBase = NULL;
 static BOOL timer_open = FALSE;
 
+/* CIA-B timers for the sampler and the latency benchmark */
+#define CIAB_BASE           ((volatile struct CIA *)0xBFD000)
+static struct Library *ciab_base = NULL;
+
+/* Periodic timer for live views, signals the main loop */
+static struct MsgPort *live_port = NULL;
+static struct timerequest *live_req = NULL;
+static BOOL live_open = FALSE;
+static BOOL live_pending = FALSE;
+static ULONG live_interval = 0;
+
 /* External references */
 extern struct ExecBase *SysBase;
 extern HardwareInfo hw_info;
@@ -92,11 +109,190 @@ BOOL init_timer(void)
     return TRUE;
 }
 
+/*
+ * Queue the next live timer request
+ */
+static void send_live_request(void)
+{
+    live_req->tr_node.io_Command = TR_ADDREQUEST;
+    live_req->tr_time.tv_secs = live_interval / 1000000UL;
+    live_req->tr_time.tv_micro = live_interval % 1000000UL;
+    SendIO((struct IORequest *)live_req);
+    live_pending = TRUE;
+}
+
+/*
+ * Start the periodic live timer (UNIT_VBLANK, interval in vertical blanks)
+ */
+BOOL start_live_timer(ULONG vblanks)
+{
+    ULONG hz = SysBase->VBlankFrequency ? SysBase->VBlankFrequency : 50;
+
+    stop_live_timer();
+
+    live_port = CreateMsgPort();
+    if (!live_port) return FALSE;
+
+    live_req = (struct timerequest *)
+        CreateIORequest(live_port, sizeof(struct timerequest));
+    if (!live_req ||
+        OpenDevice((CONST_STRPTR)"timer.device", UNIT_VBLANK,
+                   (struct IORequest *)live_req, 0) != 0) {
+        stop_live_timer();
+        return FALSE;
+    }
+    live_open = TRUE;
+
+    live_interval = (vblanks * 1000000UL) / hz;
+    send_live_request();
+
+    return TRUE;
+}
+
+/*
+ * Stop the live timer, aborting a pending request
+ */
+void stop_live_timer(void)
+{
+    if (live_pending) {
+        AbortIO((struct IORequest *)live_req);
+        WaitIO((struct IORequest *)live_req);
+        live_pending = FALSE;
+    }
+
+    if (live_open) {
+        CloseDevice((struct IORequest *)live_req);
+        live_open = FALSE;
+    }
+
+    if (live_req) {
+        DeleteIORequest((struct IORequest *)live_req);
+        live_req = NULL;
+    }
+
+    if (live_port) {
+        DeleteMsgPort(live_port);
+        live_port = NULL;
+    }
+}
+
+/*
+ * Signal mask of the live timer (0 if not running)
+ */
+ULONG get_live_timer_signal(void)
+{
+    return live_port ? (1UL << live_port->mp_SigBit) : 0;
+}
+
+/*
+ * Check whether the live timer fired, re-arming it if so
+ */
+BOOL check_live_timer(void)
+{
+    if (!live_port || !live_pending) return FALSE;
+
+    if (!GetMsg(live_port)) return FALSE;
+
+    send_live_request();
+    return TRUE;
+}
+
+/*
+ * E clock frequency, the rate of the CIA timers
+ */
+ULONG get_eclock_frequency(void)
+{
+    return SysBase->ex_EClockFrequency ? SysBase->ex_EClockFrequency : DEFAULT_ECLOCK;
+}
+
+/*
+ * Claim a free CIA-B timer for an interrupt
+ * Returns CIAICRB_TA or CIAICRB_TB, or -1 if both are in use.
+ */
+WORD claim_ciab_timer(struct Interrupt *is)
+{
+    if (!ciab_base) {
+        ciab_base = (struct Library *)OpenResource((CONST_STRPTR)CIABNAME);
+        if (!ciab_base) return -1;
+    }
+
+    if (!AddICRVector(ciab_base, CIAICRB_TA, is)) return CIAICRB_TA;
+    if (!AddICRVector(ciab_base, CIAICRB_TB, is)) return CIAICRB_TB;
+
+    return -1;
+}
+
+/*
+ * Stop and release a claimed CIA-B timer
+ */
+void release_ciab_timer(WORD timer, struct Interrupt *is)
+{
+    stop_ciab_timer(timer);
+    RemICRVector(ciab_base, timer, is);
+}
+
+/*
+ * Program and start a claimed timer in continuous mode
+ */
+void start_ciab_timer(WORD timer, ULONG period)
+{
+    volatile struct CIA *cia = CIAB_BASE;
+
+    if (period > 0xFFFF) period = 0xFFFF;
+
+    if (timer == CIAICRB_TA) {
+        cia->ciacra &= (CIACRAF_SPMODE | CIACRAF_TODIN);
+        cia->ciatalo = (UBYTE)period;
+        cia->ciatahi = (UBYTE)(period >> 8);
+        cia->ciacra |= CIACRAF_LOAD | CIACRAF_START;
+    } else {
+        cia->ciacrb &= CIACRBF_ALARM;
+        cia->ciatblo = (UBYTE)period;
+        cia->ciatbhi = (UBYTE)(period >> 8);
+        cia->ciacrb |= CIACRBF_LOAD | CIACRBF_START;
+    }
+}
+
+/*
+ * Stop a claimed timer
+ */
+void stop_ciab_timer(WORD timer)
+{
+    volatile struct CIA *cia = CIAB_BASE;
+
+    if (timer == CIAICRB_TA) {
+        cia->ciacra &= ~CIACRAF_START;
+    } else {
+        cia->ciacrb &= ~CIACRBF_START;
+    }
+}
+
+/*
+ * Current count of a running timer
+ * The high byte is read again in case the low byte wrapped in between.
+ */
+UWORD read_ciab_timer(WORD timer)
+{
+    volatile struct CIA *cia = CIAB_BASE;
+    volatile UBYTE *hi = (timer == CIAICRB_TA) ? &cia->ciatahi : &cia->ciatbhi;
+    volatile UBYTE *lo = (timer == CIAICRB_TA) ? &cia->ciatalo : &cia->ciatblo;
+    UBYTE h, l;
+
+    do {
+        h = *hi;
+        l = *lo;
+    } while (h != *hi);
+
+    return (UWORD)((h << 8) | l);
+}
+
 /*
  * Cleanup timer
  */
 void cleanup_timer(void)
 {
+    stop_live_timer();
+
     if (timer_open) {
         CloseDevice((struct IORequest *)timer_req);
         timer_open = FALSE;
@@ -130,6 +326,44 @@ uint64_t get_timer_ticks(void)
     return (uint64_t)tv.tv_secs * 1000000ULL + tv.tv_micro;
 }
 
+/* Longest Forbid() section seen by timed_forbid()/timed_permit() */
+static uint64_t forbid_start;
+static ULONG worst_forbid_us;
+static const char *worst_forbid_what = "none";
+
+/*
+ * Enter a Forbid() section whose duration is tracked
+ */
+void timed_forbid(void)
+{
+    Forbid();
+    forbid_start = get_timer_ticks();
+}
+
+/*
+ * Leave a tracked Forbid() section, remembering the worst one
+ */
+void timed_permit(const char *what)
+{
+    ULONG elapsed = (ULONG)(get_timer_ticks() - forbid_start);
+
+    Permit();
+
+    if (elapsed > worst_forbid_us) {
+        worst_forbid_us = elapsed;
+        worst_forbid_what = what;
+    }
+}
+
+/*
+ * Report the longest tracked Forbid() section in the debug output
+ */
+void report_worst_forbid(void)
+{
+    debug(XSYSINFO_NAME ": Worst Forbid() section %lu us (%s)\n",
+          (unsigned long)worst_forbid_us, worst_forbid_what);
+}
+
 /*
  * Wait for specified number of microseconds
  */
@@ -387,6 +621,236 @@ ULONG measure_mem_read_speed(volatile ULONG *src, ULONG buffer_size, ULONG itera
     return 0;
 }
 
+/* Access kinds for bus timing */
+typedef enum {
+    ACCESS_NONE,        /* Register move only: instruction overhead */
+    ACCESS_BYTE,
+    ACCESS_WORD,
+    ACCESS_LONG
+} AccessKind;
+
+/* Loop iterations for bus timing; 16 accesses per iteration */
+#define BUS_PROBE_LOOPS     2048
+#define BUS_PROBE_UNROLL    16
+
+/*
+ * Time BUS_PROBE_LOOPS * 16 reads of the same address
+ * Returns elapsed microseconds
+ */
+static ULONG time_access_loop(volatile UBYTE *addr, AccessKind kind)
+{
+    ULONG count = BUS_PROBE_LOOPS;
+    ULONG start = get_timer_ticks();
+
+    switch (kind) {
+        case ACCESS_BYTE:
+            __asm__ volatile (
+                "1:\n\t"
+                ".rept 16\n\t"
+                "move.b (%1),%%d0\n\t"
+                ".endr\n\t"
+                "subq.l #1,%0\n\t"
+                "bne.s 1b"
+                : "+d" (count)
+                : "a" (addr)
+                : "d0", "cc", "memory"
+            );
+            break;
+        case ACCESS_WORD:
+            __asm__ volatile (
+                "1:\n\t"
+                ".rept 16\n\t"
+                "move.w (%1),%%d0\n\t"
+                ".endr\n\t"
+                "subq.l #1,%0\n\t"
+                "bne.s 1b"
+                : "+d" (count)
+                : "a" (addr)
+                : "d0", "cc", "memory"
+            );
+            break;
+        case ACCESS_LONG:
+            __asm__ volatile (
+                "1:\n\t"
+                ".rept 16\n\t"
+                "move.l (%1),%%d0\n\t"
+                ".endr\n\t"
+                "subq.l #1,%0\n\t"
+                "bne.s 1b"
+                : "+d" (count)
+                : "a" (addr)
+                : "d0", "cc", "memory"
+            );
+            break;
+        default:
+            __asm__ volatile (
+                "1:\n\t"
+                ".rept 16\n\t"
+                "move.l %%d1,%%d0\n\t"
+                ".endr\n\t"
+                "subq.l #1,%0\n\t"
+                "bne.s 1b"
+                : "+d" (count)
+                :
+                : "d0", "d1", "cc"
+            );
+            break;
+    }
+
+    return (ULONG)(get_timer_ticks() - start);
+}
+
+/*
+ * Nanoseconds per access with the instruction overhead removed
+ */
+static ULONG access_ns(volatile UBYTE *addr, AccessKind kind, ULONG base_us)
+{
+    ULONG us = time_access_loop(addr, kind);
+
+    if (us <= base_us) return 1;
+
+    return (ULONG)(((uint64_t)(us - base_us) * 1000ULL) /
+                   (BUS_PROBE_LOOPS * BUS_PROBE_UNROLL));
+}
+
+/*
+ * Measure byte/word/long access times at an address, aligned and
+ * (on 68020+) misaligned. addr must be longword aligned.
+ * The data cache is switched off so every read reaches the bus.
+ */
+void measure_bus_timing(volatile UBYTE *addr, BusTiming *timing)
+{
+    ULONG base_us;
+    ULONG old_cacr;
+
+    memset(timing, 0, sizeof(*timing));
+
+    if (!TimerBase) return;
+
+    old_cacr = CacheControl(0, CACRF_EnableD);
+
+    base_us = time_access_loop(NULL, ACCESS_NONE);
+
+    timing->byte_ns = access_ns(addr, ACCESS_BYTE, base_us);
+    timing->word_ns = access_ns(addr, ACCESS_WORD, base_us);
+    timing->long_ns = access_ns(addr, ACCESS_LONG, base_us);
+
+    /* 68000/68010 raise an address error on misaligned accesses */
+    if (SysBase->AttnFlags & AFF_68020) {
+        timing->word_misaligned_ns = access_ns(addr + 1, ACCESS_WORD, base_us);
+        timing->long_misaligned_ns = access_ns(addr + 1, ACCESS_LONG, base_us);
+    }
+
+    CacheControl(old_cacr, CACRF_EnableD);
+}
+
+/*
+ * Measure copy bandwidth from src to dst with one copy kernel
+ * Both buffers must be 16-byte aligned. Returns bytes per second.
+ */
+ULONG measure_copy_speed(APTR dst, APTR src, ULONG buffer_size,
+                         ULONG iterations, CopyKernel kernel)
+{
+    ULONG start_time, end_time, elapsed, overhead;
+    ULONG total_copied = 0;
+    ULONG loop_count;
+    ULONG i;
+
+    if (!TimerBase) return 0;
+
+    /* move16 only works on 16-byte aligned lines */
+    if (((ULONG)src | (ULONG)dst) & 15) return 0;
+
+    loop_count = buffer_size / 128; /* 128 bytes per loop iteration */
+    if (loop_count == 0) return 0;
+
+    if (kernel == COPY_KERNEL_MOVE16 && !(SysBase->AttnFlags & AFF_68040)) {
+        return 0;
+    }
+
+    start_time = get_timer_ticks();
+
+    for (i = 0; i < iterations; i++) {
+        APTR s = src;
+        APTR d = dst;
+        ULONG count = loop_count;
+
+        switch (kernel) {
+            case COPY_KERNEL_MOVEM:
+                /* 4x unrolled movem.l (8 regs) = 128 bytes per iteration */
+                __asm__ volatile (
+                    "1:\n\t"
+                    ".rept 4\n\t"
+                    "movem.l (%0)+,%%d1-%%d6/%%a2-%%a3\n\t"
+                    "movem.l %%d1-%%d6/%%a2-%%a3,(%1)\n\t"
+                    "lea 32(%1),%1\n\t"
+                    ".endr\n\t"
+                    "subq.l #1,%2\n\t"
+                    "bne.s 1b"
+                    : "+a" (s), "+a" (d), "+d" (count)
+                    :
+                    : "d1", "d2", "d3", "d4", "d5", "d6", "a2", "a3",
+                      "cc", "memory"
+                );
+                break;
+
+            case COPY_KERNEL_MOVE16:
+                /* 8x move16 (a0)+,(a1)+ = 128 bytes per iteration.
+                 * Hand-encoded since we build for the plain 68000. */
+                __asm__ volatile (
+                    "move.l %0,%%a0\n\t"
+                    "move.l %1,%%a1\n\t"
+                    "1:\n\t"
+                    ".rept 8\n\t"
+                    ".short 0xf620,0x9000\n\t"
+                    ".endr\n\t"
+                    "subq.l #1,%2\n\t"
+                    "bne.s 1b"
+                    : "+a" (s), "+a" (d), "+d" (count)
+                    :
+                    : "a0", "a1", "cc", "memory"
+                );
+                break;
+
+            case COPY_KERNEL_COPYMEMQUICK:
+                CopyMemQuick(s, d, loop_count * 128);
+                break;
+
+            default:
+                return 0;
+        }
+        total_copied += loop_count * 128;
+    }
+
+    end_time = get_timer_ticks();
+
+    elapsed = end_time - start_time;
+
+    /* CopyMemQuick has its own loop, only compensate ours */
+    if (kernel != COPY_KERNEL_COPYMEMQUICK) {
+        overhead = measure_loop_overhead(iterations * loop_count);
+        if (elapsed > overhead) {
+            elapsed -= overhead;
+        }
+    }
+    if (elapsed == 0) elapsed = 1;
+
+    return (ULONG)(((uint64_t)total_copied * 1000000ULL) / elapsed);
+}
+
+/*
+ * Get copy kernel name
+ */
+const char *get_copy_kernel_string(CopyKernel kernel)
+{
+    switch (kernel) {
+        case COPY_KERNEL_MOVEM:         return "movem";
+        case COPY_KERNEL_MOVE16:        return "move16";
+        case COPY_KERNEL_COPYMEMQUICK:  return "CopyMemQuick";
+        default:                        return "---";
+    }
+}
+
 /*
  * Helper to test RAM speed by allocating a buffer
  */
@@ -419,9 +883,143 @@ void run_memory_speed_tests(void)
     /* Test FAST RAM speed (if available) */
     bench_results.fast_speed = test_ram_speed(MEMF_FAST, buffer_size, iterations);
 
-    /* Test ROM read speed (Kickstart ROM at $F80000) */
-    bench_results.rom_speed = measure_mem_read_speed(
-        (volatile ULONG *)0xF80000, buffer_size, iterations);
+    /* Sweep the Kickstart and extended ROM areas bank by bank */
+    run_rom_bank_sweep();
+}
+
+/*
+ * Check for resident modules in the extended ROM area
+ * Only then is it safe to assume there is something to read at $E00000.
+ */
+static BOOL extended_rom_present(void)
+{
+    ULONG *res = (ULONG *)SysBase->ResModules;
+
+    if (!res) return FALSE;
+
+    while (*res) {
+        if (*res & 0x80000000) {
+            /* Link to the next ResModules array */
+            res = (ULONG *)(*res & 0x7FFFFFFF);
+            continue;
+        }
+        if (*res >= EXTENDED_ROM_BASE &&
+            *res < EXTENDED_ROM_BASE + EXTENDED_ROM_SIZE) {
+            return TRUE;
+        }
+        res++;
+    }
+
+    return FALSE;
+}
+
+/*
+ * Classify a ROM bank by MMU mapping and read speed
+ * Without MMU remapping, a bank that reads at least 3/4 of FAST RAM speed
+ * and twice the CHIP RAM speed can't be served by ROM chips.
+ */
+static RomBankType classify_rom_bank(const RomBank *bank, const MMURangeInfo *mmu)
+{
+    if (mmu && mmu->remapped) {
+        return ROM_BANK_REMAPPED;
+    }
+
+    if (bench_results.fast_speed > 0 &&
+        (uint64_t)bank->speed * 4 >= (uint64_t)bench_results.fast_speed * 3 &&
+        bank->speed > bench_results.chip_speed * 2) {
+        return ROM_BANK_SHADOWED;
+    }
+
+    return ROM_BANK_ROM;
+}
+
+/*
+ * Measure and classify all 64K banks of a ROM area
+ */
+static void sweep_rom_area(ULONG base, ULONG size)
+{
+    ULONG addr;
+
+    for (addr = base; addr < base + size; addr += ROM_BANK_SIZE) {
+        RomBank *bank;
+        MMURangeInfo info;
+        BOOL have_mmu = FALSE;
+
+        if (bench_results.rom_bank_count >= MAX_ROM_BANKS) break;
+
+        /* Never touch pages the MMU marks invalid */
+        if (mmu_available()) {
+            if (!mmu_query_range(addr, addr + ROM_BANK_SIZE, &info)) continue;
+            have_mmu = TRUE;
+        }
+
+        bank = &bench_results.rom_banks[bench_results.rom_bank_count];
+        bank->address = addr;
+        bank->speed = measure_mem_read_speed((volatile ULONG *)addr,
+                                             ROM_BANK_SIZE, 4);
+        bank->type = classify_rom_bank(bank, have_mmu ? &info : NULL);
+
+        debug("  bench: ROM bank $%08lx %lu bytes/s (%s)\n",
+              (unsigned long)addr, (unsigned long)bank->speed,
+              get_rom_bank_type_string(bank->type));
+
+        bench_results.rom_bank_count++;
+    }
+}
+
+/*
+ * Sweep the Kickstart ROM and (if present) the extended ROM area
+ * rom_speed keeps reporting the first Kickstart bank.
+ */
+void run_rom_bank_sweep(void)
+{
+    ULONG i;
+
+    bench_results.rom_bank_count = 0;
+    bench_results.rom_speed = 0;
+
+    if (extended_rom_present()) {
+        sweep_rom_area(EXTENDED_ROM_BASE, EXTENDED_ROM_SIZE);
+    }
+    sweep_rom_area(KICKSTART_ROM_BASE, KICKSTART_ROM_SIZE);
+
+    for (i = 0; i < bench_results.rom_bank_count; i++) {
+        if (bench_results.rom_banks[i].address == KICKSTART_ROM_BASE) {
+            bench_results.rom_speed = bench_results.rom_banks[i].speed;
+            break;
+        }
+    }
+}
+
+/*
+ * Get ROM bank classification for an address
+ */
+RomBankType get_rom_bank_type(ULONG address)
+{
+    ULONG i;
+
+    for (i = 0; i < bench_results.rom_bank_count; i++) {
+        RomBank *bank = &bench_results.rom_banks[i];
+        if (address >= bank->address &&
+            address < bank->address + ROM_BANK_SIZE) {
+            return bank->type;
+        }
+    }
+
+    return ROM_BANK_UNKNOWN;
+}
+
+/*
+ * Get ROM bank classification as string
+ */
+const char *get_rom_bank_type_string(RomBankType type)
+{
+    switch (type) {
+        case ROM_BANK_ROM:          return "ROM";
+        case ROM_BANK_SHADOWED:     return "SHADOWED (MAPROM)";
+        case ROM_BANK_REMAPPED:     return "REMAPPED (MMU)";
+        default:                    return "---";
+    }
 }
 
 /*
@@ -445,6 +1043,9 @@ void run_benchmarks(void)
     /* Run memory speed tests (CHIP, FAST, ROM) */
     run_memory_speed_tests();
 
+    /* ROM modules may turn out to run from shadowed memory */
+    update_software_locations();
+
     bench_results.benchmarks_valid = TRUE;
 }
 
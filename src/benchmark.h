@@ -31,6 +31,49 @@ typedef struct {
 #define REF_A3000   4
 #define REF_A4000   5
 
+/* ROM bank sweep: 64K banks of the Kickstart and extended ROM areas */
+#define ROM_BANK_SIZE           (64 * 1024)
+#define MAX_ROM_BANKS           16
+#define KICKSTART_ROM_BASE      0x00F80000
+#define KICKSTART_ROM_SIZE      (512 * 1024)
+#define EXTENDED_ROM_BASE       0x00E00000
+#define EXTENDED_ROM_SIZE       (512 * 1024)
+
+/* E clock when exec does not know it (V33/V34, PAL) */
+#define DEFAULT_ECLOCK          709379
+
+/* ROM bank classification */
+typedef enum {
+    ROM_BANK_UNKNOWN,       /* Not swept */
+    ROM_BANK_ROM,           /* Real ROM chips */
+    ROM_BANK_SHADOWED,      /* Shadowed to 32-bit RAM (MapROM) */
+    ROM_BANK_REMAPPED       /* Remapped to RAM by the MMU */
+} RomBankType;
+
+/* ROM bank sweep result */
+typedef struct {
+    ULONG address;          /* Bank start address */
+    ULONG speed;            /* Read speed in bytes/sec */
+    RomBankType type;
+} RomBank;
+
+/* Single-access timings of one address, in ns (0 = not measured) */
+typedef struct {
+    ULONG byte_ns;
+    ULONG word_ns;
+    ULONG long_ns;
+    ULONG word_misaligned_ns;   /* 68020+ only */
+    ULONG long_misaligned_ns;   /* 68020+ only */
+} BusTiming;
+
+/* Copy kernels for the cross-region bandwidth matrix */
+typedef enum {
+    COPY_KERNEL_NONE,
+    COPY_KERNEL_MOVEM,          /* movem.l 8 registers, any CPU */
+    COPY_KERNEL_MOVE16,         /* move16 burst copy, 68040/68060 */
+    COPY_KERNEL_COPYMEMQUICK    /* exec CopyMemQuick() (may be patched) */
+} CopyKernel;
+
 /* Benchmark results */
 typedef struct {
     ULONG dhrystones;       /* Dhrystones per second */
@@ -39,6 +82,8 @@ typedef struct {
     ULONG chip_speed;       /* Chip RAM speed in bytes/sec */
     ULONG fast_speed;       /* Fast RAM speed in bytes/sec (0 if no fast RAM) */
     ULONG rom_speed;        /* ROM read speed in bytes/sec */
+    RomBank rom_banks[MAX_ROM_BANKS];   /* Per-bank ROM sweep */
+    ULONG rom_bank_count;
     BOOL benchmarks_valid;  /* TRUE if benchmarks have been run */
 } BenchmarkResults;
 
@@ -61,6 +106,15 @@ ULONG run_dhrystone(void);
 ULONG run_mflops_benchmark(void);
 void run_memory_speed_tests(void);
 ULONG measure_mem_read_speed(volatile ULONG *src, ULONG buffer_size, ULONG iterations);
+void run_rom_bank_sweep(void);
+void measure_bus_timing(volatile UBYTE *addr, BusTiming *timing);
+ULONG measure_copy_speed(APTR dst, APTR src, ULONG buffer_size,
+                         ULONG iterations, CopyKernel kernel);
+const char *get_copy_kernel_string(CopyKernel kernel);
+
+/* ROM bank classification of an address (ROM_BANK_UNKNOWN if not swept) */
+RomBankType get_rom_bank_type(ULONG address);
+const char *get_rom_bank_type_string(RomBankType type);
 
 /* Helper functions */
 ULONG calculate_mips(ULONG dhrystones);
@@ -73,4 +127,23 @@ uint64_t get_timer_ticks(void);    /* Returns ticks (1/1000000 sec precision) */
 void wait_ticks(ULONG ticks);
 ULONG measure_loop_overhead(ULONG count);
 
+/* Periodic timer for live views (signal bit for the main loop Wait) */
+BOOL start_live_timer(ULONG vblanks);
+void stop_live_timer(void);
+ULONG get_live_timer_signal(void);
+BOOL check_live_timer(void);
+
+/* CIA-B timers (continuous mode, counting E clock ticks) */
+ULONG get_eclock_frequency(void);
+WORD claim_ciab_timer(struct Interrupt *is);
+void release_ciab_timer(WORD timer, struct Interrupt *is);
+void start_ciab_timer(WORD timer, ULONG period);
+void stop_ciab_timer(WORD timer);
+UWORD read_ciab_timer(WORD timer);
+
+/* Forbid() sections with duration tracking (worst case in debug output) */
+void timed_forbid(void);
+void timed_permit(const char *what);
+void report_worst_forbid(void);
+
 #endif /* BENCHMARK_H */
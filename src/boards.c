@@ -8,6 +8,7 @@
 #include <string.h>
 #include <stdio.h>
 
+#include <exec/memory.h>
 #include <libraries/configvars.h>
 #include <libraries/identify.h>
 
@@ -19,8 +20,12 @@
 
 #include "xsysinfo.h"
 #include "boards.h"
+#include "memory.h"
+#include "benchmark.h"
+#include "bandwidth.h"
 #include "gui.h"
 #include "locale_str.h"
+#include "arena.h"
 #include "debug.h"
 
 /* Global board list */
@@ -69,7 +74,7 @@ void enumerate_boards(void)
 
     debug("  boards: Starting enumeration...\n");
 
-    memset(&board_list, 0, sizeof(board_list));
+    board_list.count = 0;
 
     debug("  boards: Opening expansion.library...\n");
     ExpansionBase = OpenLibrary((CONST_STRPTR)"expansion.library", MIN_EXPANSION_VERSION);
@@ -80,9 +85,10 @@ void enumerate_boards(void)
 
     debug("  boards: Scanning for ConfigDevs...\n");
     while ((cd = FindConfigDev(cd, -1, -1)) != NULL) {
-        if (board_list.count >= MAX_BOARDS) break;
+        if (!ARENA_RESERVE(board_list.boards, board_list.count, board_list.capacity)) break;
 
         BoardInfo *board = &board_list.boards[board_list.count];
+        memset(board, 0, sizeof(*board));
 
         board->board_address = (ULONG)cd->cd_BoardAddr;
         board->board_size = cd->cd_BoardSize;
@@ -92,6 +98,9 @@ void enumerate_boards(void)
 
         debug("  boards: Found board at $%08lX\n", (LONG)board->board_address);
 
+        /* Memory that autoconfig adds to the system free list */
+        board->memory_board = (cd->cd_Rom.er_Type & ERTF_MEMLIST) != 0;
+
         /* Determine Zorro type */
         if ((cd->cd_Rom.er_Type & ERT_TYPEMASK) == ERT_ZORROIII) {
             board->board_type = BOARD_ZORRO_III;
@@ -128,6 +137,101 @@ void enumerate_boards(void)
     debug("  boards: Enumeration complete, found %ld boards\n", (LONG)board_list.count);
 }
 
+/*
+ * Measure write throughput into the RAM of a board
+ * The fastest copy kernel from a buffer in the best available memory into
+ * a buffer claimed on the board. move16 is not used: many Zorro boards do
+ * not terminate burst cycles.
+ */
+static ULONG measure_board_write(const BoardInfo *board)
+{
+    APTR local_mem, local, dst;
+    CopyKernel kernel;
+    ULONG speed, best = 0;
+
+    if (board->memory_index < 0) return 0;
+
+    dst = alloc_in_region(&memory_regions.regions[board->memory_index],
+                          COPY_BUFFER_SIZE);
+    if (!dst) return 0;
+
+    /* The copy kernels need 16-byte aligned buffers */
+    local_mem = AllocMem(COPY_BUFFER_SIZE + 15, MEMF_PUBLIC);
+    if (local_mem) {
+        local = (APTR)(((ULONG)local_mem + 15) & ~15);
+
+        for (kernel = COPY_KERNEL_MOVEM; kernel <= COPY_KERNEL_COPYMEMQUICK; kernel++) {
+            if (kernel == COPY_KERNEL_MOVE16) continue;
+
+            speed = measure_copy_speed(dst, local, COPY_BUFFER_SIZE,
+                                       COPY_ITERATIONS, kernel);
+            if (speed > best) best = speed;
+        }
+
+        FreeMem(local_mem, COPY_BUFFER_SIZE + 15);
+    }
+
+    FreeMem(dst, COPY_BUFFER_SIZE);
+
+    return best;
+}
+
+/*
+ * Measure read and write throughput of all memory boards
+ * Reads use the memory benchmark kernel directly on the board, which
+ * leaves its contents untouched.
+ */
+void measure_board_speeds(void)
+{
+    ULONG i;
+
+    for (i = 0; i < board_list.count; i++) {
+        BoardInfo *board = &board_list.boards[i];
+        ULONG size = board->board_size;
+
+        if (!board->memory_board) continue;
+
+        if (size > BOARD_READ_SIZE) size = BOARD_READ_SIZE;
+
+        board->read_speed = measure_mem_read_speed((volatile ULONG *)board->board_address,
+                                                   size, BOARD_READ_ITERATIONS);
+        board->write_speed = measure_board_write(board);
+        board->speed_measured = TRUE;
+
+        debug("  boards: $%08lX read %lu, write %lu bytes/s\n",
+              (unsigned long)board->board_address,
+              (unsigned long)board->read_speed,
+              (unsigned long)board->write_speed);
+    }
+}
+
+/*
+ * TRUE if any board adds RAM to the system
+ */
+static BOOL board_has_memory(void)
+{
+    ULONG i;
+
+    for (i = 0; i < board_list.count; i++) {
+        if (board_list.boards[i].memory_board) return TRUE;
+    }
+    return FALSE;
+}
+
+/*
+ * Format Zorro throughput of a memory board ("Read 3.45  Write 2.10 MB/s")
+ */
+static void format_board_speed(const BoardInfo *board, char *buffer, ULONG size)
+{
+    char read[16];
+    char write[16];
+
+    format_copy_speed(board->read_speed, read, sizeof(read));
+    format_copy_speed(board->write_speed, write, sizeof(write));
+    snprintf(buffer, size, "%s %s  %s %s MB/s",
+             get_string(MSG_BOARD_READ), read, get_string(MSG_BOARD_WRITE), write);
+}
+
 /*
  * Draw text field at position
  */
@@ -205,6 +309,33 @@ void draw_boards_view(void)
         draw_board_field(rp, 550, y, buffer);
 
         y += 10;
+
+        /* Memory region on this board, with the Zorro throughput once
+         * measured, the region read speed before that */
+        if ((board->memory_index >= 0 || board->speed_measured) &&
+            y < app->screen_height - 50) {
+            char label[32];
+            char speed[48];
+
+            if (board->memory_index >= 0) {
+                format_region_label((ULONG)board->memory_index, label, sizeof(label));
+            } else {
+                strncpy(label, "---", sizeof(label));
+            }
+
+            if (board->speed_measured) {
+                format_board_speed(board, speed, sizeof(speed));
+            } else {
+                format_region_speed(&memory_regions.regions[board->memory_index],
+                                    speed, sizeof(speed));
+            }
+            snprintf(buffer, sizeof(buffer), "%s %s  %s",
+                     get_string(MSG_BOARD_MEMORY), label, speed);
+
+            SetAPen(rp, COLOR_TEXT);
+            draw_board_field(rp, 136, y, buffer);
+            y += 10;
+        }
     }
 
     if (board_list.count == 0) {
@@ -214,9 +345,11 @@ void draw_boards_view(void)
         Text(rp, (CONST_STRPTR)get_string(MSG_BOARDS_NO_BOARDS_FOUND), strlen(get_string(MSG_BOARDS_NO_BOARDS_FOUND)));
     }
 
-    /* Draw exit button */
+    /* Draw buttons */
     Button *btn = find_button(BTN_BOARD_EXIT);
     if (btn) draw_button(btn);
+    btn = find_button(BTN_BOARD_SPEED);
+    if (btn) draw_button(btn);
 }
 
 /*
@@ -226,6 +359,8 @@ void boards_view_update_buttons(void)
 {
     add_button(20, 188, 60, 12,
                get_string(MSG_BTN_EXIT), BTN_BOARD_EXIT, TRUE);
+    add_button(100, 188, 60, 12,
+               get_string(MSG_BTN_SPEED), BTN_BOARD_SPEED, board_has_memory());
 }
 
 /*
@@ -233,7 +368,18 @@ void boards_view_update_buttons(void)
  */
 void boards_view_handle_button(ButtonID id)
 {
-    if (id == BTN_BOARD_EXIT) {
-        switch_to_view(VIEW_MAIN);
+    switch (id) {
+        case BTN_BOARD_SPEED:
+            show_status_overlay(get_string(MSG_MEASURING_SPEED));
+            measure_board_speeds();
+            hide_status_overlay();
+            break;
+
+        case BTN_BOARD_EXIT:
+            switch_to_view(VIEW_MAIN);
+            break;
+
+        default:
+            break;
     }
 }
@@ -10,9 +10,6 @@
 
 #include "xsysinfo.h"
 
-/* Maximum boards we'll track */
-#define MAX_BOARDS  32
-
 /* Board type */
 typedef enum {
     BOARD_ZORRO_II,
@@ -31,20 +28,33 @@ typedef struct {
     char product_name[64];
     char manufacturer_name[64];
     char size_string[16];       /* Human-readable size */
+    BYTE memory_index;          /* Memory region on this board, -1 if none */
+    BOOL memory_board;          /* ERTF_MEMLIST: RAM for the system free list */
+    ULONG read_speed;           /* Zorro read throughput in bytes/sec, 0 = n/a */
+    ULONG write_speed;          /* Zorro write throughput in bytes/sec, 0 = n/a */
+    BOOL speed_measured;        /* TRUE once the memory boards were measured */
 } BoardInfo;
 
-/* Board list */
+/* Board list, grown in the arena */
 typedef struct {
-    BoardInfo boards[MAX_BOARDS];
+    BoardInfo *boards;
     ULONG count;
+    ULONG capacity;
 } BoardList;
 
 /* Global board list */
 extern BoardList board_list;
 
+/* Bytes read per pass and passes of the Zorro read test */
+#define BOARD_READ_SIZE         (64 * 1024)
+#define BOARD_READ_ITERATIONS   8
+
 /* Function prototypes */
 void enumerate_boards(void);
 
+/* Measure read and write throughput of all memory boards */
+void measure_board_speeds(void);
+
 /* Helper functions */
 const char *get_board_type_string(BoardType type);
 void format_board_size(ULONG size, char *buffer, ULONG bufsize);
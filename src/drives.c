@@ -25,6 +25,7 @@
 #include "gui.h"
 #include "benchmark.h"
 #include "locale_str.h"
+#include "arena.h"
 #include "debug.h"
 #include <limits.h>
 
@@ -153,8 +154,10 @@ static void scan_dos_list(void)
 
     while ((dol = NextDosEntry(dol, LDF_DEVICES)) != NULL) {
         if (drive_list.count >= MAX_DRIVES) break;
+        if (!ARENA_RESERVE(drive_list.drives, drive_list.count, drive_list.capacity)) break;
 
         DriveInfo *drive = &drive_list.drives[drive_list.count];
+        memset(drive, 0, sizeof(*drive));
         drive->is_valid = FALSE;
 
         /* Get device name */
@@ -375,7 +378,7 @@ void enumerate_drives(void)
 {
     debug("  drives: Starting enumeration...\n");
 
-    memset(&drive_list, 0, sizeof(drive_list));
+    drive_list.count = 0;
 
     /* First pass: Scan DosList for devices */
     scan_dos_list();
@@ -10,7 +10,10 @@
 
 #include "xsysinfo.h"
 
-/* Maximum drives we'll track */
+/* Maximum drives we'll track
+ * Stays a fixed cap while the other lists grow in the arena: each drive
+ * gets a button ID from BTN_DRV_DRIVE_BASE up, and BTN_COUNT sizes the
+ * button table. Drives past the cap are not listed. */
 #define MAX_DRIVES  32
 
 /* Disk state */
@@ -60,10 +63,11 @@ typedef struct {
     BOOL is_valid;              /* Entry contains valid data */
 } DriveInfo;
 
-/* Drive list */
+/* Drive list, grown in the arena */
 typedef struct {
-    DriveInfo drives[MAX_DRIVES];
+    DriveInfo *drives;
     ULONG count;
+    ULONG capacity;
 } DriveList;
 
 /* Global drive list */
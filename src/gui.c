@@ -27,6 +27,20 @@
 #include "drives.h"
 #include "boards.h"
 #include "scsi.h"
+#include "bandwidth.h"
+#include "mempri.h"
+#include "allocbench.h"
+#include "memtrace.h"
+#include "memtest.h"
+#include "tasks.h"
+#include "sampler.h"
+#include "profile.h"
+#include "interrupts.h"
+#include "latency.h"
+#include "ipcbench.h"
+#include "patches.h"
+#include "residents.h"
+#include "loadtime.h"
 #include "print.h"
 #include "cache.h"
 #include "locale_str.h"
@@ -61,6 +75,8 @@ static void draw_bottom_buttons(void);
 static void draw_cache_buttons(void);
 static void clear_buttons(void);
 static void update_software_list(void);
+static const char *get_software_type_string(SoftwareType type);
+static ULONG software_list_count(void);
 static void refresh_all_cache_buttons(void);
 
 void format_scaled(char *buffer, size_t size, ULONG value_x100, BOOL round)
@@ -206,11 +222,7 @@ void main_view_update_buttons(void)
     /* Software type cycle button */
     add_button(SOFTWARE_PANEL_X + SOFTWARE_PANEL_W - 98,
                SOFTWARE_PANEL_Y + 2, 92, 12,
-               app->software_type == SOFTWARE_LIBRARIES ?
-                   get_string(MSG_LIBRARIES) :
-               app->software_type == SOFTWARE_DEVICES ?
-                   get_string(MSG_DEVICES) :
-                   get_string(MSG_RESOURCES),
+               get_software_type_string(app->software_type),
                BTN_SOFTWARE_CYCLE, TRUE);
 
     /* Software scroll buttons (arrows on right side) */
@@ -325,8 +337,11 @@ void main_view_handle_button(ButtonID id)
             break;
 
         case BTN_SOFTWARE_CYCLE:
-            app->software_type = (app->software_type + 1) % 3;
+            app->software_type = (app->software_type + 1) % SOFTWARE_TYPE_COUNT;
             app->software_scroll = 0;
+            if (app->software_type == SOFTWARE_TASKS) {
+                enumerate_tasks();
+            }
             update_software_list();
             break;
 
@@ -369,15 +384,9 @@ void main_view_handle_button(ButtonID id)
             break;
 
         case BTN_SOFTWARE_DOWN:
-            {
-                SoftwareList *list = app->software_type == SOFTWARE_LIBRARIES ?
-                                         &libraries_list :
-                                     app->software_type == SOFTWARE_DEVICES ?
-                                         &devices_list : &resources_list;
-                if (app->software_scroll < (LONG)list->count - SOFTWARE_LIST_LINES) {
-                    app->software_scroll++;
-                    update_software_list();
-                }
+            if (app->software_scroll < (LONG)software_list_count() - SOFTWARE_LIST_LINES) {
+                app->software_scroll++;
+                update_software_list();
             }
             break;
 
@@ -417,6 +426,46 @@ void update_button_states(void)
         case VIEW_SCSI:
             scsi_view_update_buttons();
             break;
+
+        case VIEW_COPY:
+            copy_view_update_buttons();
+            break;
+
+        case VIEW_PRIORITY:
+            priority_view_update_buttons();
+            break;
+
+        case VIEW_ALLOC:
+            alloc_view_update_buttons();
+            break;
+
+        case VIEW_TRACE:
+            trace_view_update_buttons();
+            break;
+        case VIEW_MEMTEST:
+            memtest_view_update_buttons();
+            break;
+        case VIEW_CPU:
+            cpu_view_update_buttons();
+            break;
+        case VIEW_INTERRUPTS:
+            interrupts_view_update_buttons();
+            break;
+        case VIEW_LATENCY:
+            latency_view_update_buttons();
+            break;
+        case VIEW_IPC:
+            ipc_view_update_buttons();
+            break;
+        case VIEW_PATCHES:
+            patches_view_update_buttons();
+            break;
+        case VIEW_RESIDENTS:
+            residents_view_update_buttons();
+            break;
+        case VIEW_LOADTIME:
+            loadtime_view_update_buttons();
+            break;
     }
 }
 
@@ -449,6 +498,42 @@ void redraw_current_view(void)
         case VIEW_SCSI:
             draw_scsi_view();
             break;
+        case VIEW_COPY:
+            draw_copy_view();
+            break;
+        case VIEW_PRIORITY:
+            draw_priority_view();
+            break;
+        case VIEW_ALLOC:
+            draw_alloc_view();
+            break;
+        case VIEW_TRACE:
+            draw_trace_view();
+            break;
+        case VIEW_MEMTEST:
+            draw_memtest_view();
+            break;
+        case VIEW_CPU:
+            draw_cpu_view();
+            break;
+        case VIEW_INTERRUPTS:
+            draw_interrupts_view();
+            break;
+        case VIEW_LATENCY:
+            draw_latency_view();
+            break;
+        case VIEW_IPC:
+            draw_ipc_view();
+            break;
+        case VIEW_PATCHES:
+            draw_patches_view();
+            break;
+        case VIEW_RESIDENTS:
+            draw_residents_view();
+            break;
+        case VIEW_LOADTIME:
+            draw_loadtime_view();
+            break;
     }
 }
 
@@ -781,6 +866,99 @@ void draw_label_value(WORD x, WORD y, const char *label, const char *value, WORD
 /* Forward declaration */
 static void update_software_list(void);
 
+/*
+ * Next software list order, the third column shows the sort key
+ */
+void cycle_software_sort(void)
+{
+    app->software_sort = (app->software_sort + 1) % SOFTWARE_SORT_COUNT;
+    sort_all_software(app->software_sort);
+    app->software_scroll = 0;
+    update_software_list();
+}
+
+/*
+ * Get the cycle button label of a software type
+ */
+static const char *get_software_type_string(SoftwareType type)
+{
+    switch (type) {
+        case SOFTWARE_LIBRARIES:
+            return get_string(MSG_LIBRARIES);
+        case SOFTWARE_DEVICES:
+            return get_string(MSG_DEVICES);
+        case SOFTWARE_RESOURCES:
+            return get_string(MSG_RESOURCES);
+        case SOFTWARE_TASKS:
+            return get_string(MSG_TASKS);
+        default:
+            return "---";
+    }
+}
+
+/*
+ * Number of entries of the current software type
+ */
+static ULONG software_list_count(void)
+{
+    SoftwareList *list;
+
+    if (app->software_type == SOFTWARE_TASKS) return task_list.count;
+
+    list = get_software_list(app->software_type);
+    return list ? list->count : 0;
+}
+
+/*
+ * Draw task rows: state, priority, stack size and high-water mark
+ * Stacks at least STACK_WARN_PERCENT full are highlighted.
+ */
+static void draw_task_rows(WORD y)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[32];
+    ULONG i;
+
+    for (i = app->software_scroll;
+         i < task_list.count && i < (ULONG)(app->software_scroll + SOFTWARE_LIST_LINES);
+         i++) {
+
+        TaskEntry *entry = &task_list.entries[i];
+
+        /* Name (truncated if needed) */
+        snprintf(buffer, 16, "%-15s", entry->name);
+        SetAPen(rp, COLOR_TEXT);
+        Move(rp, SOFTWARE_PANEL_X + 4, y);
+        Text(rp, (CONST_STRPTR)buffer, strlen(buffer));
+
+        /* State and priority */
+        snprintf(buffer, 6, "%-5s", get_task_state_string(entry->state));
+        Move(rp, SOFTWARE_PANEL_X + 126, y);
+        Text(rp, (CONST_STRPTR)buffer, strlen(buffer));
+
+        snprintf(buffer, sizeof(buffer), "%4d", entry->priority);
+        SetAPen(rp, COLOR_HIGHLIGHT);
+        Move(rp, SOFTWARE_PANEL_X + 166, y);
+        Text(rp, (CONST_STRPTR)buffer, strlen(buffer));
+
+        /* Stack size and bytes used */
+        snprintf(buffer, sizeof(buffer), "%6lu", (unsigned long)entry->stack_size);
+        Move(rp, SOFTWARE_PANEL_X + 202, y);
+        Text(rp, (CONST_STRPTR)buffer, strlen(buffer));
+
+        snprintf(buffer, sizeof(buffer), "%6lu", (unsigned long)entry->stack_used);
+        Move(rp, SOFTWARE_PANEL_X + 254, y);
+        Text(rp, (CONST_STRPTR)buffer, strlen(buffer));
+
+        snprintf(buffer, sizeof(buffer), "%3lu%%", (unsigned long)get_stack_percent(entry));
+        if (get_stack_percent(entry) >= STACK_WARN_PERCENT) SetAPen(rp, COLOR_BAR_YOU);
+        Move(rp, SOFTWARE_PANEL_X + 308, y);
+        Text(rp, (CONST_STRPTR)buffer, strlen(buffer));
+
+        y += 8;
+    }
+}
+
 /*
  * Draw software panel (libraries/devices/resources)
  */
@@ -816,20 +994,9 @@ static void update_software_list(void)
     WORD list_height = SOFTWARE_LIST_LINES * 8;
     char buffer[128];
 
-    /* Get current list */
-    switch (app->software_type) {
-        case SOFTWARE_LIBRARIES:
-            list = &libraries_list;
-            break;
-        case SOFTWARE_DEVICES:
-            list = &devices_list;
-            break;
-        case SOFTWARE_RESOURCES:
-            list = &resources_list;
-            break;
-        default:
-            return;
-    }
+    /* Get current list (tasks have no SoftwareList) */
+    list = get_software_list(app->software_type);
+    if (!list && app->software_type != SOFTWARE_TASKS) return;
 
     /* Clear list area (stop before scroll bar at -14) */
     SetAPen(rp, COLOR_PANEL_BG);
@@ -840,11 +1007,7 @@ static void update_software_list(void)
     /* Update cycle button only if label changed */
     Button *cycle_btn = find_button(BTN_SOFTWARE_CYCLE);
     if (cycle_btn) {
-        const char *new_label = app->software_type == SOFTWARE_LIBRARIES ?
-                                    get_string(MSG_LIBRARIES) :
-                                app->software_type == SOFTWARE_DEVICES ?
-                                    get_string(MSG_DEVICES) :
-                                    get_string(MSG_RESOURCES);
+        const char *new_label = get_software_type_string(app->software_type);
         if (cycle_btn->label != new_label) {
             cycle_btn->label = new_label;
             draw_cycle_button(cycle_btn);
@@ -869,12 +1032,18 @@ static void update_software_list(void)
     if (scrollbar_btn) {
         draw_scroll_bar(scrollbar_btn->x, scrollbar_btn->y,
                         scrollbar_btn->width, scrollbar_btn->height,
-                        app->software_scroll, list->count, SOFTWARE_LIST_LINES);
+                        app->software_scroll, software_list_count(), SOFTWARE_LIST_LINES);
     }
 
     /* Draw list entries */
     SetBPen(rp, COLOR_PANEL_BG);
     y = list_top;
+
+    if (!list) {
+        draw_task_rows(list_top);
+        return;
+    }
+
     for (i = app->software_scroll;
          i < list->count && i < (ULONG)(app->software_scroll + SOFTWARE_LIST_LINES);
          i++) {
@@ -892,8 +1061,18 @@ static void update_software_list(void)
         Move(rp, SOFTWARE_PANEL_X + 126, y);
         Text(rp, (CONST_STRPTR)buffer, strlen(buffer));
 
-        /* Address */
-        snprintf(buffer, 12, "$%08lX", (unsigned long)entry->address);
+        /* Sort key: footprint, open count, or the address (by name the
+         * share of CPU time once a code profile ran) */
+        if (app->software_sort == SOFTWARE_SORT_SIZE) {
+            snprintf(buffer, 12, "%9lu", (unsigned long)entry->footprint);
+        } else if (app->software_sort == SOFTWARE_SORT_OPENS) {
+            snprintf(buffer, 12, "%8ux", (unsigned)entry->open_count);
+        } else if (code_profile.valid && app->software_sort == SOFTWARE_SORT_NAME) {
+            snprintf(buffer, 12, "%5u.%u%%",
+                     (unsigned)(entry->cpu_permille / 10), (unsigned)(entry->cpu_permille % 10));
+        } else {
+            snprintf(buffer, 12, "$%08lX", (unsigned long)entry->address);
+        }
         SetAPen(rp, COLOR_HIGHLIGHT);
         Move(rp, SOFTWARE_PANEL_X + 200, y);
         Text(rp, (CONST_STRPTR)buffer, strlen(buffer));
@@ -1230,8 +1409,13 @@ static void draw_hardware_panel(void)
                      get_string(MSG_MMU), buffer, 80);
     y += 8;
 
-    /* VBR */
-    snprintf(buffer, sizeof(buffer), "$%08lX", (unsigned long)hw_info.vbr);
+    /* VBR, with the memory type once the CPU has one */
+    if (hw_info.cpu_type != CPU_68000) {
+        snprintf(buffer, sizeof(buffer), "$%08lX %s", (unsigned long)hw_info.vbr,
+                 get_location_string(determine_mem_location((APTR)hw_info.vbr)));
+    } else {
+        snprintf(buffer, sizeof(buffer), "$%08lX", (unsigned long)hw_info.vbr);
+    }
     draw_label_value(HARDWARE_PANEL_X + 4, y,
                      get_string(MSG_VBR), buffer, 80);
     y += 8;
@@ -1428,6 +1612,46 @@ void handle_button_press(ButtonID btn_id)
         case VIEW_SCSI:
             scsi_view_handle_button(btn_id);
             break;
+
+        case VIEW_COPY:
+            copy_view_handle_button(btn_id);
+            break;
+
+        case VIEW_PRIORITY:
+            priority_view_handle_button(btn_id);
+            break;
+
+        case VIEW_ALLOC:
+            alloc_view_handle_button(btn_id);
+            break;
+
+        case VIEW_TRACE:
+            trace_view_handle_button(btn_id);
+            break;
+        case VIEW_MEMTEST:
+            memtest_view_handle_button(btn_id);
+            break;
+        case VIEW_CPU:
+            cpu_view_handle_button(btn_id);
+            break;
+        case VIEW_INTERRUPTS:
+            interrupts_view_handle_button(btn_id);
+            break;
+        case VIEW_LATENCY:
+            latency_view_handle_button(btn_id);
+            break;
+        case VIEW_IPC:
+            ipc_view_handle_button(btn_id);
+            break;
+        case VIEW_PATCHES:
+            patches_view_handle_button(btn_id);
+            break;
+        case VIEW_RESIDENTS:
+            residents_view_handle_button(btn_id);
+            break;
+        case VIEW_LOADTIME:
+            loadtime_view_handle_button(btn_id);
+            break;
     }
 }
 
@@ -1437,35 +1661,20 @@ void handle_button_press(ButtonID btn_id)
 void handle_scrollbar_click(WORD mx __attribute__((unused)), WORD my)
 {
     Button *scrollbar_btn = find_button(BTN_SOFTWARE_SCROLLBAR);
-    SoftwareList *list;
+    ULONG count = software_list_count();
     WORD knob_h;
     WORD track_h;
     LONG max_scroll;
 
     if (!scrollbar_btn) return;
 
-    /* Get current list */
-    switch (app->software_type) {
-        case SOFTWARE_LIBRARIES:
-            list = &libraries_list;
-            break;
-        case SOFTWARE_DEVICES:
-            list = &devices_list;
-            break;
-        case SOFTWARE_RESOURCES:
-            list = &resources_list;
-            break;
-        default:
-            return;
-    }
-
-    max_scroll = (LONG)list->count - SOFTWARE_LIST_LINES;
+    max_scroll = (LONG)count - SOFTWARE_LIST_LINES;
     if (max_scroll <= 0) return;
 
     track_h = scrollbar_btn->height;
 
     /* Calculate knob size */
-    knob_h = (SOFTWARE_LIST_LINES * (track_h - 2)) / list->count;
+    knob_h = (SOFTWARE_LIST_LINES * (track_h - 2)) / count;
     if (knob_h < 8) knob_h = 8;
 
     /* When dragging, directly calculate scroll position from mouse Y */
@@ -1491,6 +1700,21 @@ void switch_to_view(ViewMode view)
 {
     app->current_view = view;
 
+    /* Live refresh only runs while the memory view is shown */
+    if (view != VIEW_MEMORY) {
+        set_memory_live(FALSE);
+    }
+
+    /* Leaving the trace view ends the trace window */
+    if (view != VIEW_TRACE) {
+        stop_alloc_trace();
+    }
+
+    /* Sampling runs while the CPU usage view is shown */
+    if (view != VIEW_CPU) {
+        stop_cpu_sampler();
+    }
+
     /* Reset view-specific state */
     switch (view) {
         case VIEW_MEMORY:
@@ -1604,14 +1828,11 @@ static void draw_requester_field(WORD field_x, WORD field_y, WORD field_w, WORD
 }
 
 /*
- * Draw overlay requester dialog (full redraw)
+ * Draw requester panel with title bar and OK/CANCEL buttons
  */
-static void draw_requester_overlay(WORD x, WORD y, WORD w, WORD h,
-                                   const char *title, const char *filename,
-                                   ULONG cursor_pos)
+static void draw_requester_frame(WORD x, WORD y, WORD w, WORD h, const char *title)
 {
     struct RastPort *rp = app->rp;
-    WORD field_x, field_y, field_w, field_h;
     WORD btn_y, btn_w, btn_h;
 
     /* Draw outer panel with shadow effect */
@@ -1633,20 +1854,6 @@ static void draw_requester_overlay(WORD x, WORD y, WORD w, WORD h,
     Move(rp, x + (w - strlen(title) * 8) / 2, y + 11);
     Text(rp, (CONST_STRPTR)title, strlen(title));
 
-    /* Draw filename input field border */
-    field_x = x + 16;
-    field_y = y + 24;
-    field_w = w - 32;
-    field_h = 14;
-
-    /* Recessed field background */
-    SetAPen(rp, COLOR_BACKGROUND);
-    RectFill(rp, field_x, field_y, field_x + field_w - 1, field_y + field_h - 1);
-    draw_3d_box(field_x, field_y, field_w, field_h, TRUE);
-
-    /* Draw field contents */
-    draw_requester_field(field_x, field_y, field_w, field_h, filename, cursor_pos);
-
     /* Draw OK and CANCEL buttons */
     btn_y = y + h - 20;
     btn_w = 80;
@@ -1671,6 +1878,33 @@ static void draw_requester_overlay(WORD x, WORD y, WORD w, WORD h,
     Text(rp, (CONST_STRPTR)get_string(MSG_BTN_CANCEL), strlen(get_string(MSG_BTN_CANCEL)));
 }
 
+/*
+ * Draw overlay requester dialog (full redraw)
+ */
+static void draw_requester_overlay(WORD x, WORD y, WORD w, WORD h,
+                                   const char *title, const char *filename,
+                                   ULONG cursor_pos)
+{
+    struct RastPort *rp = app->rp;
+    WORD field_x, field_y, field_w, field_h;
+
+    draw_requester_frame(x, y, w, h, title);
+
+    /* Draw filename input field border */
+    field_x = x + 16;
+    field_y = y + 24;
+    field_w = w - 32;
+    field_h = 14;
+
+    /* Recessed field background */
+    SetAPen(rp, COLOR_BACKGROUND);
+    RectFill(rp, field_x, field_y, field_x + field_w - 1, field_y + field_h - 1);
+    draw_3d_box(field_x, field_y, field_w, field_h, TRUE);
+
+    /* Draw field contents */
+    draw_requester_field(field_x, field_y, field_w, field_h, filename, cursor_pos);
+}
+
 /*
  * Show filename requester overlay
  * Returns TRUE if OK was pressed, FALSE if cancelled
@@ -1846,3 +2080,99 @@ BOOL show_filename_requester(const char *title, char *filename, ULONG filename_s
 
     return result;
 }
+
+/*
+ * Show confirmation requester overlay
+ * Returns TRUE if OK was pressed, FALSE if cancelled
+ */
+BOOL show_confirm_requester(const char *title, const char *message)
+{
+    struct RastPort *rp = app->rp;
+    struct IntuiMessage *msg;
+    BOOL running = TRUE;
+    BOOL result = FALSE;
+    Button *pressed_btn = NULL;
+
+    /* Dialog dimensions and position (centered) */
+    WORD dialog_w = 320;
+    WORD dialog_h = 60;
+    WORD dialog_x = (SCREEN_WIDTH - dialog_w) / 2;
+    WORD dialog_y = (app->screen_height - dialog_h) / 2;
+
+    /* Button positions (must match draw_requester_frame) */
+    WORD btn_y = dialog_y + dialog_h - 20;
+    WORD btn_w = 80;
+    WORD btn_h = 14;
+    WORD ok_x = dialog_x + 24;
+    WORD cancel_x = dialog_x + dialog_w - 24 - btn_w;
+
+    /* Button structs for OK and CANCEL */
+    Button ok_btn = { ok_x, btn_y, btn_w, btn_h, get_string(MSG_BTN_OK), BTN_NONE, TRUE, FALSE };
+    Button cancel_btn = { cancel_x, btn_y, btn_w, btn_h, get_string(MSG_BTN_CANCEL), BTN_NONE, TRUE, FALSE };
+
+    /* Draw dialog with centered message */
+    draw_requester_frame(dialog_x, dialog_y, dialog_w, dialog_h, title);
+    SetAPen(rp, COLOR_TEXT);
+    SetBPen(rp, COLOR_PANEL_BG);
+    Move(rp, dialog_x + (dialog_w - (WORD)strlen(message) * 8) / 2, dialog_y + 32);
+    Text(rp, (CONST_STRPTR)message, strlen(message));
+
+    /* Event loop for dialog */
+    while (running) {
+        WaitPort(app->window->UserPort);
+
+        while ((msg = (struct IntuiMessage *)
+                GetMsg(app->window->UserPort)) != NULL) {
+
+            ULONG class = msg->Class;
+            UWORD code = msg->Code;
+            WORD mx = msg->MouseX;
+            WORD my = msg->MouseY;
+
+            ReplyMsg((struct Message *)msg);
+
+            switch (class) {
+                case IDCMP_MOUSEBUTTONS:
+                    if (code == SELECTDOWN) {
+                        if (mx >= ok_x && mx < ok_x + btn_w &&
+                            my >= btn_y && my < btn_y + btn_h) {
+                            pressed_btn = &ok_btn;
+                        } else if (mx >= cancel_x && mx < cancel_x + btn_w &&
+                                   my >= btn_y && my < btn_y + btn_h) {
+                            pressed_btn = &cancel_btn;
+                        }
+                        if (pressed_btn) {
+                            pressed_btn->pressed = TRUE;
+                            draw_button(pressed_btn);
+                        }
+                    } else if (code == SELECTUP && pressed_btn) {
+                        pressed_btn->pressed = FALSE;
+                        draw_button(pressed_btn);
+                        /* Only count the release over the same button */
+                        if (mx >= pressed_btn->x && mx < pressed_btn->x + btn_w &&
+                            my >= btn_y && my < btn_y + btn_h) {
+                            result = (pressed_btn == &ok_btn);
+                            running = FALSE;
+                        }
+                        pressed_btn = NULL;
+                    }
+                    break;
+
+                case IDCMP_VANILLAKEY:
+                    if (code == 0x0D) {  /* Return/Enter */
+                        result = TRUE;
+                        running = FALSE;
+                    } else if (code == 0x1B) {  /* Escape */
+                        result = FALSE;
+                        running = FALSE;
+                    }
+                    break;
+            }
+        }
+    }
+
+    /* Redraw the current view to restore the area */
+    redraw_current_view();
+
+    return result;
+}
@@ -41,18 +41,81 @@ typedef enum {
     BTN_MEM_NEXT,
     BTN_MEM_SPEED,
     BTN_MEM_EXIT,
+    BTN_MEM_COPY,       /* Copy bandwidth matrix */
+    BTN_MEM_PRIORITY,   /* Memory priority advisor */
+    BTN_MEM_LIVE,       /* Live refresh on/off */
+    BTN_MEM_ALLOC,      /* Allocator benchmark */
+    BTN_MEM_TRACE,      /* Allocation tracing */
+    BTN_MEM_TEST,       /* Memory integrity test */
 
     /* Drives view buttons */
     BTN_DRV_EXIT,
     BTN_DRV_SCSI,
     BTN_DRV_SPEED,
 
-    /* Boards view button */
+    /* Boards view buttons */
     BTN_BOARD_EXIT,
+    BTN_BOARD_SPEED,
 
     /* SCSI view button */
     BTN_SCSI_EXIT,
 
+    /* Copy bandwidth view buttons */
+    BTN_COPY_EXIT,
+    BTN_COPY_SPEED,
+
+    /* Priority advisor view buttons */
+    BTN_PRI_EXIT,
+    BTN_PRI_SPEED,
+    BTN_PRI_APPLY,
+    BTN_PRI_SCRIPT,
+
+    /* Allocator benchmark view buttons */
+    BTN_ALLOC_EXIT,
+    BTN_ALLOC_SPEED,
+
+    /* Allocation trace view buttons */
+    BTN_TRACE_EXIT,
+    BTN_TRACE_START,
+
+    /* Memory test view buttons */
+    BTN_MEMTEST_EXIT,
+    BTN_MEMTEST_START,
+
+    /* CPU usage view buttons */
+    BTN_CPU_EXIT,
+    BTN_CPU_START,
+    BTN_CPU_RATE,
+    BTN_CPU_MODE,
+
+    /* Interrupt servers view buttons */
+    BTN_INT_EXIT,
+    BTN_INT_TIME,
+    BTN_INT_NEXT,
+
+    /* Interrupt latency view buttons */
+    BTN_LAT_EXIT,
+    BTN_LAT_START,
+    BTN_LAT_VBR,
+
+    /* Exec IPC benchmark view buttons */
+    BTN_IPC_EXIT,
+    BTN_IPC_START,
+
+    /* Library patches view buttons */
+    BTN_PATCH_EXIT,
+    BTN_PATCH_TIME,
+    BTN_PATCH_NEXT,
+
+    /* Resident modules view buttons */
+    BTN_RES_EXIT,
+    BTN_RES_NEXT,
+
+    /* Library load-time view buttons */
+    BTN_LOAD_EXIT,
+    BTN_LOAD_START,
+    BTN_LOAD_NEXT,
+
     /* Drive selection buttons - MUST be last as they use sequential IDs */
     BTN_DRV_DRIVE_BASE,
 
@@ -146,6 +209,9 @@ ButtonID handle_click(WORD mx, WORD my);
 void handle_button_press(ButtonID btn);
 void handle_scrollbar_click(WORD mx, WORD my);
 
+/* Next software list order, the third column shows the sort key */
+void cycle_software_sort(void);
+
 /* Button state management */
 void init_buttons(void);
 void update_button_states(void);
@@ -160,6 +226,9 @@ void switch_to_view(ViewMode view);
 /* Overlay requester for filename input */
 BOOL show_filename_requester(const char *title, char *filename, ULONG filename_size);
 
+/* Overlay requester asking for confirmation (OK/CANCEL) */
+BOOL show_confirm_requester(const char *title, const char *message);
+
 /* Status overlay (no input, just display) */
 void show_status_overlay(const char *message);
 void hide_status_overlay(void);
@@ -180,4 +249,32 @@ void boards_view_handle_button(ButtonID id);
 void scsi_view_update_buttons(void);
 void scsi_view_handle_button(ButtonID id);
 
+void copy_view_update_buttons(void);
+void copy_view_handle_button(ButtonID id);
+
+void priority_view_update_buttons(void);
+void priority_view_handle_button(ButtonID id);
+
+void alloc_view_update_buttons(void);
+void alloc_view_handle_button(ButtonID id);
+
+void trace_view_update_buttons(void);
+void trace_view_handle_button(ButtonID id);
+void memtest_view_update_buttons(void);
+void memtest_view_handle_button(ButtonID id);
+void cpu_view_update_buttons(void);
+void cpu_view_handle_button(ButtonID id);
+void interrupts_view_update_buttons(void);
+void interrupts_view_handle_button(ButtonID id);
+void latency_view_update_buttons(void);
+void latency_view_handle_button(ButtonID id);
+void ipc_view_update_buttons(void);
+void ipc_view_handle_button(ButtonID id);
+void patches_view_update_buttons(void);
+void patches_view_handle_button(ButtonID id);
+void residents_view_update_buttons(void);
+void residents_view_handle_button(ButtonID id);
+void loadtime_view_update_buttons(void);
+void loadtime_view_handle_button(ButtonID id);
+
 #endif /* GUI_H */
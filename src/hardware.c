@@ -24,6 +24,7 @@
 #include "hardware.h"
 #include "locale_str.h"
 #include "debug.h"
+#include "mmu.h"
 
 /* Global hardware info */
 HardwareInfo hw_info;
@@ -259,10 +260,8 @@ void detect_mmu(void)
     /* Check if MMU is in use (mmu.library loaded) */
     hw_info.mmu_enabled = FALSE;
     if (hw_info.mmu_type != MMU_NONE) {
-        struct Library *mmulib = OpenLibrary((CONST_STRPTR)"mmu.library", 0);
-        if (mmulib) {
+        if (mmu_available()) {
             hw_info.mmu_enabled = TRUE;
-            CloseLibrary(mmulib);
         }
     }
 
@@ -0,0 +1,571 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Interrupt server inventory and view
+ *
+ * Lists the handler of each SysBase->IntVects[] entry and the servers of
+ * the PORTS, COPER, VERTB, EXTER and NMI chains. Timing replaces is_Code
+ * and is_Data of every server with a stub that reads the E clock around
+ * the original call, then puts both back.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/execbase.h>
+#include <exec/interrupts.h>
+#include <hardware/intbits.h>
+#include <devices/timer.h>
+
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/timer.h>
+#include <proto/graphics.h>
+
+#include "xsysinfo.h"
+#include "interrupts.h"
+#include "benchmark.h"
+#include "gui.h"
+#include "locale_str.h"
+#include "arena.h"
+#include "debug.h"
+
+/* Global interrupt list */
+IntList int_list;
+
+/* View layout */
+#define INT_COL_VECTOR      28
+#define INT_COL_NAME        96
+#define INT_COL_PRI         248
+#define INT_COL_CODE        288
+#define INT_COL_LOCATION    368
+#define INT_COL_CALLS       440
+#define INT_COL_AVG         508
+#define INT_COL_MAX         568
+#define INT_ROW_HEIGHT      8
+#define INT_PAGE_ROWS       15
+#define INT_STATUS_Y        180
+#define INT_NAME_CHARS      18
+
+/* Vectors whose iv_Data is a list of servers */
+#define INT_SERVER_MASK     ((1 << INTB_PORTS) | (1 << INTB_COPER) | (1 << INTB_VERTB) | \
+                             (1 << INTB_EXTER) | (1 << INTB_NMI))
+
+/* Wrapper state of one server, the stub relies on data and code coming first */
+typedef struct {
+    APTR data;              /* Original is_Data */
+    APTR code;              /* Original is_Code */
+    struct Interrupt *node;
+    ULONG start;            /* E clock at entry */
+    ULONG calls;
+    ULONG ticks;
+    ULONG max_ticks;
+} IntWrap;
+
+/* Server wrappers, in the arena until exit */
+static IntWrap *int_wraps = NULL;
+static ULONG int_wrap_count = 0;
+static ULONG int_wrap_capacity = 0;
+static ULONG int_page = 0;
+
+/* Handlers and servers found by the last walk, including those that did not fit */
+static ULONG interrupts_seen;
+
+/* External references */
+extern struct ExecBase *SysBase;
+extern struct Device *TimerBase;
+extern AppContext *app;
+
+static const char *const vector_names[INT_VECTOR_COUNT] = {
+    "TBE", "DSKBLK", "SOFTINT", "PORTS", "COPER", "VERTB", "BLIT", "AUD0",
+    "AUD1", "AUD2", "AUD3", "RBF", "DSKSYNC", "EXTER", "INTEN", "NMI"
+};
+
+static const UBYTE vector_levels[INT_VECTOR_COUNT] = {
+    1, 1, 1, 2, 3, 3, 3, 4, 4, 4, 4, 5, 5, 6, 6, 7
+};
+
+/*
+ * Short name of an interrupt vector (INTB_*)
+ */
+const char *get_int_vector_name(UBYTE vector)
+{
+    return vector < INT_VECTOR_COUNT ? vector_names[vector] : "---";
+}
+
+/*
+ * CPU interrupt level of a vector
+ */
+UBYTE get_int_level(UBYTE vector)
+{
+    return vector < INT_VECTOR_COUNT ? vector_levels[vector] : 0;
+}
+
+/*
+ * Timing hooks called by the stub in interrupt context
+ * ReadEClock() may be called from interrupts.
+ */
+void intwrap_enter(IntWrap *wrap);
+void intwrap_leave(IntWrap *wrap);
+
+void intwrap_enter(IntWrap *wrap)
+{
+    struct EClockVal ev;
+
+    ReadEClock(&ev);
+    wrap->start = ev.ev_lo;
+}
+
+void intwrap_leave(IntWrap *wrap)
+{
+    struct EClockVal ev;
+    ULONG ticks;
+
+    ReadEClock(&ev);
+    ticks = ev.ev_lo - wrap->start;
+
+    wrap->calls++;
+    wrap->ticks += ticks;
+    if (ticks > wrap->max_ticks) wrap->max_ticks = ticks;
+}
+
+/*
+ * Server stub: a1 = IntWrap, a0 = custom chips, a6 = SysBase
+ * The original server gets its own is_Data in a1 and is_Code in a5.
+ * Its condition codes are handed back, they decide whether the chain
+ * continues.
+ */
+void intwrap_stub(void);
+
+__asm__(
+    "    .text\n"
+    "    .even\n"
+    "    .globl _intwrap_stub\n"
+    "_intwrap_stub:\n"
+    "    movem.l a0/a1/a6,-(sp)\n"
+    "    move.l  a1,-(sp)\n"
+    "    jsr     _intwrap_enter\n"
+    "    addq.l  #4,sp\n"
+    "    movem.l (sp),a0/a1/a6\n"
+    "    move.l  4(a1),a5\n"            /* Original is_Code */
+    "    move.l  (a1),a1\n"             /* Original is_Data */
+    "    jsr     (a5)\n"
+    "    move.w  sr,-(sp)\n"
+    "    move.l  d0,-(sp)\n"
+    "    move.l  10(sp),-(sp)\n"        /* Saved IntWrap */
+    "    jsr     _intwrap_leave\n"
+    "    addq.l  #4,sp\n"
+    "    move.l  (sp)+,d0\n"
+    "    move.w  (sp)+,ccr\n"
+    "    lea     12(sp),sp\n"
+    "    rts\n"
+);
+
+/*
+ * Copy one handler or server into the list (under Disable)
+ */
+static void snapshot_interrupt(UBYTE vector, struct Interrupt *node, APTR code,
+                               APTR data, BOOL server)
+{
+    IntEntry *entry;
+
+    interrupts_seen++;
+    if (int_list.count >= int_list.capacity) return;
+
+    entry = &int_list.entries[int_list.count++];
+    memset(entry, 0, sizeof(*entry));
+    entry->vector = vector;
+    entry->node = (APTR)node;
+    entry->code = code;
+    entry->data = data;
+    entry->server = server;
+    if (node) {
+        entry->priority = node->is_Node.ln_Pri;
+        if (node->is_Node.ln_Name) {
+            strncpy(entry->name, node->is_Node.ln_Name, sizeof(entry->name) - 1);
+        }
+    }
+}
+
+/*
+ * Snapshot the handlers and server chains of all vectors
+ * The list is sized outside Disable() and the walk repeated if it was
+ * too small.
+ */
+void enumerate_interrupts(void)
+{
+    ULONG needed = int_list.capacity;
+    ULONG tries;
+    ULONG v, i;
+
+    for (tries = 0; tries < ARENA_SNAPSHOT_RETRIES; tries++) {
+        /* Out of memory: only what fits is copied */
+        (void)ARENA_RESERVE_N(int_list.entries, 0, int_list.capacity, needed);
+
+        int_list.count = 0;
+        interrupts_seen = 0;
+
+        Disable();
+
+        for (v = 0; v < INT_VECTOR_COUNT; v++) {
+            struct IntVector *iv = &SysBase->IntVects[v];
+
+            if (v == INTB_INTEN) continue;
+
+            if (INT_SERVER_MASK & (1 << v)) {
+                struct List *list = (struct List *)iv->iv_Data;
+                struct Node *node;
+
+                if (!list) continue;
+
+                for (node = list->lh_Head; node->ln_Succ != NULL; node = node->ln_Succ) {
+                    struct Interrupt *is = (struct Interrupt *)node;
+                    snapshot_interrupt((UBYTE)v, is, (APTR)is->is_Code, is->is_Data, TRUE);
+                }
+            } else if (iv->iv_Code) {
+                snapshot_interrupt((UBYTE)v, (struct Interrupt *)iv->iv_Node,
+                                   (APTR)iv->iv_Code, iv->iv_Data, FALSE);
+            }
+        }
+
+        Enable();
+
+        if (interrupts_seen <= int_list.capacity) break;
+        needed = interrupts_seen + ARENA_SNAPSHOT_SLACK;
+    }
+
+    for (i = 0; i < int_list.count; i++) {
+        IntEntry *entry = &int_list.entries[i];
+
+        entry->name[sizeof(entry->name) - 1] = '\0';
+        if (entry->name[0] == '\0') {
+            strncpy(entry->name, "(unnamed)", sizeof(entry->name) - 1);
+        }
+        entry->location = determine_mem_location(entry->code);
+    }
+
+    int_list.timed = FALSE;
+}
+
+/*
+ * Wrap every server of the chains (under Disable)
+ * Servers beyond the reserved wrappers stay unwrapped.
+ */
+static void wrap_servers(void)
+{
+    ULONG v;
+
+    int_wrap_count = 0;
+
+    for (v = 0; v < INT_VECTOR_COUNT; v++) {
+        struct List *list = (struct List *)SysBase->IntVects[v].iv_Data;
+        struct Node *node;
+
+        if (!(INT_SERVER_MASK & (1 << v)) || !list) continue;
+
+        for (node = list->lh_Head; node->ln_Succ != NULL; node = node->ln_Succ) {
+            struct Interrupt *is = (struct Interrupt *)node;
+            IntWrap *wrap;
+
+            if (int_wrap_count >= int_wrap_capacity) return;
+
+            wrap = &int_wraps[int_wrap_count++];
+            memset(wrap, 0, sizeof(*wrap));
+            wrap->data = is->is_Data;
+            wrap->code = (APTR)is->is_Code;
+            wrap->node = is;
+
+            is->is_Data = (APTR)wrap;
+            is->is_Code = (VOID (*)())intwrap_stub;
+        }
+    }
+}
+
+/*
+ * TRUE if a server node is still in one of the chains (under Disable)
+ */
+static BOOL server_in_chain(struct Interrupt *is)
+{
+    ULONG v;
+
+    for (v = 0; v < INT_VECTOR_COUNT; v++) {
+        struct List *list = (struct List *)SysBase->IntVects[v].iv_Data;
+        struct Node *node;
+
+        if (!(INT_SERVER_MASK & (1 << v)) || !list) continue;
+
+        for (node = list->lh_Head; node->ln_Succ != NULL; node = node->ln_Succ) {
+            if (node == (struct Node *)is) return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/*
+ * Put the original code and data back (under Disable)
+ * A server removed during the window may already be freed, so only
+ * nodes still in a chain are touched.
+ */
+static void unwrap_servers(void)
+{
+    ULONG i;
+
+    for (i = 0; i < int_wrap_count; i++) {
+        IntWrap *wrap = &int_wraps[i];
+        struct Interrupt *is = wrap->node;
+
+        if (server_in_chain(is) && is->is_Data == (APTR)wrap) {
+            is->is_Data = wrap->data;
+            is->is_Code = (VOID (*)())wrap->code;
+        }
+    }
+}
+
+/*
+ * E clock ticks spent in the stub around an empty server
+ */
+static ULONG measure_wrap_overhead(void)
+{
+    IntWrap wrap;
+    ULONG best = 0xFFFFFFFF;
+    ULONG i;
+
+    memset(&wrap, 0, sizeof(wrap));
+
+    Disable();
+    for (i = 0; i < 16; i++) {
+        wrap.max_ticks = 0;
+        intwrap_enter(&wrap);
+        intwrap_leave(&wrap);
+        if (wrap.max_ticks < best) best = wrap.max_ticks;
+    }
+    Enable();
+
+    return best;
+}
+
+/*
+ * E clock ticks to microseconds
+ */
+static ULONG eclock_to_us(ULONG ticks, ULONG eclock)
+{
+    return (ULONG)((uint64_t)ticks * 1000000 / eclock);
+}
+
+/*
+ * Wrap each server for INT_TIME_SECONDS and measure its calls
+ */
+BOOL time_interrupt_servers(void)
+{
+    struct EClockVal ev;
+    uint64_t start;
+    ULONG elapsed_ms, eclock, overhead, i, j;
+
+    /* ReadEClock() is V36 */
+    if (!TimerBase || TimerBase->dd_Library.lib_Version < 36) return FALSE;
+
+    eclock = ReadEClock(&ev);
+    overhead = measure_wrap_overhead();
+
+    /* Wrappers for every server, allocated before Disable(). Once handed
+     * out they never move, a server may still point at an old one. */
+    enumerate_interrupts();
+    if (int_wrap_count == 0) {
+        (void)ARENA_RESERVE_N(int_wraps, 0, int_wrap_capacity,
+                              int_list.count + ARENA_SNAPSHOT_SLACK);
+    }
+
+    Disable();
+    wrap_servers();
+    Enable();
+
+    start = get_timer_ticks();
+    Delay(INT_TIME_SECONDS * TICKS_PER_SECOND);
+
+    Disable();
+    unwrap_servers();
+    Enable();
+
+    elapsed_ms = (ULONG)((get_timer_ticks() - start) / 1000);
+    if (elapsed_ms == 0) elapsed_ms = 1;
+
+    enumerate_interrupts();
+
+    for (i = 0; i < int_list.count; i++) {
+        IntEntry *entry = &int_list.entries[i];
+
+        for (j = 0; j < int_wrap_count; j++) {
+            const IntWrap *wrap = &int_wraps[j];
+            ULONG avg;
+
+            if ((APTR)wrap->node != entry->node) continue;
+
+            entry->timed = TRUE;
+            entry->calls_per_sec = (ULONG)((uint64_t)wrap->calls * 1000 / elapsed_ms);
+            if (wrap->calls > 0) {
+                avg = wrap->ticks / wrap->calls;
+                entry->avg_us = eclock_to_us(avg > overhead ? avg - overhead : 0, eclock);
+                entry->max_us = eclock_to_us(wrap->max_ticks > overhead ?
+                                             wrap->max_ticks - overhead : 0, eclock);
+            }
+            break;
+        }
+    }
+
+    int_list.overhead_us = eclock_to_us(overhead, eclock);
+    int_list.timed = TRUE;
+
+    debug("  interrupts: %lu servers timed, overhead %lu us\n",
+          (unsigned long)int_wrap_count, (unsigned long)int_list.overhead_us);
+
+    return TRUE;
+}
+
+/*
+ * Draw one page of handlers and servers
+ */
+static void draw_interrupt_rows(void)
+{
+    char buffer[32];
+    ULONG i;
+    WORD y = 56;
+
+    for (i = int_page * INT_PAGE_ROWS;
+         i < int_list.count && i < (int_page + 1) * INT_PAGE_ROWS; i++) {
+        const IntEntry *entry = &int_list.entries[i];
+
+        snprintf(buffer, sizeof(buffer), "%u %s", get_int_level(entry->vector),
+                 get_int_vector_name(entry->vector));
+        draw_text(INT_COL_VECTOR, y, buffer, COLOR_TEXT);
+
+        snprintf(buffer, sizeof(buffer), "%.*s", INT_NAME_CHARS, entry->name);
+        draw_text(INT_COL_NAME, y, buffer, COLOR_TEXT);
+
+        if (entry->server) {
+            snprintf(buffer, sizeof(buffer), "%4d", entry->priority);
+        } else {
+            snprintf(buffer, sizeof(buffer), "   -");
+        }
+        draw_text(INT_COL_PRI, y, buffer, COLOR_HIGHLIGHT);
+
+        snprintf(buffer, sizeof(buffer), "$%08lX", (unsigned long)entry->code);
+        draw_text(INT_COL_CODE, y, buffer, COLOR_HIGHLIGHT);
+
+        draw_text(INT_COL_LOCATION, y, get_location_string(entry->location), COLOR_TEXT);
+
+        if (entry->timed) {
+            snprintf(buffer, sizeof(buffer), "%7lu", (unsigned long)entry->calls_per_sec);
+            draw_text(INT_COL_CALLS, y, buffer, COLOR_HIGHLIGHT);
+            snprintf(buffer, sizeof(buffer), "%6lu", (unsigned long)entry->avg_us);
+            draw_text(INT_COL_AVG, y, buffer, COLOR_HIGHLIGHT);
+            snprintf(buffer, sizeof(buffer), "%6lu", (unsigned long)entry->max_us);
+            draw_text(INT_COL_MAX, y, buffer, COLOR_HIGHLIGHT);
+        } else if (!entry->server) {
+            draw_text(INT_COL_CALLS, y, get_string(MSG_INT_HANDLER), COLOR_TEXT);
+        }
+
+        y += INT_ROW_HEIGHT;
+    }
+}
+
+/*
+ * Draw interrupt servers view
+ */
+void draw_interrupts_view(void)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[80];
+    Button *btn;
+
+    /* Draw title panel */
+    draw_panel(20, 0, 600, 24, NULL);
+
+    SetAPen(rp, COLOR_TEXT);
+    SetBPen(rp, COLOR_PANEL_BG);
+    Move(rp, 220, 14);
+    Text(rp, (CONST_STRPTR)get_string(MSG_INTERRUPTS),
+         strlen(get_string(MSG_INTERRUPTS)));
+
+    /* Draw column headers */
+    SetAPen(rp, COLOR_TEXT);
+    TightText(rp, INT_COL_VECTOR, 40, (CONST_STRPTR)get_string(MSG_INT_VECTOR), -1, 4);
+    TightText(rp, INT_COL_NAME, 40, (CONST_STRPTR)get_string(MSG_INT_SERVER), -1, 4);
+    TightText(rp, INT_COL_PRI, 40, (CONST_STRPTR)get_string(MSG_INT_PRI), -1, 4);
+    TightText(rp, INT_COL_CODE, 40, (CONST_STRPTR)get_string(MSG_CPU_CODE), -1, 4);
+    TightText(rp, INT_COL_CALLS, 40, (CONST_STRPTR)get_string(MSG_INT_CALLS), -1, 4);
+    TightText(rp, INT_COL_AVG, 40, (CONST_STRPTR)get_string(MSG_INT_AVG), -1, 4);
+    TightText(rp, INT_COL_MAX, 40, (CONST_STRPTR)get_string(MSG_INT_MAX), -1, 4);
+
+    /* Draw separator line */
+    SetAPen(rp, COLOR_BUTTON_DARK);
+    Move(rp, 20, 44);
+    Draw(rp, 628, 44);
+
+    draw_interrupt_rows();
+
+    /* Status line */
+    if (int_list.timed) {
+        snprintf(buffer, sizeof(buffer), "%s %lu s, -%lu us/call",
+                 get_string(MSG_TRACE_WINDOW), (unsigned long)INT_TIME_SECONDS,
+                 (unsigned long)int_list.overhead_us);
+        draw_text(INT_COL_VECTOR, INT_STATUS_Y, buffer, COLOR_TEXT);
+    } else {
+        draw_text(INT_COL_VECTOR, INT_STATUS_Y, get_string(MSG_INT_HINT), COLOR_TEXT);
+    }
+
+    /* Draw buttons */
+    btn = find_button(BTN_INT_EXIT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_INT_TIME);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_INT_NEXT);
+    if (btn) draw_button(btn);
+}
+
+/*
+ * Update buttons for interrupt servers view
+ */
+void interrupts_view_update_buttons(void)
+{
+    add_button(20, 188, 60, 12,
+               get_string(MSG_BTN_EXIT), BTN_INT_EXIT, TRUE);
+    add_button(100, 188, 60, 12,
+               get_string(MSG_BTN_TIME), BTN_INT_TIME,
+               TimerBase && TimerBase->dd_Library.lib_Version >= 36);
+    add_button(180, 188, 60, 12,
+               get_string(MSG_BTN_NEXT), BTN_INT_NEXT, int_list.count > INT_PAGE_ROWS);
+}
+
+/*
+ * Handle button press for interrupt servers view
+ */
+void interrupts_view_handle_button(ButtonID id)
+{
+    switch (id) {
+        case BTN_INT_TIME:
+            /* Show what is going on, the window is not refreshed meanwhile */
+            SetAPen(app->rp, COLOR_BACKGROUND);
+            RectFill(app->rp, INT_COL_VECTOR, INT_STATUS_Y - 7, 612, INT_STATUS_Y + 2);
+            draw_text(INT_COL_VECTOR, INT_STATUS_Y, get_string(MSG_INT_MEASURING),
+                      COLOR_HIGHLIGHT);
+
+            time_interrupt_servers();
+            redraw_current_view();
+            break;
+
+        case BTN_INT_NEXT:
+            int_page++;
+            if (int_page * INT_PAGE_ROWS >= int_list.count) int_page = 0;
+            redraw_current_view();
+            break;
+
+        case BTN_INT_EXIT:
+            switch_to_view(VIEW_MAIN);
+            break;
+
+        default:
+            break;
+    }
+}
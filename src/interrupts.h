@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Interrupt server inventory header
+ */
+
+#ifndef INTERRUPTS_H
+#define INTERRUPTS_H
+
+#include "xsysinfo.h"
+
+/* Interrupt vectors in SysBase->IntVects[] */
+#define INT_VECTOR_COUNT        16
+
+/* Servers are wrapped for this long when timed */
+#define INT_TIME_SECONDS        2
+
+/* One interrupt handler or server */
+typedef struct {
+    char name[32];
+    APTR node;              /* struct Interrupt, to match timing results */
+    APTR code;
+    APTR data;
+    UBYTE vector;           /* INTB_* */
+    BYTE priority;
+    BOOL server;            /* In a server chain, else the vector's handler */
+    MemoryLocation location;
+    BOOL timed;
+    ULONG calls_per_sec;
+    ULONG avg_us;
+    ULONG max_us;
+} IntEntry;
+
+/* Interrupt handlers and servers, in vector order */
+typedef struct {
+    IntEntry *entries;      /* Grown in the arena */
+    ULONG count;
+    ULONG capacity;
+    ULONG overhead_us;      /* Timing overhead subtracted per call */
+    BOOL timed;             /* TRUE once servers were timed */
+} IntList;
+
+/* Global interrupt list */
+extern IntList int_list;
+
+/* Function prototypes */
+
+/* Snapshot the handlers and server chains of all vectors */
+void enumerate_interrupts(void);
+
+/* Wrap each server for INT_TIME_SECONDS and measure its calls */
+BOOL time_interrupt_servers(void);
+
+/* Short name of an interrupt vector (INTB_*) */
+const char *get_int_vector_name(UBYTE vector);
+
+/* CPU interrupt level of a vector */
+UBYTE get_int_level(UBYTE vector);
+
+/* Draw interrupt servers view */
+void draw_interrupts_view(void);
+
+#endif /* INTERRUPTS_H */
@@ -0,0 +1,367 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Exec IPC benchmark and view
+ *
+ * A helper task one priority above ours answers messages and signals.
+ * Waking it switches to it at once, and it switches back when it waits
+ * again, so each round trip costs two context switches.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/execbase.h>
+#include <exec/ports.h>
+#include <exec/semaphores.h>
+#include <exec/tasks.h>
+
+#include <clib/alib_protos.h>
+#include <proto/exec.h>
+#include <proto/graphics.h>
+
+#include "xsysinfo.h"
+#include "ipcbench.h"
+#include "benchmark.h"
+#include "gui.h"
+#include "locale_str.h"
+#include "debug.h"
+
+/* Global IPC benchmark results */
+IpcResults ipc_results;
+
+/* View layout */
+#define IPC_COL_TEST        28
+#define IPC_COL_OPS         260
+#define IPC_COL_US          360
+#define IPC_STATUS_Y        176
+
+/* Operations timed per test */
+static const ULONG ipc_iterations[IPC_TEST_COUNT] = {
+    5000, 5000, 20000, 5000, 20000
+};
+
+/* What the helper does when signalled */
+typedef enum {
+    IPC_CMD_PING,           /* Signal us back */
+    IPC_CMD_CONTEND,        /* Wait for our semaphore, release it */
+    IPC_CMD_QUIT
+} IpcCommand;
+
+/* Shared with the helper task */
+static struct Task *ipc_main_task = NULL;
+static ULONG ipc_main_mask = 0;
+static struct MsgPort *volatile ipc_helper_port = NULL;
+static volatile BYTE ipc_helper_sig = -1;
+static volatile IpcCommand ipc_command = IPC_CMD_PING;
+static struct SignalSemaphore ipc_semaphore;
+
+/* External references */
+extern AppContext *app;
+
+/*
+ * Name of a test
+ */
+const char *get_ipc_test_string(IpcTest test)
+{
+    switch (test) {
+        case IPC_TEST_MESSAGES:
+            return get_string(MSG_IPC_MESSAGES);
+        case IPC_TEST_SIGNALS:
+            return get_string(MSG_IPC_SIGNALS);
+        case IPC_TEST_SEMAPHORE:
+            return get_string(MSG_IPC_SEMAPHORE);
+        case IPC_TEST_CONTENDED:
+            return get_string(MSG_IPC_CONTENDED);
+        case IPC_TEST_FORBID:
+            return get_string(MSG_IPC_FORBID);
+        default:
+            return "---";
+    }
+}
+
+/*
+ * Helper task: replies to messages and acts on its signal
+ * It signals us once ready and once more under Forbid() before it
+ * ends; that Forbid() lasts until exec removed the task, so our code
+ * is not unloaded under it.
+ */
+static void ipc_helper(void)
+{
+    struct MsgPort *port = CreateMsgPort();
+    BYTE sig = AllocSignal(-1);
+    BOOL running = (port != NULL && sig >= 0);
+
+    if (running) {
+        ipc_helper_sig = sig;
+        ipc_helper_port = port;
+        Signal(ipc_main_task, ipc_main_mask);
+    }
+
+    while (running) {
+        ULONG got = Wait((1UL << sig) | (1UL << port->mp_SigBit));
+        struct Message *msg;
+
+        while ((msg = GetMsg(port)) != NULL) {
+            ReplyMsg(msg);
+        }
+
+        if (!(got & (1UL << sig))) continue;
+
+        switch (ipc_command) {
+            case IPC_CMD_PING:
+                Signal(ipc_main_task, ipc_main_mask);
+                break;
+
+            case IPC_CMD_CONTEND:
+                ObtainSemaphore(&ipc_semaphore);
+                ReleaseSemaphore(&ipc_semaphore);
+                break;
+
+            case IPC_CMD_QUIT:
+                running = FALSE;
+                break;
+        }
+    }
+
+    if (port) DeleteMsgPort(port);
+    if (sig >= 0) FreeSignal(sig);
+
+    Forbid();
+    Signal(ipc_main_task, ipc_main_mask);
+}
+
+/*
+ * Store the result of one test
+ */
+static void store_ipc_result(IpcTest test, ULONG elapsed_us)
+{
+    ULONG count = ipc_iterations[test];
+
+    if (elapsed_us == 0) elapsed_us = 1;
+
+    ipc_results.ops_per_sec[test] = (ULONG)((uint64_t)count * 1000000 / elapsed_us);
+    ipc_results.ns_per_op[test] = (ULONG)((uint64_t)elapsed_us * 1000 / count);
+}
+
+/*
+ * Start the helper task and time each operation
+ */
+BOOL run_ipc_benchmark(void)
+{
+    struct Task *self = FindTask(NULL);
+    struct MsgPort *reply_port;
+    struct MsgPort *helper_port;
+    struct Task *helper;
+    struct Message msg;
+    ULONG helper_mask;
+    uint64_t start;
+    ULONG i, n;
+    BYTE sig;
+
+    memset(&ipc_results, 0, sizeof(ipc_results));
+
+    sig = AllocSignal(-1);
+    if (sig < 0) return FALSE;
+
+    reply_port = CreateMsgPort();
+    if (!reply_port) {
+        FreeSignal(sig);
+        return FALSE;
+    }
+
+    ipc_main_task = self;
+    ipc_main_mask = 1UL << sig;
+    ipc_helper_port = NULL;
+    ipc_command = IPC_CMD_PING;
+    InitSemaphore(&ipc_semaphore);
+    SetSignal(0, ipc_main_mask);
+
+    helper = CreateTask((STRPTR)XSYSINFO_NAME " IPC", self->tc_Node.ln_Pri + 1,
+                        (APTR)ipc_helper, IPC_HELPER_STACK);
+    if (helper) Wait(ipc_main_mask);
+
+    helper_port = ipc_helper_port;
+    if (!helper || !helper_port) {
+        DeleteMsgPort(reply_port);
+        FreeSignal(sig);
+        return FALSE;
+    }
+    helper_mask = 1UL << ipc_helper_sig;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.mn_Node.ln_Type = NT_MESSAGE;
+    msg.mn_ReplyPort = reply_port;
+    msg.mn_Length = sizeof(msg);
+
+    /* Message round trips */
+    n = ipc_iterations[IPC_TEST_MESSAGES];
+    start = get_timer_ticks();
+    for (i = 0; i < n; i++) {
+        PutMsg(helper_port, &msg);
+        WaitPort(reply_port);
+        GetMsg(reply_port);
+    }
+    store_ipc_result(IPC_TEST_MESSAGES, (ULONG)(get_timer_ticks() - start));
+
+    /* Signal ping-pong */
+    n = ipc_iterations[IPC_TEST_SIGNALS];
+    start = get_timer_ticks();
+    for (i = 0; i < n; i++) {
+        Signal(helper, helper_mask);
+        Wait(ipc_main_mask);
+    }
+    store_ipc_result(IPC_TEST_SIGNALS, (ULONG)(get_timer_ticks() - start));
+
+    /* Semaphore nobody else wants */
+    n = ipc_iterations[IPC_TEST_SEMAPHORE];
+    start = get_timer_ticks();
+    for (i = 0; i < n; i++) {
+        ObtainSemaphore(&ipc_semaphore);
+        ReleaseSemaphore(&ipc_semaphore);
+    }
+    store_ipc_result(IPC_TEST_SEMAPHORE, (ULONG)(get_timer_ticks() - start));
+
+    /* The helper blocks on the semaphore we hold, our release hands it over */
+    ipc_command = IPC_CMD_CONTEND;
+    n = ipc_iterations[IPC_TEST_CONTENDED];
+    start = get_timer_ticks();
+    for (i = 0; i < n; i++) {
+        ObtainSemaphore(&ipc_semaphore);
+        Signal(helper, helper_mask);
+        ReleaseSemaphore(&ipc_semaphore);
+    }
+    store_ipc_result(IPC_TEST_CONTENDED, (ULONG)(get_timer_ticks() - start));
+
+    /* Forbid()/Permit() pairs */
+    n = ipc_iterations[IPC_TEST_FORBID];
+    start = get_timer_ticks();
+    for (i = 0; i < n; i++) {
+        Forbid();
+        Permit();
+    }
+    store_ipc_result(IPC_TEST_FORBID, (ULONG)(get_timer_ticks() - start));
+
+    /* Stop the helper and wait until it is gone */
+    ipc_command = IPC_CMD_QUIT;
+    Signal(helper, helper_mask);
+    Wait(ipc_main_mask);
+
+    DeleteMsgPort(reply_port);
+    FreeSignal(sig);
+
+    ipc_results.switch_ns = ipc_results.ns_per_op[IPC_TEST_SIGNALS] / 2;
+    ipc_results.valid = TRUE;
+
+    debug("  ipc: message %lu ns, signal %lu ns, switch %lu ns\n",
+          (unsigned long)ipc_results.ns_per_op[IPC_TEST_MESSAGES],
+          (unsigned long)ipc_results.ns_per_op[IPC_TEST_SIGNALS],
+          (unsigned long)ipc_results.switch_ns);
+
+    return TRUE;
+}
+
+/*
+ * Format ns as microseconds with one decimal
+ */
+static void format_ipc_ns(ULONG ns, char *buffer, ULONG size)
+{
+    snprintf(buffer, size, "%6lu.%lu", (unsigned long)(ns / 1000),
+             (unsigned long)(ns % 1000 / 100));
+}
+
+/*
+ * Draw IPC benchmark view
+ */
+void draw_ipc_view(void)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[32];
+    ULONG i;
+    WORD y;
+    Button *btn;
+
+    /* Draw title panel */
+    draw_panel(20, 0, 600, 24, NULL);
+
+    SetAPen(rp, COLOR_TEXT);
+    SetBPen(rp, COLOR_PANEL_BG);
+    Move(rp, 220, 14);
+    Text(rp, (CONST_STRPTR)get_string(MSG_IPC_BENCHMARK),
+         strlen(get_string(MSG_IPC_BENCHMARK)));
+
+    /* Draw column headers */
+    SetAPen(rp, COLOR_TEXT);
+    TightText(rp, IPC_COL_TEST, 40, (CONST_STRPTR)get_string(MSG_IPC_TEST), -1, 4);
+    TightText(rp, IPC_COL_OPS, 40, (CONST_STRPTR)get_string(MSG_IPC_OPS), -1, 4);
+    TightText(rp, IPC_COL_US, 40, (CONST_STRPTR)get_string(MSG_IPC_US), -1, 4);
+
+    /* Draw separator line */
+    SetAPen(rp, COLOR_BUTTON_DARK);
+    Move(rp, 20, 44);
+    Draw(rp, 628, 44);
+
+    if (!ipc_results.valid) {
+        draw_text(IPC_COL_TEST, IPC_STATUS_Y, get_string(MSG_IPC_HINT), COLOR_TEXT);
+    } else {
+        y = 56;
+        for (i = 0; i < IPC_TEST_COUNT; i++) {
+            draw_text(IPC_COL_TEST, y, get_ipc_test_string((IpcTest)i), COLOR_TEXT);
+
+            snprintf(buffer, sizeof(buffer), "%9lu", (unsigned long)ipc_results.ops_per_sec[i]);
+            draw_text(IPC_COL_OPS, y, buffer, COLOR_HIGHLIGHT);
+
+            format_ipc_ns(ipc_results.ns_per_op[i], buffer, sizeof(buffer));
+            draw_text(IPC_COL_US, y, buffer, COLOR_HIGHLIGHT);
+            y += 10;
+        }
+
+        format_ipc_ns(ipc_results.switch_ns, buffer, sizeof(buffer));
+        strncat(buffer, " us", sizeof(buffer) - strlen(buffer) - 1);
+        draw_label_value(IPC_COL_TEST, y + 10, get_string(MSG_IPC_SWITCH), buffer, 160);
+    }
+
+    /* Draw buttons */
+    btn = find_button(BTN_IPC_EXIT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_IPC_START);
+    if (btn) draw_button(btn);
+}
+
+/*
+ * Update buttons for IPC benchmark view
+ */
+void ipc_view_update_buttons(void)
+{
+    add_button(20, 188, 60, 12,
+               get_string(MSG_BTN_EXIT), BTN_IPC_EXIT, TRUE);
+    add_button(100, 188, 60, 12,
+               get_string(MSG_BTN_START), BTN_IPC_START, TRUE);
+}
+
+/*
+ * Handle button press for IPC benchmark view
+ */
+void ipc_view_handle_button(ButtonID id)
+{
+    switch (id) {
+        case BTN_IPC_START:
+            /* The window is not refreshed while measuring */
+            SetAPen(app->rp, COLOR_BACKGROUND);
+            RectFill(app->rp, IPC_COL_TEST, IPC_STATUS_Y - 7, 612, IPC_STATUS_Y + 2);
+            draw_text(IPC_COL_TEST, IPC_STATUS_Y, get_string(MSG_LAT_MEASURING),
+                      COLOR_HIGHLIGHT);
+
+            run_ipc_benchmark();
+            redraw_current_view();
+            break;
+
+        case BTN_IPC_EXIT:
+            switch_to_view(VIEW_MAIN);
+            break;
+
+        default:
+            break;
+    }
+}
@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Exec IPC benchmark header
+ */
+
+#ifndef IPCBENCH_H
+#define IPCBENCH_H
+
+#include "xsysinfo.h"
+
+/* Helper task, one priority above ours so every wakeup switches to it */
+#define IPC_HELPER_STACK        4096
+
+/* Exec operations under test */
+typedef enum {
+    IPC_TEST_MESSAGES,      /* PutMsg()/GetMsg()/ReplyMsg() round trip */
+    IPC_TEST_SIGNALS,       /* Signal()/Wait() ping-pong */
+    IPC_TEST_SEMAPHORE,     /* ObtainSemaphore()/ReleaseSemaphore(), no waiter */
+    IPC_TEST_CONTENDED,     /* Same with the helper waiting for it */
+    IPC_TEST_FORBID,        /* Forbid()/Permit() pair */
+    IPC_TEST_COUNT
+} IpcTest;
+
+/* IPC benchmark results */
+typedef struct {
+    ULONG ops_per_sec[IPC_TEST_COUNT];
+    ULONG ns_per_op[IPC_TEST_COUNT];
+    ULONG switch_ns;        /* Half a Signal()/Wait() round trip */
+    BOOL valid;             /* TRUE once measured */
+} IpcResults;
+
+/* Global IPC benchmark results */
+extern IpcResults ipc_results;
+
+/* Function prototypes */
+
+/* Start the helper task and time each operation */
+BOOL run_ipc_benchmark(void);
+
+/* Name of a test */
+const char *get_ipc_test_string(IpcTest test);
+
+/* Draw IPC benchmark view */
+void draw_ipc_view(void);
+
+#endif /* IPCBENCH_H */
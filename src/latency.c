@@ -0,0 +1,581 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Interrupt latency benchmark and view
+ *
+ * A CIA-B timer runs in continuous mode. It reloads and keeps counting
+ * when it underflows, so the handler can read how many E clock ticks
+ * passed since the interrupt was raised. The handler then signals our
+ * task, raised above input.device; the task reads the E clock to get the
+ * wakeup latency.
+ *
+ * Exception dispatch is timed with a TRAP loop through exec to our
+ * tc_TrapCode. On a 68010+ the vector table can be moved from CHIP RAM,
+ * where each vector fetch competes with display DMA, to FAST RAM.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/execbase.h>
+#include <exec/interrupts.h>
+#include <exec/memory.h>
+#include <exec/tasks.h>
+#include <devices/timer.h>
+#include <resources/cia.h>
+
+#include <proto/exec.h>
+#include <proto/timer.h>
+#include <proto/graphics.h>
+
+#include "xsysinfo.h"
+#include "latency.h"
+#include "hardware.h"
+#include "benchmark.h"
+#include "gui.h"
+#include "locale_str.h"
+#include "debug.h"
+
+/* Global latency results */
+LatencyResults latency_results;
+ExceptionResults exception_results;
+
+/* View layout */
+#define LATENCY_COL_LABEL   28
+#define LATENCY_COL_MIN     220
+#define LATENCY_COL_AVG     300
+#define LATENCY_COL_P99     380
+#define LATENCY_COL_MAX     460
+#define LATENCY_STATUS_Y    176
+
+/* Loop run from RAM, the TRAP number is only known at run time */
+#define OP_TRAP             0x4E40
+#define OP_NOP              0x4E71
+static const UWORD trap_loop_template[4] = {
+    OP_NOP,                 /* trap #n, or nop for the loop overhead */
+    0x5380,                 /* subq.l #1,d0 */
+    0x66FA,                 /* bne.s  loop */
+    0x4E75                  /* rts */
+};
+
+/* Written by the interrupt */
+static ULONG latency_entry_ticks[LATENCY_SAMPLES];
+static volatile ULONG latency_entry_count = 0;
+static volatile ULONG latency_underflow = 0;    /* E clock of the last underflow */
+static volatile BOOL latency_pending = FALSE;   /* Signalled, task not yet awake */
+static volatile ULONG latency_missed = 0;
+
+/* Read by the interrupt */
+static ULONG latency_wake_ticks[LATENCY_SAMPLES];
+static struct Task *latency_task = NULL;
+static ULONG latency_sigmask = 0;
+static ULONG latency_period = 0;
+static WORD latency_timer = -1;
+static BOOL latency_eclock = FALSE;
+
+/* External references */
+extern struct ExecBase *SysBase;
+extern struct Device *TimerBase;
+extern AppContext *app;
+
+/*
+ * Timer interrupt: ticks since the underflow, then wake the task
+ */
+static void latency_interrupt(void)
+{
+    ULONG elapsed = latency_period - read_ciab_timer(latency_timer);
+
+    if (latency_entry_count < LATENCY_SAMPLES) {
+        latency_entry_ticks[latency_entry_count++] = elapsed;
+    }
+
+    if (latency_pending) {
+        latency_missed++;
+        return;
+    }
+
+    if (latency_eclock) {
+        struct EClockVal ev;
+
+        ReadEClock(&ev);
+        latency_underflow = ev.ev_lo - elapsed;
+    }
+
+    latency_pending = TRUE;
+    Signal(latency_task, latency_sigmask);
+}
+
+static struct Interrupt latency_int = {
+    { NULL, NULL, NT_INTERRUPT, 0, (char *)XSYSINFO_NAME " latency" },
+    NULL,
+    (VOID (*)())latency_interrupt
+};
+
+/* Shared with the supervisor code below */
+ULONG vbr_new = 0;
+
+/*
+ * tc_TrapCode: exec pushed the trap number on top of the exception frame
+ * Supervisor() routine: load the VBR (movec d0,vbr), 68010+ only
+ */
+void vbr_trap_handler(void);
+void vbr_set_super(void);
+
+__asm__(
+    "    .text\n"
+    "    .even\n"
+    "    .globl _vbr_trap_handler\n"
+    "_vbr_trap_handler:\n"
+    "    addq.l  #4,sp\n"
+    "    rte\n"
+    "\n"
+    "    .globl _vbr_set_super\n"
+    "_vbr_set_super:\n"
+    "    move.l  _vbr_new,d0\n"
+    "    .short  0x4e7b,0x0801\n"
+    "    rte\n"
+);
+
+/*
+ * Shell sort, fast enough for a few thousand samples on a 68000
+ */
+static void sort_ticks(ULONG *ticks, ULONG count)
+{
+    ULONG gap, i, j;
+
+    for (gap = count / 2; gap > 0; gap /= 2) {
+        for (i = gap; i < count; i++) {
+            ULONG value = ticks[i];
+
+            for (j = i; j >= gap && ticks[j - gap] > value; j -= gap) {
+                ticks[j] = ticks[j - gap];
+            }
+            ticks[j] = value;
+        }
+    }
+}
+
+/*
+ * E clock ticks to ns
+ */
+static ULONG ticks_to_ns(ULONG ticks, ULONG eclock)
+{
+    return (ULONG)((uint64_t)ticks * 1000000000ULL / eclock);
+}
+
+/*
+ * Sort the samples and fill in the distribution
+ */
+static void compute_stats(LatencyStats *stats, ULONG *ticks, ULONG count, ULONG eclock)
+{
+    uint64_t sum = 0;
+    ULONG i;
+
+    memset(stats, 0, sizeof(*stats));
+    if (count == 0) return;
+
+    sort_ticks(ticks, count);
+    for (i = 0; i < count; i++) sum += ticks[i];
+
+    stats->count = count;
+    stats->min_ns = ticks_to_ns(ticks[0], eclock);
+    stats->avg_ns = ticks_to_ns((ULONG)(sum / count), eclock);
+    stats->p99_ns = ticks_to_ns(ticks[count * 99 / 100], eclock);
+    stats->max_ns = ticks_to_ns(ticks[count - 1], eclock);
+}
+
+/*
+ * Measure interrupt entry and task wakeup latency
+ */
+BOOL run_latency_benchmark(void)
+{
+    ULONG eclock = get_eclock_frequency();
+    ULONG wake_count = 0;
+    uint64_t start;
+    BYTE sig;
+    BYTE old_pri;
+
+    memset(&latency_results, 0, sizeof(latency_results));
+
+    sig = AllocSignal(-1);
+    if (sig < 0) return FALSE;
+
+    latency_task = FindTask(NULL);
+    latency_sigmask = 1UL << sig;
+    latency_period = eclock / LATENCY_RATE;
+    latency_entry_count = 0;
+    latency_pending = FALSE;
+    latency_missed = 0;
+
+    /* ReadEClock() is V36 */
+    latency_eclock = TimerBase && TimerBase->dd_Library.lib_Version >= 36;
+
+    latency_timer = claim_ciab_timer(&latency_int);
+    if (latency_timer < 0) {
+        debug("  latency: no free CIA-B timer\n");
+        FreeSignal(sig);
+        return FALSE;
+    }
+
+    old_pri = SetTaskPri(latency_task, LATENCY_TASK_PRI);
+    start = get_timer_ticks();
+
+    start_ciab_timer(latency_timer, latency_period);
+
+    while (latency_entry_count < LATENCY_SAMPLES ||
+           (latency_eclock && wake_count < LATENCY_SAMPLES)) {
+        ULONG got = Wait(latency_sigmask | SIGBREAKF_CTRL_C);
+
+        if (got & latency_sigmask) {
+            if (latency_eclock && wake_count < LATENCY_SAMPLES) {
+                struct EClockVal ev;
+
+                ReadEClock(&ev);
+                latency_wake_ticks[wake_count++] = ev.ev_lo - latency_underflow;
+            }
+            latency_pending = FALSE;
+        }
+
+        if ((got & SIGBREAKF_CTRL_C) ||
+            get_timer_ticks() - start > (uint64_t)LATENCY_TIMEOUT_SECONDS * 1000000) {
+            latency_results.aborted = TRUE;
+            break;
+        }
+    }
+
+    release_ciab_timer(latency_timer, &latency_int);
+    latency_timer = -1;
+
+    SetTaskPri(latency_task, old_pri);
+    SetSignal(0, latency_sigmask);
+    FreeSignal(sig);
+
+    compute_stats(&latency_results.entry, latency_entry_ticks, latency_entry_count, eclock);
+    compute_stats(&latency_results.wakeup, latency_wake_ticks, wake_count, eclock);
+
+    latency_results.missed = latency_missed;
+    latency_results.wakeup_valid = latency_eclock;
+    latency_results.vbr = hw_info.vbr;
+    latency_results.vbr_location = determine_mem_location((APTR)hw_info.vbr);
+    latency_results.valid = TRUE;
+
+    debug("  latency: entry avg %lu ns, wakeup avg %lu ns, %lu missed\n",
+          (unsigned long)latency_results.entry.avg_ns,
+          (unsigned long)latency_results.wakeup.avg_ns, (unsigned long)latency_missed);
+
+    return TRUE;
+}
+
+/*
+ * Run the loop in RAM, returns microseconds
+ */
+static ULONG time_trap_loop(const UWORD *code, ULONG count)
+{
+    uint64_t start = get_timer_ticks();
+    register ULONG d0 __asm__("d0") = count;
+    register const UWORD *a0 __asm__("a0") = code;
+
+    __asm__ volatile (
+        "jsr (%1)"
+        : "+d" (d0)
+        : "a" (a0)
+        : "d1", "a1", "cc", "memory"
+    );
+
+    return (ULONG)(get_timer_ticks() - start);
+}
+
+/*
+ * Best of TRAP_LOOP_RUNS, other tasks and interrupts only add time
+ */
+static ULONG best_trap_loop(const UWORD *code)
+{
+    ULONG best = 0xFFFFFFFF;
+    ULONG i;
+
+    for (i = 0; i < TRAP_LOOP_RUNS; i++) {
+        ULONG elapsed = time_trap_loop(code, TRAP_LOOP_COUNT);
+        if (elapsed < best) best = elapsed;
+    }
+
+    return best;
+}
+
+/*
+ * Time the exception dispatch with a TRAP loop
+ */
+BOOL measure_exception_cost(void)
+{
+    struct Task *task = FindTask(NULL);
+    APTR old_trap_code;
+    UWORD *code;
+    LONG trap;
+    ULONG with_trap, without;
+
+    if (!TimerBase) return FALSE;
+
+    code = (UWORD *)AllocMem(sizeof(trap_loop_template), MEMF_PUBLIC);
+    if (!code) return FALSE;
+
+    trap = AllocTrap(-1);
+    if (trap < 0) {
+        FreeMem(code, sizeof(trap_loop_template));
+        return FALSE;
+    }
+
+    CopyMem((APTR)trap_loop_template, code, sizeof(trap_loop_template));
+    CacheClearU();
+    without = best_trap_loop(code);
+
+    code[0] = OP_TRAP | (UWORD)trap;
+    CacheClearU();
+
+    old_trap_code = task->tc_TrapCode;
+    task->tc_TrapCode = (APTR)vbr_trap_handler;
+    with_trap = best_trap_loop(code);
+    task->tc_TrapCode = old_trap_code;
+
+    FreeTrap(trap);
+    FreeMem(code, sizeof(trap_loop_template));
+
+    exception_results.trap_ns = with_trap > without ?
+        (ULONG)((uint64_t)(with_trap - without) * 1000 / TRAP_LOOP_COUNT) : 0;
+    exception_results.vbr = hw_info.vbr;
+    exception_results.vbr_location = determine_mem_location((APTR)hw_info.vbr);
+    exception_results.valid = TRUE;
+
+    debug("  latency: TRAP %lu ns with VBR $%08lX\n",
+          (unsigned long)exception_results.trap_ns, (unsigned long)hw_info.vbr);
+
+    return TRUE;
+}
+
+/*
+ * TRUE on a 68010+ with the vector table in CHIP RAM
+ */
+BOOL can_relocate_vbr(void)
+{
+    return hw_info.cpu_type != CPU_68000 && hw_info.cpu_type != CPU_UNKNOWN &&
+           determine_mem_location((APTR)hw_info.vbr) == LOC_CHIP_RAM;
+}
+
+/*
+ * Copy the vector table to FAST RAM, move the VBR and measure again
+ * The table is never freed, the CPU uses it until the next reset.
+ */
+BOOL relocate_vbr(void)
+{
+    ULONG *table;
+    ULONG before_ns, before_vbr;
+
+    if (!can_relocate_vbr()) return FALSE;
+
+    if (!exception_results.valid) measure_exception_cost();
+    before_ns = exception_results.trap_ns;
+    before_vbr = hw_info.vbr;
+
+    table = (ULONG *)AllocMem(VBR_TABLE_SIZE, MEMF_FAST | MEMF_PUBLIC);
+    if (!table) return FALSE;
+
+    Disable();
+    CopyMemQuick((APTR)hw_info.vbr, table, VBR_TABLE_SIZE);
+    CacheClearU();
+    vbr_new = (ULONG)table;
+    Supervisor((ULONG (*)())vbr_set_super);
+    Enable();
+
+    hw_info.vbr = (ULONG)table;
+
+    debug("  latency: VBR moved from $%08lX to $%08lX\n",
+          (unsigned long)before_vbr, (unsigned long)hw_info.vbr);
+
+    measure_exception_cost();
+    exception_results.before_ns = before_ns;
+    exception_results.before_vbr = before_vbr;
+
+    run_latency_benchmark();
+
+    return TRUE;
+}
+
+/*
+ * Format ns as microseconds with one decimal
+ */
+static void format_ns(ULONG ns, char *buffer, ULONG size)
+{
+    snprintf(buffer, size, "%5lu.%lu", (unsigned long)(ns / 1000),
+             (unsigned long)(ns % 1000 / 100));
+}
+
+/*
+ * Draw one row of the latency table
+ */
+static void draw_latency_row(WORD y, const char *label, const LatencyStats *stats)
+{
+    char buffer[16];
+
+    draw_text(LATENCY_COL_LABEL, y, label, COLOR_TEXT);
+
+    format_ns(stats->min_ns, buffer, sizeof(buffer));
+    draw_text(LATENCY_COL_MIN, y, buffer, COLOR_HIGHLIGHT);
+    format_ns(stats->avg_ns, buffer, sizeof(buffer));
+    draw_text(LATENCY_COL_AVG, y, buffer, COLOR_HIGHLIGHT);
+    format_ns(stats->p99_ns, buffer, sizeof(buffer));
+    draw_text(LATENCY_COL_P99, y, buffer, COLOR_HIGHLIGHT);
+    format_ns(stats->max_ns, buffer, sizeof(buffer));
+    draw_text(LATENCY_COL_MAX, y, buffer, COLOR_HIGHLIGHT);
+}
+
+/*
+ * Draw the TRAP cost and the gain of moving the VBR
+ */
+static void draw_exception_cost(void)
+{
+    char buffer[80];
+    char value[16];
+
+    format_ns(exception_results.trap_ns, value, sizeof(value));
+    snprintf(buffer, sizeof(buffer), "%s %s", value, get_string(MSG_EXC_PER_TRAP));
+    draw_label_value(LATENCY_COL_LABEL, 116, get_string(MSG_EXC_DISPATCH), buffer, 160);
+
+    if (exception_results.before_ns > exception_results.trap_ns) {
+        ULONG gain = (exception_results.before_ns - exception_results.trap_ns) * 100 /
+                     exception_results.before_ns;
+
+        format_ns(exception_results.before_ns, value, sizeof(value));
+        snprintf(buffer, sizeof(buffer), "%s %s $%08lX, %lu%% %s",
+                 value, get_string(MSG_EXC_BEFORE),
+                 (unsigned long)exception_results.before_vbr, (unsigned long)gain,
+                 get_string(MSG_EXC_FASTER));
+        draw_text(LATENCY_COL_LABEL + 160, 126, buffer, COLOR_HIGHLIGHT);
+    } else if (exception_results.vbr_location == LOC_CHIP_RAM &&
+               hw_info.cpu_type != CPU_68000) {
+        draw_text(LATENCY_COL_LABEL + 160, 126, get_string(MSG_EXC_VBR_CHIP), COLOR_BAR_YOU);
+    }
+}
+
+/*
+ * Draw interrupt latency view
+ */
+void draw_latency_view(void)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[80];
+    Button *btn;
+
+    /* Draw title panel */
+    draw_panel(20, 0, 600, 24, NULL);
+
+    SetAPen(rp, COLOR_TEXT);
+    SetBPen(rp, COLOR_PANEL_BG);
+    Move(rp, 220, 14);
+    Text(rp, (CONST_STRPTR)get_string(MSG_LATENCY),
+         strlen(get_string(MSG_LATENCY)));
+
+    /* Draw column headers */
+    SetAPen(rp, COLOR_TEXT);
+    TightText(rp, LATENCY_COL_MIN, 40, (CONST_STRPTR)get_string(MSG_LAT_MIN), -1, 4);
+    TightText(rp, LATENCY_COL_AVG, 40, (CONST_STRPTR)get_string(MSG_INT_AVG), -1, 4);
+    TightText(rp, LATENCY_COL_P99, 40, (CONST_STRPTR)get_string(MSG_LAT_P99), -1, 4);
+    TightText(rp, LATENCY_COL_MAX, 40, (CONST_STRPTR)get_string(MSG_INT_MAX), -1, 4);
+
+    /* Draw separator line */
+    SetAPen(rp, COLOR_BUTTON_DARK);
+    Move(rp, 20, 44);
+    Draw(rp, 628, 44);
+
+    if (!latency_results.valid) {
+        draw_text(LATENCY_COL_LABEL, LATENCY_STATUS_Y, get_string(MSG_LAT_HINT), COLOR_TEXT);
+    } else {
+        draw_latency_row(56, get_string(MSG_LAT_ENTRY), &latency_results.entry);
+
+        if (latency_results.wakeup_valid) {
+            draw_latency_row(66, get_string(MSG_LAT_WAKEUP), &latency_results.wakeup);
+        } else {
+            draw_text(LATENCY_COL_LABEL, 66, get_string(MSG_LAT_WAKEUP), COLOR_TEXT);
+            draw_text(LATENCY_COL_MIN, 66, get_string(MSG_LAT_NEEDS_V36), COLOR_TEXT);
+        }
+
+        snprintf(buffer, sizeof(buffer), "%lu / %lu, %lu %s",
+                 (unsigned long)latency_results.entry.count,
+                 (unsigned long)latency_results.wakeup.count,
+                 (unsigned long)latency_results.missed, get_string(MSG_LAT_MISSED));
+        draw_label_value(LATENCY_COL_LABEL, 86, get_string(MSG_LAT_SAMPLES), buffer, 96);
+
+        /* A VBR in CHIP RAM makes every exception wait for the chipset */
+        snprintf(buffer, sizeof(buffer), "$%08lX  %s", (unsigned long)latency_results.vbr,
+                 get_location_string(latency_results.vbr_location));
+        draw_label_value(LATENCY_COL_LABEL, 96, get_string(MSG_VBR), buffer, 96);
+
+        if (exception_results.valid) {
+            draw_exception_cost();
+        }
+
+        if (latency_results.aborted) {
+            draw_text(LATENCY_COL_LABEL, LATENCY_STATUS_Y, get_string(MSG_MEMTEST_ABORTED),
+                      COLOR_BAR_YOU);
+        }
+    }
+
+    /* Draw buttons */
+    btn = find_button(BTN_LAT_EXIT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_LAT_START);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_LAT_VBR);
+    if (btn) draw_button(btn);
+}
+
+/*
+ * Update buttons for interrupt latency view
+ */
+void latency_view_update_buttons(void)
+{
+    add_button(20, 188, 60, 12,
+               get_string(MSG_BTN_EXIT), BTN_LAT_EXIT, TRUE);
+    add_button(100, 188, 60, 12,
+               get_string(MSG_BTN_START), BTN_LAT_START, TRUE);
+    add_button(180, 188, 76, 12,
+               get_string(MSG_BTN_MOVE_VBR), BTN_LAT_VBR, can_relocate_vbr());
+}
+
+/*
+ * Handle button press for interrupt latency view
+ */
+void latency_view_handle_button(ButtonID id)
+{
+    switch (id) {
+        case BTN_LAT_START:
+            /* The window is not refreshed while measuring */
+            SetAPen(app->rp, COLOR_BACKGROUND);
+            RectFill(app->rp, LATENCY_COL_LABEL, LATENCY_STATUS_Y - 7, 612,
+                     LATENCY_STATUS_Y + 2);
+            draw_text(LATENCY_COL_LABEL, LATENCY_STATUS_Y, get_string(MSG_LAT_MEASURING),
+                      COLOR_HIGHLIGHT);
+
+            run_latency_benchmark();
+            measure_exception_cost();
+            redraw_current_view();
+            break;
+
+        case BTN_LAT_VBR:
+            if (show_confirm_requester(get_string(MSG_LATENCY),
+                                       get_string(MSG_VBR_CONFIRM))) {
+                redraw_current_view();
+                draw_text(LATENCY_COL_LABEL, LATENCY_STATUS_Y,
+                          get_string(MSG_LAT_MEASURING), COLOR_HIGHLIGHT);
+
+                relocate_vbr();
+            }
+            redraw_current_view();
+            break;
+
+        case BTN_LAT_EXIT:
+            switch_to_view(VIEW_MAIN);
+            break;
+
+        default:
+            break;
+    }
+}
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Interrupt latency benchmark header
+ */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include "xsysinfo.h"
+
+/* Samples per measurement and timer interrupt rate */
+#define LATENCY_SAMPLES         2000
+#define LATENCY_RATE            500
+
+/* Priority of our task while it waits for the signal */
+#define LATENCY_TASK_PRI        21
+
+/* Give up if the samples do not arrive in time */
+#define LATENCY_TIMEOUT_SECONDS 15
+
+/* TRAP instructions per exception timing run, best of several runs */
+#define TRAP_LOOP_COUNT         20000
+#define TRAP_LOOP_RUNS          3
+
+/* Vector table moved to FAST RAM (256 vectors) */
+#define VBR_TABLE_SIZE          1024
+
+/* Distribution of one latency, in ns */
+typedef struct {
+    ULONG count;
+    ULONG min_ns;
+    ULONG avg_ns;
+    ULONG p99_ns;
+    ULONG max_ns;
+} LatencyStats;
+
+/* Result of the last measurement */
+typedef struct {
+    LatencyStats entry;     /* Timer underflow to the handler */
+    LatencyStats wakeup;    /* Timer underflow to the signalled task */
+    ULONG missed;           /* Interrupts while the task was not yet awake */
+    ULONG vbr;              /* VBR during the measurement */
+    MemoryLocation vbr_location;
+    BOOL wakeup_valid;      /* Wakeup needs ReadEClock() (V36) */
+    BOOL aborted;
+    BOOL valid;
+} LatencyResults;
+
+/* Exception dispatch cost with the current and the previous VBR */
+typedef struct {
+    ULONG trap_ns;          /* TRAP through exec to tc_TrapCode and back */
+    ULONG vbr;
+    MemoryLocation vbr_location;
+    ULONG before_ns;        /* Before the VBR was moved, 0 if it was not */
+    ULONG before_vbr;
+    BOOL valid;
+} ExceptionResults;
+
+/* Global latency results */
+extern LatencyResults latency_results;
+extern ExceptionResults exception_results;
+
+/* Function prototypes */
+
+/* Measure interrupt entry and task wakeup latency */
+BOOL run_latency_benchmark(void);
+
+/* Time the exception dispatch with a TRAP loop */
+BOOL measure_exception_cost(void);
+
+/* TRUE on a 68010+ with the vector table in CHIP RAM */
+BOOL can_relocate_vbr(void);
+
+/* Copy the vector table to FAST RAM, move the VBR and measure again */
+BOOL relocate_vbr(void);
+
+/* Draw interrupt latency view */
+void draw_latency_view(void);
+
+#endif /* LATENCY_H */
@@ -0,0 +1,491 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Library load-time profiler and view
+ *
+ * Opens every library in LIBS: that is not in memory yet, timing
+ * OpenLibrary() (ramlib's LoadSeg() plus the library's init) and the
+ * memory it takes, then closes and expunges it again. Opening a device
+ * needs a unit and may touch hardware, so devices are only loaded with
+ * LoadSeg() and unloaded. Only the first directory of a multi-assign is
+ * scanned.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/execbase.h>
+#include <exec/memory.h>
+#include <dos/dos.h>
+#include <dos/dosextens.h>
+
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/graphics.h>
+
+#include "xsysinfo.h"
+#include "loadtime.h"
+#include "benchmark.h"
+#include "gui.h"
+#include "locale_str.h"
+#include "arena.h"
+#include "debug.h"
+
+/* Global load-time results */
+LoadList load_list;
+
+/* View layout */
+#define LOAD_COL_NAME       28
+#define LOAD_COL_TIME       292
+#define LOAD_COL_SIZE       380
+#define LOAD_COL_STATUS     460
+#define LOAD_ROW_HEIGHT     8
+#define LOAD_PAGE_ROWS      15
+#define LOAD_STATUS_Y       180
+#define LOAD_NAME_CHARS     30
+
+/* Sanity limits for a seglist */
+#define MAX_LOAD_HUNKS      64
+#define MAX_LOAD_HUNK_SIZE  (16 * 1024 * 1024)
+
+/* Allocation that cannot succeed, as "Avail FLUSH" makes */
+#define LOAD_FLUSH_SIZE     0x7FFFFFF0
+
+/* Libraries that patch the system on init and never leave */
+static const char *const unsafe_libraries[] = {
+    "68020.library", "68030.library", "68040.library", "68060.library",
+    "680x0.library", "ppc.library", "powerpc.library", "warp.library",
+    NULL
+};
+
+/* LOADLIST argument, empty to scan LIBS: and DEVS: */
+static char load_names[LOAD_LIST_ARG_SIZE];
+
+static ULONG load_page = 0;
+
+/* External references */
+extern struct ExecBase *SysBase;
+extern AppContext *app;
+
+/*
+ * Short name of an outcome
+ */
+const char *get_load_status_string(LoadStatus status)
+{
+    switch (status) {
+        case LOAD_EXPUNGED:
+            return get_string(MSG_LOAD_EXPUNGED);
+        case LOAD_KEPT:
+            return get_string(MSG_LOAD_KEPT);
+        case LOAD_SEGMENT:
+            return "LoadSeg";
+        case LOAD_IN_USE:
+            return get_string(MSG_LOAD_IN_USE);
+        case LOAD_SKIPPED:
+            return get_string(MSG_LOAD_SKIPPED);
+        case LOAD_FAILED:
+            return get_string(MSG_LOAD_FAILED);
+        default:
+            return "---";
+    }
+}
+
+/*
+ * Profile these names instead of the LIBS: and DEVS: contents
+ */
+void set_load_list(const char *names)
+{
+    load_names[0] = '\0';
+    if (names) strncpy(load_names, names, sizeof(load_names) - 1);
+}
+
+/*
+ * TRUE if a name ends in a suffix, ignoring case
+ */
+static BOOL has_suffix(const char *name, const char *suffix)
+{
+    size_t len = strlen(name);
+    size_t slen = strlen(suffix);
+
+    return len > slen && stricmp(name + len - slen, suffix) == 0;
+}
+
+/*
+ * Add a library or device by name, other files are ignored
+ */
+static void add_load_entry(const char *name)
+{
+    LoadEntry *entry;
+    const char *interned;
+
+    if (!has_suffix(name, ".library") && !has_suffix(name, ".device")) return;
+
+    interned = arena_intern(name);
+    if (!interned || !ARENA_RESERVE(load_list.entries, load_list.count, load_list.capacity)) return;
+
+    entry = &load_list.entries[load_list.count++];
+    memset(entry, 0, sizeof(*entry));
+    entry->name = interned;
+    entry->device = has_suffix(name, ".device");
+}
+
+/*
+ * Add the files of a directory
+ */
+static void scan_load_directory(const char *path)
+{
+    struct FileInfoBlock *fib;
+    BPTR lock;
+
+    lock = Lock((CONST_STRPTR)path, ACCESS_READ);
+    if (!lock) return;
+
+    fib = (struct FileInfoBlock *)AllocDosObject(DOS_FIB, NULL);
+    if (fib) {
+        if (Examine(lock, fib)) {
+            while (ExNext(lock, fib)) {
+                if (fib->fib_DirEntryType < 0) add_load_entry((const char *)fib->fib_FileName);
+            }
+        }
+        FreeDosObject(DOS_FIB, fib);
+    }
+
+    UnLock(lock);
+}
+
+/*
+ * Add the names of the LOADLIST argument
+ */
+static void parse_load_names(void)
+{
+    char name[32];
+    const char *p = load_names;
+
+    while (*p) {
+        ULONG len = 0;
+
+        while (*p == ',' || *p == ' ') p++;
+        while (*p && *p != ',') {
+            if (len < sizeof(name) - 1) name[len++] = *p;
+            p++;
+        }
+        while (len > 0 && name[len - 1] == ' ') len--;
+        name[len] = '\0';
+
+        if (len > 0) add_load_entry(name);
+    }
+}
+
+/*
+ * Library or device node of that name
+ */
+static struct Node *find_loaded(struct List *list, const char *name)
+{
+    struct Node *node;
+
+    Forbid();
+    node = FindName(list, (CONST_STRPTR)FilePart((CONST_STRPTR)name));
+    Permit();
+
+    return node;
+}
+
+/*
+ * TRUE for libraries that must not be opened
+ */
+static BOOL is_unsafe_library(const char *name)
+{
+    const char *base = (const char *)FilePart((CONST_STRPTR)name);
+    ULONG i;
+
+    for (i = 0; unsafe_libraries[i]; i++) {
+        if (stricmp(base, unsafe_libraries[i]) == 0) return TRUE;
+    }
+
+    return FALSE;
+}
+
+/*
+ * Expunge a library nobody has open, TRUE if it is gone
+ * RemLibrary() only calls the Expunge vector, the seglist it returns
+ * is unloaded by ramlib's low-memory handler. So memory is flushed the
+ * way "Avail FLUSH" does it, which expunges every unused library, and
+ * the library list is checked afterwards.
+ */
+static BOOL expunge_library(struct Library *lib, const char *name)
+{
+    APTR block;
+
+    if (find_loaded(&SysBase->LibList, name) != (struct Node *)lib) return TRUE;
+
+    block = AllocMem(LOAD_FLUSH_SIZE, MEMF_PUBLIC);
+    if (block) FreeMem(block, LOAD_FLUSH_SIZE);
+
+    return find_loaded(&SysBase->LibList, name) != (struct Node *)lib;
+}
+
+/*
+ * Time OpenLibrary() of a library that is not in memory
+ */
+static void profile_library(LoadEntry *entry)
+{
+    struct Library *lib;
+    uint64_t start;
+    ULONG before, after;
+
+    if (is_unsafe_library(entry->name)) {
+        entry->status = LOAD_SKIPPED;
+        return;
+    }
+    if (find_loaded(&SysBase->LibList, entry->name)) {
+        entry->status = LOAD_IN_USE;
+        return;
+    }
+
+    before = AvailMem(MEMF_ANY);
+    start = get_timer_ticks();
+    lib = OpenLibrary((CONST_STRPTR)entry->name, 0);
+    entry->load_us = (ULONG)(get_timer_ticks() - start);
+    after = AvailMem(MEMF_ANY);
+
+    if (!lib) {
+        entry->status = LOAD_FAILED;
+        return;
+    }
+
+    entry->footprint = (before > after) ? before - after : 0;
+
+    CloseLibrary(lib);
+    entry->status = expunge_library(lib, entry->name) ? LOAD_EXPUNGED : LOAD_KEPT;
+}
+
+/*
+ * Time LoadSeg() of a device, its size is the sum of its hunks
+ */
+static void profile_device(LoadEntry *entry)
+{
+    char path[48];
+    uint64_t start;
+    BPTR seglist, seg;
+    ULONG hunks = 0;
+
+    if (strchr(entry->name, ':')) {
+        strncpy(path, entry->name, sizeof(path) - 1);
+        path[sizeof(path) - 1] = '\0';
+    } else {
+        snprintf(path, sizeof(path), "DEVS:%s", entry->name);
+    }
+
+    start = get_timer_ticks();
+    seglist = LoadSeg((CONST_STRPTR)path);
+    entry->load_us = (ULONG)(get_timer_ticks() - start);
+
+    if (!seglist) {
+        entry->status = LOAD_FAILED;
+        return;
+    }
+
+    for (seg = seglist; seg && hunks++ < MAX_LOAD_HUNKS; seg = *(BPTR *)BADDR(seg)) {
+        ULONG size = ((ULONG *)BADDR(seg))[-1];
+
+        if (size > MAX_LOAD_HUNK_SIZE) break;
+        entry->footprint += size;
+    }
+
+    UnLoadSeg(seglist);
+    entry->status = LOAD_SEGMENT;
+}
+
+/* Comparison for sorting: most expensive first, unmeasured last */
+static int compare_load_entries(const LoadEntry *a, const LoadEntry *b)
+{
+    if (a->load_us != b->load_us) return a->load_us > b->load_us ? -1 : 1;
+    return stricmp(a->name, b->name);
+}
+
+/*
+ * Load each library and device, time it and unload it again
+ */
+BOOL run_load_profiler(void)
+{
+    ULONG i, j;
+
+    load_list.count = 0;
+    load_list.total_us = 0;
+    load_list.valid = FALSE;
+    load_page = 0;
+
+    if (load_names[0]) {
+        parse_load_names();
+    } else {
+        scan_load_directory("LIBS:");
+        scan_load_directory("DEVS:");
+    }
+
+    if (load_list.count == 0) return FALSE;
+
+    for (i = 0; i < load_list.count; i++) {
+        LoadEntry *entry = &load_list.entries[i];
+
+        if (entry->device) {
+            profile_device(entry);
+        } else {
+            profile_library(entry);
+        }
+
+        load_list.total_us += entry->load_us;
+
+        debug("  loadtime: %s %lu us, %lu bytes\n", entry->name,
+              (unsigned long)entry->load_us, (unsigned long)entry->footprint);
+    }
+
+    /* Simple bubble sort - OK for small lists */
+    for (i = 0; i + 1 < load_list.count; i++) {
+        for (j = 0; j < load_list.count - i - 1; j++) {
+            if (compare_load_entries(&load_list.entries[j], &load_list.entries[j + 1]) > 0) {
+                LoadEntry temp = load_list.entries[j];
+                load_list.entries[j] = load_list.entries[j + 1];
+                load_list.entries[j + 1] = temp;
+            }
+        }
+    }
+
+    load_list.valid = TRUE;
+    return TRUE;
+}
+
+/*
+ * Draw one page of results
+ */
+static void draw_load_rows(void)
+{
+    char buffer[40];
+    ULONG i;
+    WORD y = 56;
+
+    for (i = load_page * LOAD_PAGE_ROWS;
+         i < load_list.count && i < (load_page + 1) * LOAD_PAGE_ROWS; i++) {
+        const LoadEntry *entry = &load_list.entries[i];
+
+        snprintf(buffer, sizeof(buffer), "%.*s", LOAD_NAME_CHARS, entry->name);
+        draw_text(LOAD_COL_NAME, y, buffer, COLOR_TEXT);
+
+        if (entry->load_us) {
+            snprintf(buffer, sizeof(buffer), "%6lu.%lu", (unsigned long)(entry->load_us / 1000),
+                     (unsigned long)(entry->load_us % 1000 / 100));
+            draw_text(LOAD_COL_TIME, y, buffer, COLOR_HIGHLIGHT);
+        }
+
+        if (entry->footprint) {
+            snprintf(buffer, sizeof(buffer), "%6lu", (unsigned long)((entry->footprint + 1023) / 1024));
+            draw_text(LOAD_COL_SIZE, y, buffer, COLOR_HIGHLIGHT);
+        }
+
+        draw_text(LOAD_COL_STATUS, y, get_load_status_string((LoadStatus)entry->status),
+                  entry->status == LOAD_KEPT ? COLOR_BAR_YOU : COLOR_TEXT);
+
+        y += LOAD_ROW_HEIGHT;
+    }
+}
+
+/*
+ * Draw library load-time view
+ */
+void draw_loadtime_view(void)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[80];
+    Button *btn;
+
+    /* Draw title panel */
+    draw_panel(20, 0, 600, 24, NULL);
+
+    SetAPen(rp, COLOR_TEXT);
+    SetBPen(rp, COLOR_PANEL_BG);
+    Move(rp, 220, 14);
+    Text(rp, (CONST_STRPTR)get_string(MSG_LOADTIME),
+         strlen(get_string(MSG_LOADTIME)));
+
+    /* Draw column headers */
+    SetAPen(rp, COLOR_TEXT);
+    TightText(rp, LOAD_COL_NAME, 40, (CONST_STRPTR)get_string(MSG_RES_MODULE), -1, 4);
+    TightText(rp, LOAD_COL_TIME, 40, (CONST_STRPTR)get_string(MSG_LOAD_MS), -1, 4);
+    TightText(rp, LOAD_COL_SIZE, 40, (CONST_STRPTR)get_string(MSG_LOAD_KB), -1, 4);
+    TightText(rp, LOAD_COL_STATUS, 40, (CONST_STRPTR)get_string(MSG_LOAD_STATUS), -1, 4);
+
+    /* Draw separator line */
+    SetAPen(rp, COLOR_BUTTON_DARK);
+    Move(rp, 20, 44);
+    Draw(rp, 628, 44);
+
+    /* Status line */
+    if (load_list.valid) {
+        draw_load_rows();
+
+        snprintf(buffer, sizeof(buffer), "%lu %s, %lu.%lu s",
+                 (unsigned long)load_list.count, get_string(MSG_RES_MODULES),
+                 (unsigned long)(load_list.total_us / 1000000),
+                 (unsigned long)(load_list.total_us % 1000000 / 100000));
+        draw_text(LOAD_COL_NAME, LOAD_STATUS_Y, buffer, COLOR_TEXT);
+    } else {
+        draw_text(LOAD_COL_NAME, LOAD_STATUS_Y, get_string(MSG_LOAD_HINT), COLOR_TEXT);
+    }
+
+    /* Draw buttons */
+    btn = find_button(BTN_LOAD_EXIT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_LOAD_START);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_LOAD_NEXT);
+    if (btn) draw_button(btn);
+}
+
+/*
+ * Update buttons for library load-time view
+ */
+void loadtime_view_update_buttons(void)
+{
+    add_button(20, 188, 60, 12,
+               get_string(MSG_BTN_EXIT), BTN_LOAD_EXIT, TRUE);
+    add_button(100, 188, 60, 12,
+               get_string(MSG_BTN_START), BTN_LOAD_START, TRUE);
+    add_button(180, 188, 60, 12,
+               get_string(MSG_BTN_NEXT), BTN_LOAD_NEXT, load_list.count > LOAD_PAGE_ROWS);
+}
+
+/*
+ * Handle button press for library load-time view
+ */
+void loadtime_view_handle_button(ButtonID id)
+{
+    switch (id) {
+        case BTN_LOAD_START:
+            if (show_confirm_requester(get_string(MSG_LOADTIME),
+                                       get_string(MSG_LOAD_CONFIRM))) {
+                /* The window is not refreshed while loading */
+                redraw_current_view();
+                SetAPen(app->rp, COLOR_BACKGROUND);
+                RectFill(app->rp, LOAD_COL_NAME, LOAD_STATUS_Y - 7, 612, LOAD_STATUS_Y + 2);
+                draw_text(LOAD_COL_NAME, LOAD_STATUS_Y, get_string(MSG_LAT_MEASURING),
+                          COLOR_HIGHLIGHT);
+
+                run_load_profiler();
+            }
+            redraw_current_view();
+            break;
+
+        case BTN_LOAD_NEXT:
+            load_page++;
+            if (load_page * LOAD_PAGE_ROWS >= load_list.count) load_page = 0;
+            redraw_current_view();
+            break;
+
+        case BTN_LOAD_EXIT:
+            switch_to_view(VIEW_MAIN);
+            break;
+
+        default:
+            break;
+    }
+}
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Library load-time profiler header
+ */
+
+#ifndef LOADTIME_H
+#define LOADTIME_H
+
+#include "xsysinfo.h"
+
+/* LOADLIST argument: comma separated names */
+#define LOAD_LIST_ARG_SIZE      256
+
+/* Outcome of one entry */
+typedef enum {
+    LOAD_EXPUNGED,          /* Opened, closed and expunged again */
+    LOAD_KEPT,              /* Opened and closed, the library stayed in memory */
+    LOAD_SEGMENT,           /* Device: LoadSeg() only, unloaded again */
+    LOAD_IN_USE,            /* Already in memory, nothing to measure */
+    LOAD_SKIPPED,           /* Known to patch the system for good */
+    LOAD_FAILED
+} LoadStatus;
+
+/* One library or device */
+typedef struct {
+    const char *name;       /* Interned */
+    BOOL device;
+    UBYTE status;           /* LoadStatus */
+    ULONG load_us;          /* OpenLibrary() (LoadSeg + init), LoadSeg() for devices */
+    ULONG footprint;        /* Bytes the load took */
+} LoadEntry;
+
+/* Results, most expensive first */
+typedef struct {
+    LoadEntry *entries;     /* Grown in the arena */
+    ULONG count;
+    ULONG capacity;
+    ULONG total_us;
+    BOOL valid;
+} LoadList;
+
+/* Global load-time results */
+extern LoadList load_list;
+
+/* Function prototypes */
+
+/* Profile these names instead of the LIBS: and DEVS: contents */
+void set_load_list(const char *names);
+
+/* Load each library and device, time it and unload it again */
+BOOL run_load_profiler(void);
+
+/* Short name of an outcome */
+const char *get_load_status_string(LoadStatus status);
+
+/* Draw library load-time view */
+void draw_loadtime_view(void);
+
+#endif /* LOADTIME_H */
@@ -29,11 +29,17 @@ static const char *default_strings[MSG_COUNT] = {
     /* MSG_BOARDS_INFO */       "AUTOCONFIG BOARDS INFORMATION",
     /* MSG_DRIVES_INFO */       "DRIVES INFORMATION",
     /* MSG_SCSI_INFO */         "SCSI DEVICE INFORMATION",
+    /* MSG_COPY_BANDWIDTH */    "COPY BANDWIDTH (MB/s)",
+    /* MSG_PRIORITY_ADVISOR */  "MEMORY PRIORITY ADVISOR",
 
     /* Software type cycle */
     /* MSG_LIBRARIES */         "LIBRARIES",
     /* MSG_DEVICES */           "DEVICES",
     /* MSG_RESOURCES */         "RESOURCES",
+    /* MSG_TASKS */             "TASKS",
+    /* MSG_TASK_RUN */          "Run",
+    /* MSG_TASK_READY */        "Ready",
+    /* MSG_TASK_WAIT */         "Wait",
 
     /* Scale toggle */
     /* MSG_EXPAND */            "EXPAND",
@@ -93,6 +99,135 @@ static const char *default_strings[MSG_COUNT] = {
     /* MSG_NUM_CHUNKS */        "NUMBER OF CHUNKS",
     /* MSG_NODE_NAME */         "NODE NAME",
     /* MSG_MEMORY_SPEED */      "MEMORY SPEED",
+    /* MSG_CACHE_MODE */        "CACHE MODE",
+    /* MSG_UNCACHED_FAST_WARNING */ "UNCACHED FAST RAM!",
+    /* MSG_BUS_WIDTH */         "BUS WIDTH",
+    /* MSG_MEMORY_BOARD */      "BOARD",
+    /* MSG_MEMORY_NO_BOARD */   "Built-in (no Autoconfig board)",
+    /* MSG_FRAGMENTATION */     "FRAG",
+    /* MSG_COPY_FROM_TO */      "FROM / TO",
+    /* MSG_COPY_KERNELS */      "KERNELS",
+    /* MSG_SPEED_NOT_MEASURED */ "Press SPEED to measure",
+    /* MSG_PRI_REGION */        "REGION",
+    /* MSG_PRI_CURRENT */       "CURRENT",
+    /* MSG_PRI_PROPOSED */      "PROPOSED",
+    /* MSG_PRI_OPTIMAL */       "Current order is already optimal",
+    /* MSG_PRI_CHIP_KEPT */     "CHIP RAM keeps its priority",
+    /* MSG_PRI_CONFIRM */       "Reorder memory list now?",
+    /* MSG_ALLOC_BENCHMARK */   "ALLOCATOR BENCHMARK",
+    /* MSG_ALLOC_TYPE */        "TYPE",
+    /* MSG_ALLOC_FUNCTION */    "FUNCTION",
+    /* MSG_ALLOC_RATE */        "ALLOCS/S",
+    /* MSG_ALLOC_WORST */       "WORST",
+    /* MSG_ALLOC_PAIRS */       "PAIRS/S",
+    /* MSG_ALLOC_CHUNKS */      "CHUNKS",
+    /* MSG_ALLOC_LARGEST */     "LARGEST",
+    /* MSG_ALLOC_FRAG */        "FRAG",
+    /* MSG_ALLOC_PATCHED */     "patched",
+    /* MSG_ALLOC_TRACE */       "ALLOCATION TRACE",
+    /* MSG_TRACE_TASK */        "TASK",
+    /* MSG_TRACE_OUTSTANDING */ "OUTSTANDING",
+    /* MSG_TRACE_SIZE */        "SIZE",
+    /* MSG_TRACE_COUNT */       "COUNT",
+    /* MSG_TRACE_HINT */        "Press TRACE, then run your programs",
+    /* MSG_TRACE_RUNNING */     "Tracing:",
+    /* MSG_TRACE_WINDOW */      "Window:",
+    /* MSG_TRACE_EVENTS */      "events",
+    /* MSG_TRACE_LOST */        "lost",
+    /* MSG_TRACE_EXITED */      "(exited)",
+    /* MSG_TRACE_UNPATCH_FAILED */ "Patch still in place",
+    /* MSG_CPU_USAGE */         "CPU Usage",
+    /* MSG_CPU_IDLE */          "(idle)",
+    /* MSG_CPU_OTHER */         "(other tasks)",
+    /* MSG_CPU_SAMPLES */       "samples",
+    /* MSG_CPU_IDLE_ENTRIES */  "idle entries/s",
+    /* MSG_CPU_HINT */          "Press START to sample the running task",
+    /* MSG_CPU_WAITING */       "Sampling...",
+    /* MSG_CPU_CODE */          "Code",
+    /* MSG_CPU_KICKSTART */     "Kickstart (other)",
+    /* MSG_CPU_UNKNOWN */       "Unknown code",
+    /* MSG_CPU_CODE_HINT */     "Press START to profile the running code",
+    /* MSG_CPU_RANGES */        "code ranges",
+    /* MSG_INTERRUPTS */        "Interrupt Servers",
+    /* MSG_INT_VECTOR */        "VECTOR",
+    /* MSG_INT_SERVER */        "SERVER",
+    /* MSG_INT_PRI */           "PRI",
+    /* MSG_INT_CALLS */         "CALLS/S",
+    /* MSG_INT_AVG */           "AVG US",
+    /* MSG_INT_MAX */           "MAX US",
+    /* MSG_INT_HANDLER */       "(handler)",
+    /* MSG_INT_HINT */          "Press TIME to measure the servers",
+    /* MSG_INT_MEASURING */     "Measuring servers...",
+    /* MSG_LATENCY */           "Interrupt Latency",
+    /* MSG_LAT_ENTRY */         "Interrupt entry",
+    /* MSG_LAT_WAKEUP */        "Task wakeup",
+    /* MSG_LAT_MIN */           "MIN US",
+    /* MSG_LAT_P99 */           "P99 US",
+    /* MSG_LAT_SAMPLES */       "Samples:",
+    /* MSG_LAT_MISSED */        "missed wakeups",
+    /* MSG_LAT_NEEDS_V36 */     "Needs timer.device V36",
+    /* MSG_LAT_HINT */          "Press START to measure, Ctrl-C aborts",
+    /* MSG_LAT_MEASURING */     "Measuring...",
+    /* MSG_EXC_DISPATCH */      "Exception dispatch:",
+    /* MSG_EXC_PER_TRAP */      "us per TRAP",
+    /* MSG_EXC_BEFORE */        "us with VBR",
+    /* MSG_EXC_FASTER */        "faster",
+    /* MSG_EXC_VBR_CHIP */      "Vector table in CHIP RAM",
+    /* MSG_VBR_CONFIRM */       "Move the vector table to FAST RAM until reboot?",
+    /* MSG_IPC_BENCHMARK */     "Exec IPC Benchmark",
+    /* MSG_IPC_MESSAGES */      "Message round trip",
+    /* MSG_IPC_SIGNALS */       "Signal round trip",
+    /* MSG_IPC_SEMAPHORE */     "Semaphore, free",
+    /* MSG_IPC_CONTENDED */     "Semaphore, contended",
+    /* MSG_IPC_FORBID */        "Forbid/Permit",
+    /* MSG_IPC_TEST */          "TEST",
+    /* MSG_IPC_OPS */           "OPS/S",
+    /* MSG_IPC_US */            "US/OP",
+    /* MSG_IPC_SWITCH */        "Context switch:",
+    /* MSG_IPC_HINT */          "Press START to time exec messages, signals and semaphores",
+    /* MSG_PATCHES */           "Library Patches",
+    /* MSG_PATCH_LIBRARY */     "LIBRARY",
+    /* MSG_PATCH_LVO */         "LVO",
+    /* MSG_PATCH_TARGET */      "TARGET",
+    /* MSG_PATCH_OWNER */       "OWNER",
+    /* MSG_PATCH_NONE */        "No patched vectors found",
+    /* MSG_PATCH_PATCHED */     "patched",
+    /* MSG_PATCH_CHECKED */     "vectors checked",
+    /* MSG_PATCH_HINT */        "TIME measures common exec calls, * = patched",
+    /* MSG_RESIDENTS */         "Resident Modules",
+    /* MSG_RES_MODULE */        "MODULE",
+    /* MSG_RES_VERSION */       "VER",
+    /* MSG_RES_ADDRESS */       "ADDRESS",
+    /* MSG_RES_SPEED */         "SPEED",
+    /* MSG_RES_SOURCE */        "SOURCE",
+    /* MSG_RES_PENDING */       "Reset",
+    /* MSG_RES_MODULES */       "modules",
+    /* MSG_LOADTIME */          "Library Load Times",
+    /* MSG_LOAD_MS */           "MS",
+    /* MSG_LOAD_KB */           "KB",
+    /* MSG_LOAD_STATUS */       "STATUS",
+    /* MSG_LOAD_EXPUNGED */     "Expunged",
+    /* MSG_LOAD_KEPT */         "Stays",
+    /* MSG_LOAD_IN_USE */       "In use",
+    /* MSG_LOAD_SKIPPED */      "Skipped",
+    /* MSG_LOAD_FAILED */       "Failed",
+    /* MSG_LOAD_HINT */         "START loads each library in LIBS: and device in DEVS:",
+    /* MSG_LOAD_CONFIRM */      "Open each unused library in LIBS: and load each device in DEVS:?",
+    /* MSG_MEMORY_TEST */       "Memory Test",
+    /* MSG_MEMTEST_WALKING_ONES */ "Walking ones",
+    /* MSG_MEMTEST_WALKING_ZEROS */ "Walking zeros",
+    /* MSG_MEMTEST_ADDRESS */   "Address in address",
+    /* MSG_MEMTEST_ADDRESS_INVERTED */ "Inverted address",
+    /* MSG_MEMTEST_RANDOM */    "Random pattern",
+    /* MSG_MEMTEST_TESTED */    "Tested:",
+    /* MSG_MEMTEST_ERRORS */    "Errors:",
+    /* MSG_MEMTEST_EXPECTED */  "expected",
+    /* MSG_MEMTEST_READ */      "read",
+    /* MSG_MEMTEST_PASSED */    "None, all passes OK",
+    /* MSG_MEMTEST_ABORTED */   "Test aborted",
+    /* MSG_MEMTEST_HINT */      "Press TEST to check the free memory of this region",
+    /* MSG_MEMTEST_STOP_HINT */ "ESC or mouse click aborts",
+    /* MSG_MEMTEST_NOTHING */   "No free memory could be claimed",
 
     /* Drives view labels */
     /* MSG_DISK_ERRORS */       "NUMBER OF DISK ERRORS",
@@ -123,6 +258,9 @@ static const char *default_strings[MSG_COUNT] = {
     /* MSG_MANUFACTURER */      "Manufacturer",
     /* MSG_SERIAL_NO */         "Serial No.",
     /* MSG_BOARDS_NO_BOARDS_FOUND */ "No expansion boards found",
+    /* MSG_BOARD_MEMORY */      "Memory",
+    /* MSG_BOARD_READ */        "Read",
+    /* MSG_BOARD_WRITE */       "Write",
 
     /* Button labels */
     /* MSG_BTN_QUIT */          "QUIT",
@@ -138,6 +276,20 @@ static const char *default_strings[MSG_COUNT] = {
     /* MSG_BTN_OK */            "OK",
     /* MSG_BTN_CANCEL */        "CANCEL",
     /* MSG_BTN_ALL */           "ALL",
+    /* MSG_BTN_COPY */          "COPY",
+    /* MSG_BTN_PRIORITY */      "PRIORITY",
+    /* MSG_BTN_LIVE */          "LIVE",
+    /* MSG_BTN_STOP */          "STOP",
+    /* MSG_BTN_START */         "START",
+    /* MSG_BTN_TASKS */         "TASKS",
+    /* MSG_BTN_CODE */          "CODE",
+    /* MSG_BTN_TIME */          "TIME",
+    /* MSG_BTN_MOVE_VBR */      "VBR>FAST",
+    /* MSG_BTN_ALLOC */         "ALLOC",
+    /* MSG_BTN_TRACE */         "TRACE",
+    /* MSG_BTN_TEST */          "TEST",
+    /* MSG_BTN_APPLY */         "APPLY",
+    /* MSG_BTN_SCRIPT */        "SCRIPT",
 
     /* Status and values */
     /* MSG_NA */                "N/A",
@@ -23,11 +23,17 @@ typedef enum {
     MSG_BOARDS_INFO,
     MSG_DRIVES_INFO,
     MSG_SCSI_INFO,
+    MSG_COPY_BANDWIDTH,
+    MSG_PRIORITY_ADVISOR,
 
     /* Software type cycle */
     MSG_LIBRARIES,
     MSG_DEVICES,
     MSG_RESOURCES,
+    MSG_TASKS,
+    MSG_TASK_RUN,
+    MSG_TASK_READY,
+    MSG_TASK_WAIT,
 
     /* Scale toggle */
     MSG_EXPAND,
@@ -87,6 +93,135 @@ typedef enum {
     MSG_NUM_CHUNKS,
     MSG_NODE_NAME,
     MSG_MEMORY_SPEED,
+    MSG_CACHE_MODE,
+    MSG_UNCACHED_FAST_WARNING,
+    MSG_BUS_WIDTH,
+    MSG_MEMORY_BOARD,
+    MSG_MEMORY_NO_BOARD,
+    MSG_FRAGMENTATION,
+    MSG_COPY_FROM_TO,
+    MSG_COPY_KERNELS,
+    MSG_SPEED_NOT_MEASURED,
+    MSG_PRI_REGION,
+    MSG_PRI_CURRENT,
+    MSG_PRI_PROPOSED,
+    MSG_PRI_OPTIMAL,
+    MSG_PRI_CHIP_KEPT,
+    MSG_PRI_CONFIRM,
+    MSG_ALLOC_BENCHMARK,
+    MSG_ALLOC_TYPE,
+    MSG_ALLOC_FUNCTION,
+    MSG_ALLOC_RATE,
+    MSG_ALLOC_WORST,
+    MSG_ALLOC_PAIRS,
+    MSG_ALLOC_CHUNKS,
+    MSG_ALLOC_LARGEST,
+    MSG_ALLOC_FRAG,
+    MSG_ALLOC_PATCHED,
+    MSG_ALLOC_TRACE,
+    MSG_TRACE_TASK,
+    MSG_TRACE_OUTSTANDING,
+    MSG_TRACE_SIZE,
+    MSG_TRACE_COUNT,
+    MSG_TRACE_HINT,
+    MSG_TRACE_RUNNING,
+    MSG_TRACE_WINDOW,
+    MSG_TRACE_EVENTS,
+    MSG_TRACE_LOST,
+    MSG_TRACE_EXITED,
+    MSG_TRACE_UNPATCH_FAILED,
+    MSG_CPU_USAGE,
+    MSG_CPU_IDLE,
+    MSG_CPU_OTHER,
+    MSG_CPU_SAMPLES,
+    MSG_CPU_IDLE_ENTRIES,
+    MSG_CPU_HINT,
+    MSG_CPU_WAITING,
+    MSG_CPU_CODE,
+    MSG_CPU_KICKSTART,
+    MSG_CPU_UNKNOWN,
+    MSG_CPU_CODE_HINT,
+    MSG_CPU_RANGES,
+    MSG_INTERRUPTS,
+    MSG_INT_VECTOR,
+    MSG_INT_SERVER,
+    MSG_INT_PRI,
+    MSG_INT_CALLS,
+    MSG_INT_AVG,
+    MSG_INT_MAX,
+    MSG_INT_HANDLER,
+    MSG_INT_HINT,
+    MSG_INT_MEASURING,
+    MSG_LATENCY,
+    MSG_LAT_ENTRY,
+    MSG_LAT_WAKEUP,
+    MSG_LAT_MIN,
+    MSG_LAT_P99,
+    MSG_LAT_SAMPLES,
+    MSG_LAT_MISSED,
+    MSG_LAT_NEEDS_V36,
+    MSG_LAT_HINT,
+    MSG_LAT_MEASURING,
+    MSG_EXC_DISPATCH,
+    MSG_EXC_PER_TRAP,
+    MSG_EXC_BEFORE,
+    MSG_EXC_FASTER,
+    MSG_EXC_VBR_CHIP,
+    MSG_VBR_CONFIRM,
+    MSG_IPC_BENCHMARK,
+    MSG_IPC_MESSAGES,
+    MSG_IPC_SIGNALS,
+    MSG_IPC_SEMAPHORE,
+    MSG_IPC_CONTENDED,
+    MSG_IPC_FORBID,
+    MSG_IPC_TEST,
+    MSG_IPC_OPS,
+    MSG_IPC_US,
+    MSG_IPC_SWITCH,
+    MSG_IPC_HINT,
+    MSG_PATCHES,
+    MSG_PATCH_LIBRARY,
+    MSG_PATCH_LVO,
+    MSG_PATCH_TARGET,
+    MSG_PATCH_OWNER,
+    MSG_PATCH_NONE,
+    MSG_PATCH_PATCHED,
+    MSG_PATCH_CHECKED,
+    MSG_PATCH_HINT,
+    MSG_RESIDENTS,
+    MSG_RES_MODULE,
+    MSG_RES_VERSION,
+    MSG_RES_ADDRESS,
+    MSG_RES_SPEED,
+    MSG_RES_SOURCE,
+    MSG_RES_PENDING,
+    MSG_RES_MODULES,
+    MSG_LOADTIME,
+    MSG_LOAD_MS,
+    MSG_LOAD_KB,
+    MSG_LOAD_STATUS,
+    MSG_LOAD_EXPUNGED,
+    MSG_LOAD_KEPT,
+    MSG_LOAD_IN_USE,
+    MSG_LOAD_SKIPPED,
+    MSG_LOAD_FAILED,
+    MSG_LOAD_HINT,
+    MSG_LOAD_CONFIRM,
+    MSG_MEMORY_TEST,
+    MSG_MEMTEST_WALKING_ONES,
+    MSG_MEMTEST_WALKING_ZEROS,
+    MSG_MEMTEST_ADDRESS,
+    MSG_MEMTEST_ADDRESS_INVERTED,
+    MSG_MEMTEST_RANDOM,
+    MSG_MEMTEST_TESTED,
+    MSG_MEMTEST_ERRORS,
+    MSG_MEMTEST_EXPECTED,
+    MSG_MEMTEST_READ,
+    MSG_MEMTEST_PASSED,
+    MSG_MEMTEST_ABORTED,
+    MSG_MEMTEST_HINT,
+    MSG_MEMTEST_STOP_HINT,
+    MSG_MEMTEST_NOTHING,
 
     /* Drives view labels */
     MSG_DISK_ERRORS,
@@ -117,6 +252,9 @@ typedef enum {
     MSG_MANUFACTURER,
     MSG_SERIAL_NO,
     MSG_BOARDS_NO_BOARDS_FOUND,
+    MSG_BOARD_MEMORY,
+    MSG_BOARD_READ,
+    MSG_BOARD_WRITE,
 
     /* Button labels */
     MSG_BTN_QUIT,
@@ -132,6 +270,20 @@ typedef enum {
     MSG_BTN_OK,
     MSG_BTN_CANCEL,
     MSG_BTN_ALL,
+    MSG_BTN_COPY,
+    MSG_BTN_PRIORITY,
+    MSG_BTN_LIVE,
+    MSG_BTN_STOP,
+    MSG_BTN_START,
+    MSG_BTN_TASKS,
+    MSG_BTN_CODE,
+    MSG_BTN_TIME,
+    MSG_BTN_MOVE_VBR,
+    MSG_BTN_ALLOC,
+    MSG_BTN_TRACE,
+    MSG_BTN_TEST,
+    MSG_BTN_APPLY,
+    MSG_BTN_SCRIPT,
 
     /* Status and values */
     MSG_NA,
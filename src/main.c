@@ -35,6 +35,15 @@
 #include "benchmark.h"
 #include "locale_str.h"
 #include "debug.h"
+#include "mmu.h"
+#include "mempri.h"
+#include "memtrace.h"
+#include "sampler.h"
+#include "interrupts.h"
+#include "patches.h"
+#include "residents.h"
+#include "loadtime.h"
+#include "arena.h"
 
 /* Amiga version string for the Version command */
 __attribute__((used))
@@ -53,6 +62,9 @@ static struct WBStartup *wb_startup = NULL;
 /* Global debug flag */
 BOOL g_debug_enabled = FALSE;
 
+/* MEMPRI argument: set memory priorities and exit without GUI */
+static char mempri_arg[256];
+
 /* Global application context */
 AppContext app_context;
 struct TextAttr Topaz8Font = {
@@ -64,11 +76,13 @@ struct TextAttr Topaz8Font = {
 AppContext *app = &app_context;
 
 /* Command line argument template */
-#define TEMPLATE "DEBUG/S"
+#define TEMPLATE "DEBUG/S,MEMPRI/K,LOADLIST/K"
 
 /* Argument array indices */
 enum {
     ARG_DEBUG,
+    ARG_MEMPRI,
+    ARG_LOADLIST,
     ARG_COUNT
 };
 
@@ -119,6 +133,16 @@ static BOOL parse_args(void)
         g_debug_enabled = TRUE;
     }
 
+    /* Keep MEMPRI value, FreeArgs() releases the argument strings */
+    if (args[ARG_MEMPRI]) {
+        strncpy(mempri_arg, (const char *)args[ARG_MEMPRI], sizeof(mempri_arg) - 1);
+    }
+
+    /* Names for the load-time profiler instead of LIBS: and DEVS: */
+    if (args[ARG_LOADLIST]) {
+        set_load_list((const char *)args[ARG_LOADLIST]);
+    }
+
     FreeArgs(rdargs);
     return TRUE;
 }
@@ -184,6 +208,18 @@ int main(int argc, char **argv)
         parse_args();
     }
 
+    /* MEMPRI only reorders the memory list (boot script use) */
+    if (mempri_arg[0]) {
+        LONG changed = apply_memory_priorities(mempri_arg);
+
+        if (changed < 0) {
+            Printf((CONST_STRPTR)"Invalid MEMPRI argument, expected $address:priority[,...]\n");
+            return RETURN_ERROR;
+        }
+        debug(XSYSINFO_NAME ": %ld memory priorities changed\n", changed);
+        return RETURN_OK;
+    }
+
     debug(XSYSINFO_NAME ": Starting...\n");
 
     /* Initialize application context */
@@ -218,22 +254,31 @@ int main(int argc, char **argv)
         goto cleanup;
     }
 
+    /* Initialize benchmark timer (also times the Forbid() sections) */
+    if (!init_timer()) {
+        Printf((CONST_STRPTR)"Failed to initialize timer\n");
+        ret = RETURN_FAIL;
+        goto cleanup;
+    }
+
     debug(XSYSINFO_NAME ": Enumerating software...\n");
     /* Enumerate system software */
     enumerate_all_software();
 
+    debug(XSYSINFO_NAME ": Enumerating boards...\n");
+    /* Enumerate expansion boards (before memory, which links to them) */
+    enumerate_boards();
+
     debug(XSYSINFO_NAME ": Enumerating memory...\n");
     /* Enumerate memory regions */
     enumerate_memory_regions();
 
-    debug(XSYSINFO_NAME ": Enumerating boards...\n");
-    /* Enumerate expansion boards */
-    enumerate_boards();
-
     debug(XSYSINFO_NAME ": Enumerating drives...\n");
     /* Enumerate drives */
     enumerate_drives();
 
+    report_worst_forbid();
+
     debug(XSYSINFO_NAME ": Opening display...\n");
     /* Open display (screen or window) */
     if (!open_display()) {
@@ -245,22 +290,20 @@ int main(int argc, char **argv)
     /* Initialize GUI buttons */
     init_buttons();
 
-    /* Initialize benchmark timer */
-    if (!init_timer()) {
-        Printf((CONST_STRPTR)"Failed to initialize timer\n");
-        ret = RETURN_FAIL;
-        goto cleanup;
-    }
-
     /* Draw initial view */
     redraw_current_view();
 
     /* Main event loop */
     main_loop();
 
+    report_worst_forbid();
+
 cleanup:
+    cleanup_alloc_trace();
+    cleanup_cpu_sampler();
     cleanup_timer();
     close_display();
+    arena_free();
     close_libraries();
     cleanup_locale();
 
@@ -314,6 +357,9 @@ static BOOL open_libraries(void)
     }
     /* Not a failure if icon.library can't be opened */
 
+    /* Open mmu.library - optional, for per-region cache modes */
+    open_mmu_library();
+
     return TRUE;
 }
 
@@ -322,6 +368,8 @@ static BOOL open_libraries(void)
  */
 static void close_libraries(void)
 {
+    close_mmu_library();
+
     if (IconBase) {
         CloseLibrary(IconBase);
         IconBase = NULL;
@@ -614,7 +662,7 @@ static void main_loop(void)
     win_signal = 1L << app->window->UserPort->mp_SigBit;
 
     while (app->running) {
-        signals = Wait(win_signal | SIGBREAKF_CTRL_C);
+        signals = Wait(win_signal | get_live_timer_signal() | SIGBREAKF_CTRL_C);
 
         /* Check for break */
         if (signals & SIGBREAKF_CTRL_C) {
@@ -622,6 +670,17 @@ static void main_loop(void)
             break;
         }
 
+        /* Live memory refresh, trace window status or CPU usage */
+        if (check_live_timer()) {
+            if (alloc_trace_active()) {
+                alloc_trace_tick();
+            } else if (cpu_sampler_active()) {
+                cpu_sampler_tick();
+            } else {
+                memory_live_tick();
+            }
+        }
+
         /* Process window messages */
         while ((msg = (struct IntuiMessage *)
                 GetMsg(app->window->UserPort)) != NULL) {
@@ -723,6 +782,57 @@ static void main_loop(void)
                                 handle_button_press(BTN_PRINT);
                             }
                             break;
+                        case 'c':
+                        case 'C':
+                            if (app->current_view == VIEW_MAIN) {
+                                switch_to_view(VIEW_CPU);
+                            }
+                            break;
+                        case 'i':
+                        case 'I':
+                            if (app->current_view == VIEW_MAIN) {
+                                enumerate_interrupts();
+                                switch_to_view(VIEW_INTERRUPTS);
+                            }
+                            break;
+                        case 'l':
+                        case 'L':
+                            if (app->current_view == VIEW_MAIN) {
+                                switch_to_view(VIEW_LATENCY);
+                            }
+                            break;
+                        case 'e':
+                        case 'E':
+                            if (app->current_view == VIEW_MAIN) {
+                                switch_to_view(VIEW_IPC);
+                            }
+                            break;
+                        case 'f':
+                        case 'F':
+                            if (app->current_view == VIEW_MAIN) {
+                                scan_library_patches();
+                                switch_to_view(VIEW_PATCHES);
+                            }
+                            break;
+                        case 'r':
+                        case 'R':
+                            if (app->current_view == VIEW_MAIN) {
+                                enumerate_residents();
+                                switch_to_view(VIEW_RESIDENTS);
+                            }
+                            break;
+                        case 'o':
+                        case 'O':
+                            if (app->current_view == VIEW_MAIN) {
+                                switch_to_view(VIEW_LOADTIME);
+                            }
+                            break;
+                        case 'a':
+                        case 'A':
+                            if (app->current_view == VIEW_MAIN) {
+                                cycle_software_sort();
+                            }
+                            break;
                     }
                     break;
 
@@ -743,10 +853,15 @@ MemoryLocation determine_mem_location(APTR addr)
 {
     ULONG address = (ULONG)addr;
 
-    /* ROM area: $F80000-$FFFFFF (256K) or $E00000-$E7FFFF (512K extended) */
-    if ((address >= 0xF80000 && address <= 0xFFFFFF) ||
-		    (address >= 0xE0000 && address < 0xE80000)) {
-        return LOC_ROM;
+    /* ROM area: $F80000-$FFFFFF (512K) or $E00000-$E7FFFF (512K extended) */
+    if ((address >= KICKSTART_ROM_BASE && address < KICKSTART_ROM_BASE + KICKSTART_ROM_SIZE) ||
+        (address >= EXTENDED_ROM_BASE && address < EXTENDED_ROM_BASE + EXTENDED_ROM_SIZE)) {
+        /* The ROM bank sweep tells whether ROM chips really serve it */
+        switch (get_rom_bank_type(address)) {
+            case ROM_BANK_SHADOWED: return LOC_SHADOWED_ROM;
+            case ROM_BANK_REMAPPED: return LOC_REMAPPED_ROM;
+            default:                return LOC_ROM;
+        }
     }
 
     /* Chip RAM: $000000-$1FFFFF (2MB max) */
@@ -775,6 +890,8 @@ const char *get_location_string(MemoryLocation loc)
         case LOC_CHIP_RAM:  return "CHIP RAM";
         case LOC_24BIT_RAM: return "24BitRAM";
         case LOC_32BIT_RAM: return "32BitRAM";
+        case LOC_SHADOWED_ROM: return "MapROM";
+        case LOC_REMAPPED_ROM: return "MMU-ROM";
         case LOC_KICKSTART:
             /* Return ROM size string (e.g., "256K" or "512K") */
             /* kickstart_size is in KB from identify.library */
@@ -20,13 +20,52 @@
 #include "gui.h"
 #include "locale_str.h"
 #include "benchmark.h"
+#include "mmu.h"
+#include "hardware.h"
+#include "boards.h"
+#include "memtest.h"
+#include "arena.h"
 
 /* Global memory region list */
 MemoryRegionList memory_regions;
 
+/* Free list copy taken under Forbid(), shared by all regions */
+static ChunkSnapshot chunk_snapshot[MAX_SNAPSHOT_CHUNKS];
+
+/* Live history ring: next slot to write and valid samples */
+static ULONG live_head = 0;
+static ULONG live_samples = 0;
+
+/* Line spacing of the memory info panel */
+#define MEMORY_ROW_HEIGHT   9
+#define MEMORY_ROW_Y(row)   (40 + (row) * MEMORY_ROW_HEIGHT)
+
+/* Rows whose values change with allocations (redrawn by live mode) */
+#define MEMORY_ROW_FIRST_FREE   7
+#define MEMORY_ROW_AMOUNT_FREE  8
+#define MEMORY_ROW_LARGEST      9
+#define MEMORY_ROW_CHUNKS       10
+
+/* Live history graph right of the values, one pixel column per sample */
+#define HISTORY_X           484
+#define HISTORY_Y           72
+#define HISTORY_HEIGHT      48
+
+/* Value area cleared before a field is redrawn */
+#define MEMORY_VALUE_X      296
+#define MEMORY_VALUE_END    (HISTORY_X - 6)
+
+/* Free map in the left column: 16x16 cells of 4x3 pixels */
+#define FRAG_MAP_X          14
+#define FRAG_MAP_Y          128
+#define FRAG_MAP_COLUMNS    16
+#define FRAG_CELL_WIDTH     4
+#define FRAG_CELL_HEIGHT    3
+
 /* External references */
 extern struct ExecBase *SysBase;
 extern AppContext *app;
+extern HardwareInfo hw_info;
 
 /*
  * Get human-readable memory type string
@@ -72,78 +111,356 @@ const char *get_memory_type_string(UWORD attrs, APTR addr)
 }
 
 /*
- * Analyze memory region - count chunks and find largest block
+ * Histogram bucket of a free chunk (floor(log2(size)) - 3)
  */
-void analyze_memory_region(struct MemHeader *mh, ULONG *chunks, ULONG *largest)
+ULONG histogram_bucket(ULONG size)
 {
-    struct MemChunk *mc;
-    ULONG count = 0;
+    ULONG bucket = 0;
+
+    size >>= 4;
+    while (size && bucket < FRAG_HISTOGRAM_BUCKETS - 1) {
+        size >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+/*
+ * Analyze memory region - go through the free list snapshot once and
+ * collect chunk count, largest block, log2 size histogram, fragmentation
+ * index and free map. Runs outside Forbid().
+ */
+void analyze_memory_region(MemoryRegion *region, const ChunkSnapshot *chunks, ULONG count)
+{
+    static ULONG cell_free[FRAG_MAP_CELLS];
     ULONG max_size = 0;
+    ULONG lower, cell_size;
+    ULONG i;
+
+    region->num_chunks = count;
+    region->largest_block = 0;
+    region->frag_index = 0;
+    memset(region->chunk_histogram, 0, sizeof(region->chunk_histogram));
+    memset(region->free_map, 0, sizeof(region->free_map));
+
+    lower = (ULONG)region->lower_bound;
+    cell_size = ((ULONG)region->upper_bound - lower + FRAG_MAP_CELLS - 1) / FRAG_MAP_CELLS;
+    if (cell_size == 0) cell_size = 1;
+    memset(cell_free, 0, sizeof(cell_free));
+
+    for (i = 0; i < count; i++) {
+        ULONG start = chunks[i].address - lower;
+        ULONG end = start + chunks[i].bytes;
+        ULONG cell;
+
+        if (chunks[i].bytes > max_size) {
+            max_size = chunks[i].bytes;
+        }
+        region->chunk_histogram[histogram_bucket(chunks[i].bytes)]++;
 
-    *chunks = 0;
-    *largest = 0;
+        /* Spread the chunk over the map cells it covers */
+        for (cell = start / cell_size;
+             cell < FRAG_MAP_CELLS && cell * cell_size < end; cell++) {
+            ULONG from = cell * cell_size;
+            ULONG to = from + cell_size;
 
-    if (!mh) return;
+            if (from < start) from = start;
+            if (to > end) to = end;
+            cell_free[cell] += to - from;
+        }
+    }
 
-    /* Walk the free list */
-    for (mc = mh->mh_First; mc != NULL; mc = mc->mc_Next) {
-        count++;
-        if (mc->mc_Bytes > max_size) {
-            max_size = mc->mc_Bytes;
+    for (i = 0; i < FRAG_MAP_CELLS; i++) {
+        if (cell_free[i] * 2 >= cell_size) {
+            region->free_map[i / 8] |= 0x80 >> (i % 8);
         }
     }
 
-    *chunks = count;
-    *largest = max_size;
+    region->largest_block = max_size;
+
+    /* Share of free memory that is not part of the largest block */
+    if (region->amount_free > 0 && max_size <= region->amount_free) {
+        region->frag_index = (UBYTE)(100 -
+            (ULONG)(((uint64_t)max_size * 100) / region->amount_free));
+    }
 }
 
 /*
- * Enumerate all memory regions
+ * Free/used state of one free map cell
  */
-void enumerate_memory_regions(void)
+BOOL region_cell_free(const MemoryRegion *region, ULONG cell)
+{
+    if (cell >= FRAG_MAP_CELLS) return FALSE;
+
+    return (region->free_map[cell / 8] & (0x80 >> (cell % 8))) != 0;
+}
+
+/*
+ * Format a power of two size ("512", "4K", "2M")
+ */
+static void format_pow2_size(ULONG bytes, char *buffer, ULONG size)
+{
+    if (bytes >= 1024 * 1024) {
+        snprintf(buffer, size, "%luM", (unsigned long)(bytes >> 20));
+    } else if (bytes >= 1024) {
+        snprintf(buffer, size, "%luK", (unsigned long)(bytes >> 10));
+    } else {
+        snprintf(buffer, size, "%lu", (unsigned long)bytes);
+    }
+}
+
+/*
+ * Format the size range of a histogram bucket
+ */
+void format_histogram_bucket(ULONG bucket, char *buffer, ULONG size)
+{
+    char from[16], to[16];
+    ULONG low = 8UL << bucket;
+
+    format_pow2_size(low, from, sizeof(from));
+    if (bucket == FRAG_HISTOGRAM_BUCKETS - 1) {
+        snprintf(buffer, size, "%s+", from);
+    } else {
+        format_pow2_size(low * 2, to, sizeof(to));
+        snprintf(buffer, size, "%s-%s", from, to);
+    }
+}
+
+/*
+ * Copy the free list of one region into the snapshot buffer
+ * Only raw fields are copied under Forbid(), the list is analyzed later.
+ * Returns the number of chunks copied.
+ */
+static ULONG snapshot_free_list(MemoryRegion *region)
 {
     struct MemHeader *mh;
+    struct MemChunk *mc;
+    ULONG count = 0;
 
-    memset(&memory_regions, 0, sizeof(memory_regions));
+    region->chunks_truncated = FALSE;
 
-    Forbid();
+    timed_forbid();
 
     for (mh = (struct MemHeader *)SysBase->MemList.lh_Head;
          (struct Node *)mh != (struct Node *)&SysBase->MemList.lh_Tail;
          mh = (struct MemHeader *)mh->mh_Node.ln_Succ) {
 
-        if (memory_regions.count >= MAX_MEMORY_REGIONS) break;
-
-        MemoryRegion *region = &memory_regions.regions[memory_regions.count];
+        if (mh->mh_Lower != region->lower_bound) continue;
 
-        region->start_address = (APTR)((ULONG)mh->mh_Lower & 0xffff8000);
-        region->end_address = mh->mh_Upper - 1;
-        region->total_size = (ULONG)(mh->mh_Upper - region->start_address);
-        region->mem_type = mh->mh_Attributes;
-        region->priority = mh->mh_Node.ln_Pri;
-        region->lower_bound = mh->mh_Lower;
-        region->upper_bound = mh->mh_Upper;
         region->first_free = mh->mh_First;
         region->amount_free = mh->mh_Free;
 
-        analyze_memory_region(mh, &region->num_chunks, &region->largest_block);
+        for (mc = mh->mh_First; mc != NULL; mc = mc->mc_Next) {
+            if (count >= MAX_SNAPSHOT_CHUNKS) {
+                region->chunks_truncated = TRUE;
+                break;
+            }
+            chunk_snapshot[count].address = (ULONG)mc;
+            chunk_snapshot[count].bytes = mc->mc_Bytes;
+            count++;
+        }
+        break;
+    }
+
+    timed_permit("memory free list");
 
-        if (mh->mh_Node.ln_Name) {
-            strncpy(region->node_name, mh->mh_Node.ln_Name,
-                    sizeof(region->node_name) - 1);
-        } else {
+    return count;
+}
+
+/*
+ * Enumerate all memory regions
+ * Phase 1 copies the MemHeader fields under Forbid(), phase 2 formats
+ * strings and snapshots/analyzes each free list separately. The region
+ * array is sized before Forbid(), allocating under it could run the
+ * low-memory handlers.
+ */
+void enumerate_memory_regions(void)
+{
+    struct MemHeader *mh;
+    ULONG headers;
+    ULONG tries;
+    ULONG i;
+
+    for (tries = 0; tries < ARENA_SNAPSHOT_RETRIES; tries++) {
+        headers = arena_count_nodes(&SysBase->MemList) + ARENA_SNAPSHOT_SLACK;
+        if (headers > MAX_MEMORY_REGIONS) headers = MAX_MEMORY_REGIONS;
+
+        /* Out of memory: only what fits is copied */
+        (void)ARENA_RESERVE_N(memory_regions.regions, 0, memory_regions.capacity, headers);
+
+        memory_regions.count = 0;
+        headers = 0;
+
+        timed_forbid();
+
+        for (mh = (struct MemHeader *)SysBase->MemList.lh_Head;
+             (struct Node *)mh != (struct Node *)&SysBase->MemList.lh_Tail;
+             mh = (struct MemHeader *)mh->mh_Node.ln_Succ) {
+
+            if (headers++ >= memory_regions.capacity ||
+                memory_regions.count >= MAX_MEMORY_REGIONS) continue;
+
+            MemoryRegion *region = &memory_regions.regions[memory_regions.count];
+            memset(region, 0, sizeof(*region));
+
+            region->mem_type = mh->mh_Attributes;
+            region->priority = mh->mh_Node.ln_Pri;
+            region->lower_bound = mh->mh_Lower;
+            region->upper_bound = mh->mh_Upper;
+
+            /* Raw bounded copy, may be unterminated until phase 2 */
+            if (mh->mh_Node.ln_Name) {
+                strncpy(region->node_name, mh->mh_Node.ln_Name,
+                        sizeof(region->node_name) - 1);
+            }
+
+            memory_regions.count++;
+        }
+
+        timed_permit("memory list");
+
+        if (headers <= memory_regions.capacity || memory_regions.count >= MAX_MEMORY_REGIONS) {
+            break;
+        }
+    }
+
+    for (i = 0; i < memory_regions.count; i++) {
+        MemoryRegion *region = &memory_regions.regions[i];
+
+        region->start_address = (APTR)((ULONG)region->lower_bound & 0xffff8000);
+        region->end_address = (APTR)((ULONG)region->upper_bound - 1);
+        region->total_size = (ULONG)region->upper_bound - (ULONG)region->start_address;
+
+        region->node_name[sizeof(region->node_name) - 1] = '\0';
+        if (region->node_name[0] == '\0') {
             strncpy(region->node_name, "(unnamed)",
                     sizeof(region->node_name) - 1);
         }
 
         strncpy(region->type_string,
-                get_memory_type_string(mh->mh_Attributes, mh->mh_Lower),
+                get_memory_type_string(region->mem_type, region->lower_bound),
                 sizeof(region->type_string) - 1);
 
-        memory_regions.count++;
+        analyze_memory_region(region, chunk_snapshot, snapshot_free_list(region));
     }
 
-    Permit();
+    query_memory_cache_modes();
+    link_memory_boards();
+}
+
+/*
+ * Match memory regions with the expansion boards that provide them
+ * CHIP RAM, motherboard and CPU slot RAM have no ConfigDev and stay
+ * unlinked.
+ */
+void link_memory_boards(void)
+{
+    ULONG i, b;
+
+    for (b = 0; b < board_list.count; b++) {
+        board_list.boards[b].memory_index = -1;
+    }
+
+    for (i = 0; i < memory_regions.count; i++) {
+        MemoryRegion *region = &memory_regions.regions[i];
+        ULONG lower = (ULONG)region->lower_bound;
+
+        region->board_index = -1;
+
+        for (b = 0; b < board_list.count; b++) {
+            BoardInfo *board = &board_list.boards[b];
+
+            if (lower >= board->board_address &&
+                lower - board->board_address < board->board_size) {
+                region->board_index = (BYTE)b;
+                if (board->memory_index < 0) {
+                    board->memory_index = (BYTE)i;
+                }
+                break;
+            }
+        }
+    }
+}
+
+/*
+ * Format the measured read speed of a region in appropriate units
+ */
+void format_region_speed(const MemoryRegion *region, char *buffer, ULONG size)
+{
+    format_speed(region->speed_measured ? region->speed_bytes_sec : 0, buffer, size);
+}
+
+/*
+ * Format a read speed in bytes/second ("---" if 0)
+ */
+void format_speed(ULONG speed, char *buffer, ULONG size)
+{
+    if (speed == 0) {
+        snprintf(buffer, size, "---");
+    } else if (speed >= 1000000) {
+        /* MB/s for fast memory */
+        snprintf(buffer, size, "%lu.%lu MB/s",
+                 (unsigned long)(speed / 1000000),
+                 (unsigned long)((speed % 1000000) / 100000));
+    } else if (speed >= 10000) {
+        /* KB/s */
+        snprintf(buffer, size, "%lu.%lu KB/s",
+                 (unsigned long)(speed / 1000),
+                 (unsigned long)((speed % 1000) / 100));
+    } else {
+        /* Bytes/s for very slow memory */
+        snprintf(buffer, size, "%lu B/s", (unsigned long)speed);
+    }
+}
+
+/*
+ * Format the board providing a region: product and Zorro type
+ */
+void format_region_board(const MemoryRegion *region, char *buffer, ULONG size)
+{
+    const BoardInfo *board;
+
+    if (region->board_index < 0) {
+        snprintf(buffer, size, "%s", get_string(MSG_MEMORY_NO_BOARD));
+        return;
+    }
+
+    board = &board_list.boards[region->board_index];
+    snprintf(buffer, size, "%.24s (%s)", board->product_name,
+             get_board_type_string(board->board_type));
+}
+
+/*
+ * Query MMU cache mode, page size and remapping of all regions
+ */
+void query_memory_cache_modes(void)
+{
+    MMURangeInfo info;
+    ULONG i;
+
+    for (i = 0; i < memory_regions.count; i++) {
+        MemoryRegion *region = &memory_regions.regions[i];
+
+        mmu_query_range((ULONG)region->lower_bound,
+                        (ULONG)region->upper_bound, &info);
+
+        region->cache_mode = (UBYTE)info.cache_mode;
+        region->cache_mixed = info.mixed;
+        region->remapped = info.remapped;
+        region->page_size = info.page_size;
+    }
+}
+
+/*
+ * Check for FAST RAM that is mapped cache inhibited
+ */
+BOOL region_is_uncached_fast(const MemoryRegion *region)
+{
+    if (region->mem_type & MEMF_CHIP) return FALSE;
+
+    return region->cache_mode == CACHE_MODE_INHIBITED ||
+           region->cache_mode == CACHE_MODE_IMPRECISE;
 }
 
 /*
@@ -151,28 +468,78 @@ void enumerate_memory_regions(void)
  */
 void refresh_memory_region(ULONG index)
 {
-    struct MemHeader *mh;
-    ULONG i = 0;
+    MemoryRegion *region;
 
     if (index >= memory_regions.count) return;
 
+    region = &memory_regions.regions[index];
+    analyze_memory_region(region, chunk_snapshot, snapshot_free_list(region));
+}
+
+/*
+ * Refresh a region and return its free list snapshot
+ * The snapshot is shared and only valid until the next refresh.
+ */
+const ChunkSnapshot *get_region_free_chunks(ULONG index, ULONG *count)
+{
+    MemoryRegion *region;
+
+    *count = 0;
+    if (index >= memory_regions.count) return NULL;
+
+    region = &memory_regions.regions[index];
+    *count = snapshot_free_list(region);
+    analyze_memory_region(region, chunk_snapshot, *count);
+
+    return chunk_snapshot;
+}
+
+/*
+ * Re-sync the region list with SysBase->MemList after MemHeaders were
+ * re-enqueued. Keeps all measured data, only order and priority change.
+ * Regions are swapped into place, regions no longer in the list end up
+ * behind count and are dropped.
+ */
+void reorder_memory_regions(void)
+{
+    UBYTE order[MAX_MEMORY_REGIONS];
+    MemoryRegion temp;
+    struct MemHeader *mh;
+    ULONG i, j, count = 0;
+
     Forbid();
 
     for (mh = (struct MemHeader *)SysBase->MemList.lh_Head;
          (struct Node *)mh != (struct Node *)&SysBase->MemList.lh_Tail;
          mh = (struct MemHeader *)mh->mh_Node.ln_Succ) {
 
-        if (i == index) {
-            MemoryRegion *region = &memory_regions.regions[index];
-            region->first_free = mh->mh_First;
-            region->amount_free = mh->mh_Free;
-            analyze_memory_region(mh, &region->num_chunks, &region->largest_block);
-            break;
+        for (i = 0; i < memory_regions.count; i++) {
+            if (memory_regions.regions[i].lower_bound == mh->mh_Lower) {
+                memory_regions.regions[i].priority = mh->mh_Node.ln_Pri;
+                order[count++] = (UBYTE)i;
+                break;
+            }
         }
-        i++;
+        if (count >= memory_regions.count) break;
     }
 
     Permit();
+
+    /* Apply the new order outside Forbid(), regions are large */
+    for (i = 0; i < count; i++) {
+        j = order[i];
+        while (j < i) j = order[j];
+        if (j != i) {
+            temp = memory_regions.regions[i];
+            memory_regions.regions[i] = memory_regions.regions[j];
+            memory_regions.regions[j] = temp;
+        }
+    }
+
+    memory_regions.count = count;
+
+    /* Boards refer to their region by index */
+    link_memory_boards();
 }
 
 /*
@@ -210,9 +577,400 @@ ULONG measure_memory_speed(ULONG index)
     region->speed_bytes_sec = bytes_per_sec;
     region->speed_measured = TRUE;
 
+    probe_memory_bus(index);
+
     return bytes_per_sec;
 }
 
+/*
+ * Minimum CPU clocks per bus cycle without wait states
+ */
+static ULONG min_bus_clocks(void)
+{
+    switch (hw_info.cpu_type) {
+        case CPU_68000:
+        case CPU_68010:
+            return 4;
+        case CPU_68020:
+        case CPU_68EC020:
+        case CPU_68030:
+        case CPU_68EC030:
+            return 3;   /* Asynchronous bus cycle */
+        default:
+            return 2;
+    }
+}
+
+/*
+ * Probe bus width and wait states of a region
+ * A port narrower than the access needs extra bus cycles, so a longword
+ * read taking about twice as long as a word read means a 16-bit port.
+ */
+void probe_memory_bus(ULONG index)
+{
+    MemoryRegion *region;
+    BusTiming timing;
+    ULONG cycle_ns;
+
+    if (index >= memory_regions.count) return;
+
+    region = &memory_regions.regions[index];
+
+    measure_bus_timing((volatile UBYTE *)(((ULONG)region->lower_bound + 3) & ~3),
+                       &timing);
+    if (timing.word_ns == 0) return;
+
+    if (timing.word_ns * 10 >= timing.byte_ns * 17) {
+        region->bus_width = 8;
+        cycle_ns = timing.byte_ns;
+    } else if (timing.long_ns * 10 >= timing.word_ns * 17) {
+        region->bus_width = 16;
+        cycle_ns = timing.word_ns;
+    } else {
+        region->bus_width = 32;
+        cycle_ns = timing.word_ns;
+    }
+
+    region->access_ns = (UWORD)(cycle_ns > 0xFFFF ? 0xFFFF : cycle_ns);
+    region->misaligned_ns = (UWORD)(timing.long_misaligned_ns > 0xFFFF ?
+                                    0xFFFF : timing.long_misaligned_ns);
+
+    /* cpu_mhz is MHz * 100 */
+    region->wait_states = WAIT_STATES_UNKNOWN;
+    if (hw_info.cpu_mhz) {
+        ULONG clocks = (cycle_ns * hw_info.cpu_mhz + 50000) / 100000;
+        ULONG min_clocks = min_bus_clocks();
+        ULONG waits = clocks > min_clocks ? clocks - min_clocks : 0;
+        region->wait_states = (UBYTE)(waits < WAIT_STATES_UNKNOWN ?
+                                      waits : WAIT_STATES_UNKNOWN - 1);
+    }
+}
+
+/*
+ * Format bus width, wait states and cycle time of a region
+ */
+void format_bus_timing(const MemoryRegion *region, char *buffer, ULONG size)
+{
+    if (region->bus_width == 0) {
+        strncpy(buffer, "---", size);
+        return;
+    }
+
+    if (region->wait_states == WAIT_STATES_UNKNOWN) {
+        snprintf(buffer, size, "%u-bit, %u ns",
+                 (unsigned)region->bus_width, (unsigned)region->access_ns);
+    } else {
+        snprintf(buffer, size, "%u-bit, %u wait state%s, %u ns",
+                 (unsigned)region->bus_width, (unsigned)region->wait_states,
+                 region->wait_states == 1 ? "" : "s",
+                 (unsigned)region->access_ns);
+    }
+}
+
+/*
+ * Format cache mode, page size and remapping of a region
+ */
+void format_cache_mode(const MemoryRegion *region, char *buffer, ULONG size)
+{
+    if (region->cache_mode == CACHE_MODE_UNKNOWN) {
+        strncpy(buffer, "---", size);
+        return;
+    }
+
+    snprintf(buffer, size, "%s", get_cache_mode_string(region->cache_mode));
+    if (region->page_size) {
+        snprintf(buffer + strlen(buffer), size - strlen(buffer),
+                 ", %luK PAGES", (unsigned long)(region->page_size / 1024));
+    }
+    if (region->cache_mixed) {
+        strncat(buffer, ", MIXED", size - strlen(buffer) - 1);
+    }
+    if (region->remapped) {
+        strncat(buffer, ", REMAPPED", size - strlen(buffer) - 1);
+    }
+}
+
+/*
+ * Short region label for tables ("2 FAST32")
+ */
+void format_region_label(ULONG index, char *buffer, ULONG size)
+{
+    const MemoryRegion *region = &memory_regions.regions[index];
+    ULONG address = (ULONG)region->lower_bound;
+    const char *type;
+
+    if (region->mem_type & MEMF_CHIP) {
+        type = "CHIP";
+    } else if (address >= 0xC00000 && address < 0xD80000) {
+        type = "SLOW";
+    } else if (region->mem_type & MEMF_FAST) {
+        type = (address < 0x01000000) ? "FAST24" : "FAST32";
+    } else {
+        type = "RAM";
+    }
+
+    snprintf(buffer, size, "%lu %s", (unsigned long)(index + 1), type);
+}
+
+/*
+ * Draw fragmentation index and free/used map of a region
+ * Cells run left to right, top to bottom in address order.
+ */
+static void draw_fragmentation_map(const MemoryRegion *region)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[16];
+    ULONG cell;
+    WORD rows = FRAG_MAP_CELLS / FRAG_MAP_COLUMNS;
+
+    snprintf(buffer, sizeof(buffer), "%s %u%%",
+             get_string(MSG_FRAGMENTATION), (unsigned)region->frag_index);
+    SetAPen(rp, COLOR_PANEL_BG);
+    RectFill(rp, FRAG_MAP_X, FRAG_MAP_Y - 13,
+             FRAG_MAP_X + FRAG_MAP_COLUMNS * FRAG_CELL_WIDTH + 4, FRAG_MAP_Y - 4);
+    draw_text(FRAG_MAP_X, FRAG_MAP_Y - 6, buffer, COLOR_TEXT);
+
+    draw_3d_box(FRAG_MAP_X - 2, FRAG_MAP_Y - 2,
+                FRAG_MAP_COLUMNS * FRAG_CELL_WIDTH + 4,
+                rows * FRAG_CELL_HEIGHT + 4, TRUE);
+
+    for (cell = 0; cell < FRAG_MAP_CELLS; cell++) {
+        WORD x = FRAG_MAP_X + (cell % FRAG_MAP_COLUMNS) * FRAG_CELL_WIDTH;
+        WORD y = FRAG_MAP_Y + (cell / FRAG_MAP_COLUMNS) * FRAG_CELL_HEIGHT;
+
+        SetAPen(rp, region_cell_free(region, cell) ? COLOR_HIGHLIGHT : COLOR_BAR_FILL);
+        RectFill(rp, x, y, x + FRAG_CELL_WIDTH - 1, y + FRAG_CELL_HEIGHT - 1);
+    }
+}
+
+/*
+ * Draw one of the free list value rows
+ * The old value is cleared first since it may be longer than the new one.
+ */
+static void draw_memory_field(ULONG row, const MemoryRegion *region)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[32];
+    LocaleStringID label;
+    WORD y = MEMORY_ROW_Y(row);
+
+    switch (row) {
+        case MEMORY_ROW_FIRST_FREE:
+            snprintf(buffer, sizeof(buffer), "$%08lX", (unsigned long)region->first_free);
+            label = MSG_FIRST_ADDRESS;
+            break;
+
+        case MEMORY_ROW_AMOUNT_FREE:
+            snprintf(buffer, sizeof(buffer), "%lu Bytes", (unsigned long)region->amount_free);
+            label = MSG_AMOUNT_FREE;
+            break;
+
+        case MEMORY_ROW_LARGEST:
+            snprintf(buffer, sizeof(buffer), "%lu Bytes", (unsigned long)region->largest_block);
+            label = MSG_LARGEST_BLOCK;
+            break;
+
+        case MEMORY_ROW_CHUNKS:
+            snprintf(buffer, sizeof(buffer), "%lu%s", (unsigned long)region->num_chunks,
+                     region->chunks_truncated ? "+" : "");
+            label = MSG_NUM_CHUNKS;
+            break;
+
+        default:
+            return;
+    }
+
+    SetAPen(rp, COLOR_PANEL_BG);
+    RectFill(rp, MEMORY_VALUE_X, y - 7, MEMORY_VALUE_END, y + 2);
+    draw_label_value(128, y, get_string(label), buffer, 168);
+}
+
+/*
+ * Scale a live sample to 0..255 of the region size
+ */
+static UBYTE history_sample(ULONG value, ULONG total)
+{
+    ULONG unit = (total + 254) / 255;
+    ULONG sample;
+
+    if (unit == 0) return 0;
+
+    sample = value / unit;
+    return (UBYTE)(sample > 255 ? 255 : sample);
+}
+
+/*
+ * Draw one column of the history graph, newest sample at the right
+ * Free memory is a filled bar, the largest block a dot above it.
+ */
+static void draw_history_column(const MemoryRegion *region, ULONG column)
+{
+    struct RastPort *rp = app->rp;
+    ULONG age = LIVE_HISTORY - 1 - column;
+    WORD x = HISTORY_X + column;
+    WORD bottom = HISTORY_Y + HISTORY_HEIGHT - 1;
+    WORD height;
+    ULONG slot;
+
+    SetAPen(rp, COLOR_PANEL_BG);
+    RectFill(rp, x, HISTORY_Y, x, bottom);
+
+    if (age >= live_samples) return;
+
+    slot = (live_head + LIVE_HISTORY - 1 - age) % LIVE_HISTORY;
+
+    height = region->free_history[slot] * HISTORY_HEIGHT / 255;
+    if (height > 0) {
+        SetAPen(rp, COLOR_BAR_FILL);
+        RectFill(rp, x, bottom - height + 1, x, bottom);
+    }
+
+    SetAPen(rp, COLOR_BAR_YOU);
+    WritePixel(rp, x, bottom - region->largest_history[slot] * (HISTORY_HEIGHT - 1) / 255);
+}
+
+/*
+ * Draw the complete history graph of a region
+ */
+static void draw_history_graph(const MemoryRegion *region)
+{
+    ULONG column;
+
+    draw_3d_box(HISTORY_X - 2, HISTORY_Y - 2,
+                LIVE_HISTORY + 4, HISTORY_HEIGHT + 4, TRUE);
+
+    for (column = 0; column < LIVE_HISTORY; column++) {
+        draw_history_column(region, column);
+    }
+}
+
+/*
+ * Scroll the history graph by one sample and draw the newest column
+ */
+static void scroll_history_graph(const MemoryRegion *region)
+{
+    struct RastPort *rp = app->rp;
+
+    SetBPen(rp, COLOR_PANEL_BG);
+    ScrollRaster(rp, 1, 0, HISTORY_X, HISTORY_Y,
+                 HISTORY_X + LIVE_HISTORY - 1, HISTORY_Y + HISTORY_HEIGHT - 1);
+    draw_history_column(region, LIVE_HISTORY - 1);
+}
+
+/*
+ * Start or stop live refresh of the memory view
+ * History starts over with every start.
+ */
+void set_memory_live(BOOL on)
+{
+    Button *btn;
+
+    if (on == app->memory_live) return;
+
+    if (on) {
+        if (!start_live_timer(LIVE_REFRESH_VBLANKS)) return;
+        live_head = 0;
+        live_samples = 0;
+    } else {
+        stop_live_timer();
+    }
+
+    app->memory_live = on;
+
+    if (app->current_view != VIEW_MEMORY) return;
+
+    btn = find_button(BTN_MEM_LIVE);
+    if (btn) {
+        btn->label = get_string(on ? MSG_BTN_STOP : MSG_BTN_LIVE);
+        draw_button(btn);
+    }
+
+    if (on && app->memory_region_index < (LONG)memory_regions.count) {
+        draw_history_graph(&memory_regions.regions[app->memory_region_index]);
+    }
+}
+
+/*
+ * Live timer tick
+ * Only mh_Free of all headers is read under one short Forbid(); the
+ * free lists of regions whose free amount changed are re-copied and
+ * analyzed, and only the fields that differ are redrawn.
+ */
+void memory_live_tick(void)
+{
+    ULONG free_now[MAX_MEMORY_REGIONS];
+    struct MemHeader *mh;
+    MemoryRegion *shown = NULL;
+    MemoryRegion before;
+    ULONG i;
+
+    if (!app->memory_live) return;
+
+    for (i = 0; i < memory_regions.count; i++) {
+        free_now[i] = memory_regions.regions[i].amount_free;
+    }
+
+    timed_forbid();
+
+    for (mh = (struct MemHeader *)SysBase->MemList.lh_Head;
+         (struct Node *)mh != (struct Node *)&SysBase->MemList.lh_Tail;
+         mh = (struct MemHeader *)mh->mh_Node.ln_Succ) {
+
+        for (i = 0; i < memory_regions.count; i++) {
+            if (memory_regions.regions[i].lower_bound == mh->mh_Lower) {
+                free_now[i] = mh->mh_Free;
+                break;
+            }
+        }
+    }
+
+    timed_permit("live memory");
+
+    if (app->current_view == VIEW_MEMORY &&
+        app->memory_region_index < (LONG)memory_regions.count) {
+        shown = &memory_regions.regions[app->memory_region_index];
+        before = *shown;
+    }
+
+    for (i = 0; i < memory_regions.count; i++) {
+        MemoryRegion *region = &memory_regions.regions[i];
+
+        if (free_now[i] != region->amount_free) {
+            refresh_memory_region(i);
+        }
+
+        region->free_history[live_head] =
+            history_sample(region->amount_free, region->total_size);
+        region->largest_history[live_head] =
+            history_sample(region->largest_block, region->total_size);
+    }
+
+    live_head = (live_head + 1) % LIVE_HISTORY;
+    if (live_samples < LIVE_HISTORY) live_samples++;
+
+    if (!shown) return;
+
+    if (shown->first_free != before.first_free) {
+        draw_memory_field(MEMORY_ROW_FIRST_FREE, shown);
+    }
+    if (shown->amount_free != before.amount_free) {
+        draw_memory_field(MEMORY_ROW_AMOUNT_FREE, shown);
+    }
+    if (shown->largest_block != before.largest_block) {
+        draw_memory_field(MEMORY_ROW_LARGEST, shown);
+    }
+    if (shown->num_chunks != before.num_chunks ||
+        shown->chunks_truncated != before.chunks_truncated) {
+        draw_memory_field(MEMORY_ROW_CHUNKS, shown);
+    }
+    if (shown->frag_index != before.frag_index ||
+        memcmp(shown->free_map, before.free_map, sizeof(shown->free_map)) != 0) {
+        draw_fragmentation_map(shown);
+    }
+
+    scroll_history_graph(shown);
+}
+
 /*
  * Draw memory view
  */
@@ -221,6 +979,7 @@ void draw_memory_view(void)
     struct RastPort *rp = app->rp;
     char buffer[64];
     WORD y;
+    ULONG row;
     MemoryRegion *region;
 
     /* Draw title panel */
@@ -238,96 +997,91 @@ void draw_memory_view(void)
     }
 
     /* Draw memory info panel */
-    draw_panel(100, 28, 520, 150, NULL);
+    draw_panel(100, 28, 520, 156, NULL);
 
     /* Refresh current region data */
     refresh_memory_region(app->memory_region_index);
     region = &memory_regions.regions[app->memory_region_index];
 
     /* Draw memory info */
-    y = 44;
+    y = 40;
 
     /* Start address */
     snprintf(buffer, sizeof(buffer), "$%08lX", (unsigned long)region->start_address);
     draw_label_value(128, y, get_string(MSG_START_ADDRESS), buffer, 168);
-    y += 10;
+    y += MEMORY_ROW_HEIGHT;
 
     /* End address */
     snprintf(buffer, sizeof(buffer), "$%08lX", (unsigned long)region->end_address);
     draw_label_value(128, y, get_string(MSG_END_ADDRESS), buffer, 168);
-    y += 10;
+    y += MEMORY_ROW_HEIGHT;
 
     /* Total size */
     format_size(region->total_size, buffer, sizeof(buffer));
     draw_label_value(128, y, get_string(MSG_TOTAL_SIZE), buffer, 168);
-    y += 10;
+    y += MEMORY_ROW_HEIGHT;
 
     /* Memory type */
     draw_label_value(128, y, get_string(MSG_MEMORY_TYPE), region->type_string, 168);
-    y += 10;
+    y += MEMORY_ROW_HEIGHT;
 
     /* Priority */
     snprintf(buffer, sizeof(buffer), "%d", region->priority);
     draw_label_value(128, y, get_string(MSG_PRIORITY), buffer, 168);
-    y += 10;
+    y += MEMORY_ROW_HEIGHT;
 
     /* Lower bound */
     snprintf(buffer, sizeof(buffer), "$%08lX", (unsigned long)region->lower_bound);
     draw_label_value(128, y, get_string(MSG_LOWER_BOUND), buffer, 168);
-    y += 10;
+    y += MEMORY_ROW_HEIGHT;
 
     /* Upper bound */
     snprintf(buffer, sizeof(buffer), "$%08lX", (unsigned long)region->upper_bound);
     draw_label_value(128, y, get_string(MSG_UPPER_BOUND), buffer, 168);
-    y += 10;
+    y += MEMORY_ROW_HEIGHT;
 
-    /* First free address */
-    snprintf(buffer, sizeof(buffer), "$%08lX", (unsigned long)region->first_free);
-    draw_label_value(128, y, get_string(MSG_FIRST_ADDRESS), buffer, 168);
-    y += 10;
+    /* First free address, amount free, largest block, number of chunks */
+    for (row = MEMORY_ROW_FIRST_FREE; row <= MEMORY_ROW_CHUNKS; row++) {
+        draw_memory_field(row, region);
+    }
+    y = MEMORY_ROW_Y(MEMORY_ROW_CHUNKS + 1);
 
-    /* Amount free */
-    snprintf(buffer, sizeof(buffer), "%lu Bytes", (unsigned long)region->amount_free);
-    draw_label_value(128, y, get_string(MSG_AMOUNT_FREE), buffer, 168);
-    y += 10;
+    /* Node name */
+    draw_label_value(128, y, get_string(MSG_NODE_NAME), region->node_name, 168);
+    y += MEMORY_ROW_HEIGHT;
 
-    /* Largest block */
-    snprintf(buffer, sizeof(buffer), "%lu Bytes", (unsigned long)region->largest_block);
-    draw_label_value(128, y, get_string(MSG_LARGEST_BLOCK), buffer, 168);
-    y += 10;
+    /* Memory speed */
+    format_region_speed(region, buffer, sizeof(buffer));
+    draw_label_value(128, y, get_string(MSG_MEMORY_SPEED), buffer, 168);
 
-    /* Number of chunks */
-    snprintf(buffer, sizeof(buffer), "%lu", (unsigned long)region->num_chunks);
-    draw_label_value(128, y, get_string(MSG_NUM_CHUNKS), buffer, 168);
-    y += 10;
+    /* Warn about FAST RAM that the MMU maps cache inhibited */
+    if (region_is_uncached_fast(region)) {
+        draw_text(296 + (strlen(buffer) + 2) * 8, y,
+                  get_string(MSG_UNCACHED_FAST_WARNING), COLOR_BAR_YOU);
+    }
+    y += MEMORY_ROW_HEIGHT;
 
-    /* Node name */
-    draw_label_value(128, y, get_string(MSG_NODE_NAME), region->node_name, 168);
-    y += 10;
-
-    /* Memory speed - display in appropriate units */
-    if (region->speed_measured) {
-        ULONG speed = region->speed_bytes_sec;
-        if (speed >= 1000000) {
-            /* MB/s for fast memory */
-            snprintf(buffer, sizeof(buffer), "%lu.%lu MB/s",
-                     (unsigned long)(speed / 1000000),
-                     (unsigned long)((speed % 1000000) / 100000));
-        } else if (speed >= 10000) {
-            /* KB/s */
-            snprintf(buffer, sizeof(buffer), "%lu.%lu KB/s",
-                     (unsigned long)(speed / 1000),
-                     (unsigned long)((speed % 1000) / 100));
-        } else if (speed > 0) {
-            /* Bytes/s for very slow memory */
-            snprintf(buffer, sizeof(buffer), "%lu B/s", (unsigned long)speed);
-        } else {
-            strncpy(buffer, "---", sizeof(buffer));
-        }
-    } else {
-        strncpy(buffer, "---", sizeof(buffer));
+    /* Cache mode, page size and remapping from mmu.library */
+    format_cache_mode(region, buffer, sizeof(buffer));
+    draw_label_value(128, y, get_string(MSG_CACHE_MODE), buffer, 168);
+    y += MEMORY_ROW_HEIGHT;
+
+    /* Bus width and wait states (probed with the speed test) */
+    format_bus_timing(region, buffer, sizeof(buffer));
+    draw_label_value(128, y, get_string(MSG_BUS_WIDTH), buffer, 168);
+    y += MEMORY_ROW_HEIGHT;
+
+    /* Expansion board providing the region */
+    format_region_board(region, buffer, sizeof(buffer));
+    draw_label_value(128, y, get_string(MSG_MEMORY_BOARD), buffer, 168);
+
+    /* Free chunk layout of the region */
+    draw_fragmentation_map(region);
+
+    /* Free/largest history while live mode runs (or after it ran) */
+    if (app->memory_live || live_samples > 0) {
+        draw_history_graph(region);
     }
-    draw_label_value(128, y, get_string(MSG_MEMORY_SPEED), buffer, 168);
 
     /* Draw navigation buttons */
     Button *btn;
@@ -341,6 +1095,20 @@ void draw_memory_view(void)
     if (btn) draw_button(btn);
     btn = find_button(BTN_MEM_EXIT);
     if (btn) draw_button(btn);
+
+    /* Draw tool buttons */
+    btn = find_button(BTN_MEM_COPY);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_MEM_PRIORITY);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_MEM_LIVE);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_MEM_ALLOC);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_MEM_TRACE);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_MEM_TEST);
+    if (btn) draw_button(btn);
 }
 
 /*
@@ -363,6 +1131,21 @@ void memory_view_update_buttons(void)
                get_string(MSG_BTN_SPEED), BTN_MEM_SPEED, TRUE);
     add_button(340, 188, 52, 12,
                get_string(MSG_BTN_EXIT), BTN_MEM_EXIT, TRUE);
+
+    /* Tool buttons */
+    add_button(14, 28, 70, 12,
+               get_string(MSG_BTN_COPY), BTN_MEM_COPY, memory_regions.count > 0);
+    add_button(14, 42, 70, 12,
+               get_string(MSG_BTN_PRIORITY), BTN_MEM_PRIORITY, memory_regions.count > 0);
+    add_button(14, 56, 70, 12,
+               get_string(app->memory_live ? MSG_BTN_STOP : MSG_BTN_LIVE),
+               BTN_MEM_LIVE, memory_regions.count > 0);
+    add_button(14, 70, 70, 12,
+               get_string(MSG_BTN_ALLOC), BTN_MEM_ALLOC, memory_regions.count > 0);
+    add_button(14, 84, 70, 12,
+               get_string(MSG_BTN_TRACE), BTN_MEM_TRACE, TRUE);
+    add_button(14, 98, 70, 12,
+               get_string(MSG_BTN_TEST), BTN_MEM_TEST, memory_regions.count > 0);
 }
 
 /*
@@ -398,6 +1181,31 @@ void memory_view_handle_button(ButtonID id)
             switch_to_view(VIEW_MAIN);
             break;
 
+        case BTN_MEM_COPY:
+            switch_to_view(VIEW_COPY);
+            break;
+
+        case BTN_MEM_PRIORITY:
+            switch_to_view(VIEW_PRIORITY);
+            break;
+
+        case BTN_MEM_LIVE:
+            set_memory_live(!app->memory_live);
+            break;
+
+        case BTN_MEM_ALLOC:
+            switch_to_view(VIEW_ALLOC);
+            break;
+
+        case BTN_MEM_TRACE:
+            switch_to_view(VIEW_TRACE);
+            break;
+
+        case BTN_MEM_TEST:
+            memtest_select_region(app->memory_region_index);
+            switch_to_view(VIEW_MEMTEST);
+            break;
+
         default:
             break;
     }
@@ -10,9 +10,34 @@
 
 #include "xsysinfo.h"
 
-/* Maximum memory regions we'll track */
+/* Maximum memory regions we'll track
+ * Stays a fixed cap while the region list grows in the arena: it sizes
+ * the stack arrays of the live view and the reordering, which walk the
+ * headers under Forbid() where nothing may be allocated, and the
+ * priority advice. Exec keeps one MemHeader per board, 32 is far above
+ * real machines. */
 #define MAX_MEMORY_REGIONS  32
 
+/* Free chunk histogram: bucket n counts chunks of 2^(n+3) to 2^(n+4)-1 bytes,
+ * the last bucket everything larger */
+#define FRAG_HISTOGRAM_BUCKETS  24
+
+/* Free/used map of a region, one bit per cell */
+#define FRAG_MAP_CELLS          256
+
+/* Free chunks copied per region under Forbid() (longer lists are cut) */
+#define MAX_SNAPSHOT_CHUNKS     4096
+
+/* Live mode: refresh interval and history samples kept per region */
+#define LIVE_REFRESH_VBLANKS    25
+#define LIVE_HISTORY            128
+
+/* Raw copy of a free chunk */
+typedef struct {
+    ULONG address;
+    ULONG bytes;
+} ChunkSnapshot;
+
 /* Memory region information */
 typedef struct {
     APTR start_address;
@@ -26,16 +51,35 @@ typedef struct {
     ULONG amount_free;
     ULONG largest_block;
     ULONG num_chunks;
+    BOOL chunks_truncated;  /* Free list longer than MAX_SNAPSHOT_CHUNKS */
     char node_name[64];
     char type_string[64];   /* Human-readable type */
     ULONG speed_bytes_sec;  /* Read speed in bytes/second */
     BOOL speed_measured;    /* TRUE if speed test has been run */
+    UBYTE cache_mode;       /* CacheMode from mmu.library */
+    BOOL cache_mixed;       /* TRUE if pages differ in cache mode */
+    BOOL remapped;          /* TRUE if MMU remaps (part of) the region */
+    ULONG page_size;        /* MMU page size, 0 if unknown */
+    UBYTE bus_width;        /* Effective data bus width in bits, 0 if not probed */
+    UBYTE wait_states;      /* Estimated wait states, WAIT_STATES_UNKNOWN if n/a */
+    UWORD access_ns;        /* Aligned single bus cycle time */
+    UWORD misaligned_ns;    /* Misaligned longword access time, 0 if n/a */
+    BYTE board_index;       /* Expansion board providing the region, -1 if none */
+    ULONG chunk_histogram[FRAG_HISTOGRAM_BUCKETS];  /* Free chunks by log2 size */
+    UBYTE frag_index;       /* 0% = all free memory in one block, up to 100% */
+    UBYTE free_map[FRAG_MAP_CELLS / 8];   /* Set bit = cell at least half free */
+    UBYTE free_history[LIVE_HISTORY];     /* Live samples, 255 = total_size */
+    UBYTE largest_history[LIVE_HISTORY];
 } MemoryRegion;
 
-/* Memory region list */
+/* Wait states could not be estimated (unknown CPU clock) */
+#define WAIT_STATES_UNKNOWN 0xFF
+
+/* Memory region list, grown in the arena */
 typedef struct {
-    MemoryRegion regions[MAX_MEMORY_REGIONS];
+    MemoryRegion *regions;
     ULONG count;
+    ULONG capacity;
 } MemoryRegionList;
 
 /* Global memory region list */
@@ -45,15 +89,66 @@ extern MemoryRegionList memory_regions;
 void enumerate_memory_regions(void);
 void refresh_memory_region(ULONG index);
 
+/* Refresh a region and return its free list snapshot (valid until the next refresh) */
+const ChunkSnapshot *get_region_free_chunks(ULONG index, ULONG *count);
+
+/* Re-sync region order and priorities with SysBase->MemList */
+void reorder_memory_regions(void);
+
 /* Get memory type as string */
 const char *get_memory_type_string(UWORD attrs, APTR addr);
 
-/* Count free chunks and find largest block in a memory region */
-void analyze_memory_region(struct MemHeader *mh, ULONG *chunks, ULONG *largest);
+/* Analyze a free list snapshot: chunk count, largest block, histogram and free map */
+void analyze_memory_region(MemoryRegion *region, const ChunkSnapshot *chunks, ULONG count);
+
+/* Free/used state of one free map cell */
+BOOL region_cell_free(const MemoryRegion *region, ULONG cell);
+
+/* Histogram bucket of a block size */
+ULONG histogram_bucket(ULONG size);
+
+/* Format the size range of a histogram bucket ("4K-8K") */
+void format_histogram_bucket(ULONG bucket, char *buffer, ULONG size);
+
+/* Query MMU cache mode of all regions */
+void query_memory_cache_modes(void);
+
+/* Match regions with the expansion boards that provide them */
+void link_memory_boards(void);
+
+/* Format the board providing a region ("Product (Zorro II)") */
+void format_region_board(const MemoryRegion *region, char *buffer, ULONG size);
+
+/* Format the measured read speed of a region ("---" if not measured) */
+void format_region_speed(const MemoryRegion *region, char *buffer, ULONG size);
+
+/* Format a read speed in bytes/second ("---" if 0) */
+void format_speed(ULONG speed, char *buffer, ULONG size);
+
+/* TRUE if a FAST RAM region is mapped cache inhibited */
+BOOL region_is_uncached_fast(const MemoryRegion *region);
+
+/* Format cache mode, page size and remapping of a region */
+void format_cache_mode(const MemoryRegion *region, char *buffer, ULONG size);
+
+/* Short region label for tables ("2 FAST32") */
+void format_region_label(ULONG index, char *buffer, ULONG size);
 
 /* Measure memory read speed for a region (returns bytes/second) */
 ULONG measure_memory_speed(ULONG index);
 
+/* Probe bus width and wait states of a region */
+void probe_memory_bus(ULONG index);
+
+/* Format bus width, wait states and cycle time of a region */
+void format_bus_timing(const MemoryRegion *region, char *buffer, ULONG size);
+
+/* Start or stop live refresh of the memory view */
+void set_memory_live(BOOL on);
+
+/* Live timer tick: sample all regions, redraw changed fields */
+void memory_live_tick(void);
+
 /* Draw memory view */
 void draw_memory_view(void);
 
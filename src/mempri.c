@@ -0,0 +1,471 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Memory priority advisor
+ *
+ * exec hands out memory from the highest priority MemHeader first, so a
+ * slow Zorro II or trapdoor board that outranks 32-bit local RAM costs
+ * every program some speed. The advisor proposes priorities ordered by
+ * measured read speed and can apply them or write a boot script.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <exec/execbase.h>
+#include <exec/memory.h>
+#include <dos/dos.h>
+
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/graphics.h>
+
+#include "xsysinfo.h"
+#include "mempri.h"
+#include "memory.h"
+#include "bandwidth.h"
+#include "gui.h"
+#include "print.h"
+#include "locale_str.h"
+#include "debug.h"
+
+/* Global priority advice */
+PriorityAdvice priority_advice;
+
+/* Column positions of the advisor table */
+#define MEMPRI_COL_REGION   28
+#define MEMPRI_COL_ADDRESS  120
+#define MEMPRI_COL_SPEED    240
+#define MEMPRI_COL_CURRENT  360
+#define MEMPRI_COL_PROPOSED 456
+
+/* External references */
+extern struct ExecBase *SysBase;
+extern AppContext *app;
+
+/*
+ * Find the MemHeader containing an address
+ * Must be called under Forbid().
+ */
+static struct MemHeader *find_mem_header(ULONG address)
+{
+    struct MemHeader *mh;
+
+    for (mh = (struct MemHeader *)SysBase->MemList.lh_Head;
+         (struct Node *)mh != (struct Node *)&SysBase->MemList.lh_Tail;
+         mh = (struct MemHeader *)mh->mh_Node.ln_Succ) {
+
+        if (address >= (ULONG)mh->mh_Lower && address < (ULONG)mh->mh_Upper) {
+            return mh;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Change the priority of a MemHeader and move it to its new list position
+ * Must be called under Forbid().
+ */
+static void requeue_mem_header(struct MemHeader *mh, WORD pri)
+{
+    Remove(&mh->mh_Node);
+    mh->mh_Node.ln_Pri = (BYTE)pri;
+    Enqueue(&SysBase->MemList, &mh->mh_Node);
+}
+
+/*
+ * TRUE if speed a is faster than speed b beyond the tolerance
+ */
+static BOOL clearly_faster(ULONG a, ULONG b)
+{
+    return (uint64_t)a * 100 > (uint64_t)b * (100 + MEMPRI_SPEED_TOLERANCE);
+}
+
+/*
+ * Measure all regions and propose an order by speed
+ * CHIP RAM is left alone: it is the only DMA-capable memory and should
+ * stay last no matter how fast it is.
+ */
+void build_priority_advice(void)
+{
+    PriorityEntry fast[MAX_MEMORY_REGIONS];
+    PriorityEntry chip[MAX_MEMORY_REGIONS];
+    WORD pool[MAX_MEMORY_REGIONS];
+    ULONG fast_count = 0, chip_count = 0;
+    WORD chip_max = -128;
+    ULONG i, j;
+
+    memset(&priority_advice, 0, sizeof(priority_advice));
+
+    for (i = 0; i < memory_regions.count; i++) {
+        MemoryRegion *region = &memory_regions.regions[i];
+        PriorityEntry *e;
+
+        if (!region->speed_measured) {
+            measure_memory_speed(i);
+        }
+
+        if (region->mem_type & MEMF_CHIP) {
+            e = &chip[chip_count++];
+            if (region->priority > chip_max) chip_max = region->priority;
+        } else {
+            e = &fast[fast_count++];
+        }
+
+        e->region = i;
+        e->speed = region->speed_bytes_sec;
+        e->current_pri = region->priority;
+        e->proposed_pri = region->priority;
+    }
+
+    /* Stable insertion sort by speed, near-equal speeds keep their order */
+    for (i = 1; i < fast_count; i++) {
+        PriorityEntry tmp = fast[i];
+
+        for (j = i; j > 0 && clearly_faster(tmp.speed, fast[j - 1].speed); j--) {
+            fast[j] = fast[j - 1];
+        }
+        fast[j] = tmp;
+    }
+
+    /* Hand out the existing priorities, highest first */
+    for (i = 0; i < fast_count; i++) {
+        pool[i] = fast[i].current_pri;
+    }
+    for (i = 1; i < fast_count; i++) {
+        WORD tmp = pool[i];
+
+        for (j = i; j > 0 && tmp > pool[j - 1]; j--) {
+            pool[j] = pool[j - 1];
+        }
+        pool[j] = tmp;
+    }
+
+    for (i = 0; i < fast_count; i++) {
+        WORD pri = pool[i];
+
+        /* Strictly lower than a clearly faster predecessor */
+        if (i > 0) {
+            WORD limit = fast[i - 1].proposed_pri;
+            if (clearly_faster(fast[i - 1].speed, fast[i].speed)) limit--;
+            if (pri > limit) pri = limit;
+        }
+        fast[i].proposed_pri = pri;
+    }
+
+    /* Keep every non-CHIP region above CHIP RAM */
+    if (fast_count > 0 && chip_count > 0 &&
+        fast[fast_count - 1].proposed_pri <= chip_max) {
+        WORD shift = chip_max + 1 - fast[fast_count - 1].proposed_pri;
+
+        for (i = 0; i < fast_count; i++) {
+            fast[i].proposed_pri += shift;
+            if (fast[i].proposed_pri > 127) fast[i].proposed_pri = 127;
+        }
+    }
+
+    for (i = 0; i < fast_count; i++) {
+        priority_advice.entries[priority_advice.count++] = fast[i];
+        if (fast[i].proposed_pri != fast[i].current_pri) {
+            priority_advice.changes = TRUE;
+        }
+    }
+    for (i = 0; i < chip_count; i++) {
+        priority_advice.entries[priority_advice.count++] = chip[i];
+    }
+
+    priority_advice.valid = TRUE;
+}
+
+/*
+ * Re-enqueue the MemHeaders with the proposed priorities
+ */
+void apply_priority_advice(void)
+{
+    ULONG i;
+
+    if (!priority_advice.valid || !priority_advice.changes) return;
+
+    Forbid();
+
+    for (i = 0; i < priority_advice.count; i++) {
+        PriorityEntry *e = &priority_advice.entries[i];
+        MemoryRegion *region = &memory_regions.regions[e->region];
+        struct MemHeader *mh;
+
+        if (e->proposed_pri == e->current_pri) continue;
+
+        mh = find_mem_header((ULONG)region->lower_bound);
+        if (mh) {
+            requeue_mem_header(mh, e->proposed_pri);
+        }
+    }
+
+    Permit();
+
+    debug("  mempri: applied new memory priorities\n");
+
+    /* Region indices follow the list order and have changed */
+    reorder_memory_regions();
+    copy_matrix.valid = FALSE;
+
+    build_priority_advice();
+}
+
+/*
+ * Write a script that restores the proposed priorities at boot
+ */
+BOOL write_priority_script(const char *filename)
+{
+    BPTR fh;
+    char line[128];
+    char label[16];
+    char speed_str[16];
+    ULONG i;
+
+    if (!priority_advice.valid) return FALSE;
+
+    fh = Open((STRPTR)filename, MODE_NEWFILE);
+    if (!fh) return FALSE;
+
+    FPuts(fh, (STRPTR)"; Memory priorities proposed by " XSYSINFO_NAME " " XSYSINFO_VERSION "\n");
+    FPuts(fh, (STRPTR)"; Run from S:User-Startup to apply them at boot.\n;\n");
+
+    for (i = 0; i < priority_advice.count; i++) {
+        PriorityEntry *e = &priority_advice.entries[i];
+        MemoryRegion *region = &memory_regions.regions[e->region];
+
+        format_region_label(e->region, label, sizeof(label));
+        format_scaled(speed_str, sizeof(speed_str), e->speed / 10000, TRUE);
+        snprintf(line, sizeof(line), ";   %-10s $%08lX  %8s MB/s  %4d -> %d\n",
+                 label, (unsigned long)region->lower_bound, speed_str,
+                 e->current_pri, e->proposed_pri);
+        FPuts(fh, (STRPTR)line);
+    }
+
+    FPuts(fh, (STRPTR)";\n" XSYSINFO_NAME " MEMPRI=");
+    for (i = 0; i < priority_advice.count; i++) {
+        PriorityEntry *e = &priority_advice.entries[i];
+        MemoryRegion *region = &memory_regions.regions[e->region];
+
+        snprintf(line, sizeof(line), "%s$%08lX:%d", i > 0 ? "," : "",
+                 (unsigned long)region->lower_bound, e->proposed_pri);
+        FPuts(fh, (STRPTR)line);
+    }
+    FPuts(fh, (STRPTR)"\n");
+
+    Close(fh);
+
+    return TRUE;
+}
+
+/*
+ * Parse one "$address:pri" entry of a MEMPRI argument
+ */
+static BOOL parse_priority_entry(const char **spec, ULONG *address, LONG *pri)
+{
+    const char *p = *spec;
+    char *end;
+
+    if (*p == '$') p++;
+
+    *address = strtoul(p, &end, 16);
+    if (end == p || *end != ':') return FALSE;
+    p = end + 1;
+
+    *pri = strtol(p, &end, 10);
+    if (end == p || *pri < -128 || *pri > 127) return FALSE;
+    p = end;
+
+    if (*p == ',') {
+        p++;
+    } else if (*p != '\0') {
+        return FALSE;
+    }
+
+    *spec = p;
+    return TRUE;
+}
+
+/*
+ * Apply a MEMPRI argument ("$address:pri,...")
+ * The whole argument is checked before anything is changed.
+ * Returns the number of regions changed, -1 on a syntax error.
+ */
+LONG apply_memory_priorities(const char *spec)
+{
+    const char *p;
+    ULONG address;
+    LONG pri;
+    LONG changed = 0;
+
+    for (p = spec; *p; ) {
+        if (!parse_priority_entry(&p, &address, &pri)) return -1;
+    }
+
+    for (p = spec; *p; ) {
+        struct MemHeader *mh;
+
+        parse_priority_entry(&p, &address, &pri);
+
+        Forbid();
+        mh = find_mem_header(address);
+        if (mh && mh->mh_Node.ln_Pri != pri) {
+            requeue_mem_header(mh, (WORD)pri);
+            changed++;
+        }
+        Permit();
+    }
+
+    return changed;
+}
+
+/*
+ * Draw priority advisor view
+ */
+void draw_priority_view(void)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[32];
+    ULONG i;
+    WORD y;
+    Button *btn;
+
+    /* Draw title panel */
+    draw_panel(20, 0, 600, 24, NULL);
+
+    SetAPen(rp, COLOR_TEXT);
+    SetBPen(rp, COLOR_PANEL_BG);
+    Move(rp, 220, 14);
+    Text(rp, (CONST_STRPTR)get_string(MSG_PRIORITY_ADVISOR),
+         strlen(get_string(MSG_PRIORITY_ADVISOR)));
+
+    /* Draw column headers */
+    y = 40;
+    SetAPen(rp, COLOR_TEXT);
+
+    TightText(rp, MEMPRI_COL_REGION, y, (CONST_STRPTR)get_string(MSG_PRI_REGION), -1, 4);
+    TightText(rp, MEMPRI_COL_ADDRESS, y, (CONST_STRPTR)get_string(MSG_START_ADDRESS), -1, 4);
+    TightText(rp, MEMPRI_COL_SPEED, y, (CONST_STRPTR)get_string(MSG_MEMORY_SPEED), -1, 4);
+    TightText(rp, MEMPRI_COL_CURRENT, y, (CONST_STRPTR)get_string(MSG_PRI_CURRENT), -1, 4);
+    TightText(rp, MEMPRI_COL_PROPOSED, y, (CONST_STRPTR)get_string(MSG_PRI_PROPOSED), -1, 4);
+
+    /* Draw separator line */
+    SetAPen(rp, COLOR_BUTTON_DARK);
+    Move(rp, 20, y + 4);
+    Draw(rp, 628, y + 4);
+
+    if (!priority_advice.valid) {
+        draw_text(220, 100, get_string(MSG_SPEED_NOT_MEASURED), COLOR_TEXT);
+    } else {
+        /* One row per region in proposed order */
+        y = 56;
+        for (i = 0; i < priority_advice.count && y < 166; i++) {
+            PriorityEntry *e = &priority_advice.entries[i];
+            MemoryRegion *region = &memory_regions.regions[e->region];
+
+            format_region_label(e->region, buffer, sizeof(buffer));
+            draw_text(MEMPRI_COL_REGION, y, buffer, COLOR_HIGHLIGHT);
+
+            snprintf(buffer, sizeof(buffer), "$%08lX", (unsigned long)region->lower_bound);
+            draw_text(MEMPRI_COL_ADDRESS, y, buffer, COLOR_HIGHLIGHT);
+
+            format_copy_speed(e->speed, buffer, sizeof(buffer));
+            strncat(buffer, " MB/s", sizeof(buffer) - strlen(buffer) - 1);
+            draw_text(MEMPRI_COL_SPEED, y, buffer, COLOR_HIGHLIGHT);
+
+            snprintf(buffer, sizeof(buffer), "%d", e->current_pri);
+            draw_text(MEMPRI_COL_CURRENT, y, buffer, COLOR_HIGHLIGHT);
+
+            /* Changed priorities stand out in red */
+            snprintf(buffer, sizeof(buffer), "%d", e->proposed_pri);
+            draw_text(MEMPRI_COL_PROPOSED, y, buffer,
+                      e->proposed_pri != e->current_pri ? COLOR_BAR_YOU : COLOR_HIGHLIGHT);
+
+            y += 10;
+        }
+
+        draw_text(MEMPRI_COL_REGION, 176,
+                  get_string(priority_advice.changes ? MSG_PRI_CHIP_KEPT : MSG_PRI_OPTIMAL),
+                  COLOR_TEXT);
+    }
+
+    /* Draw buttons */
+    btn = find_button(BTN_PRI_EXIT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_PRI_SPEED);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_PRI_APPLY);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_PRI_SCRIPT);
+    if (btn) draw_button(btn);
+}
+
+/*
+ * Update buttons for priority advisor view
+ */
+void priority_view_update_buttons(void)
+{
+    add_button(20, 188, 60, 12,
+               get_string(MSG_BTN_EXIT), BTN_PRI_EXIT, TRUE);
+    add_button(100, 188, 60, 12,
+               get_string(MSG_BTN_SPEED), BTN_PRI_SPEED, TRUE);
+    add_button(180, 188, 60, 12,
+               get_string(MSG_BTN_APPLY), BTN_PRI_APPLY,
+               priority_advice.valid && priority_advice.changes);
+    add_button(260, 188, 60, 12,
+               get_string(MSG_BTN_SCRIPT), BTN_PRI_SCRIPT, priority_advice.valid);
+}
+
+/*
+ * Handle button press for priority advisor view
+ */
+void priority_view_handle_button(ButtonID id)
+{
+    switch (id) {
+        case BTN_PRI_SPEED:
+            /* Re-measure everything, not just the missing regions */
+            {
+                ULONG i;
+
+                show_status_overlay(get_string(MSG_MEASURING_SPEED));
+                for (i = 0; i < memory_regions.count; i++) {
+                    measure_memory_speed(i);
+                }
+                build_priority_advice();
+                hide_status_overlay();
+            }
+            break;
+
+        case BTN_PRI_APPLY:
+            if (show_confirm_requester(get_string(MSG_PRIORITY_ADVISOR),
+                                       get_string(MSG_PRI_CONFIRM))) {
+                apply_priority_advice();
+                redraw_current_view();
+            }
+            break;
+
+        case BTN_PRI_SCRIPT:
+            {
+                char filename[MAX_FILENAME_LEN];
+                strncpy(filename, DEFAULT_MEMPRI_SCRIPT, sizeof(filename) - 1);
+                filename[sizeof(filename) - 1] = '\0';
+
+                if (show_filename_requester(
+                        get_string(MSG_ENTER_FILENAME), filename, sizeof(filename))) {
+                    write_priority_script(filename);
+                }
+            }
+            break;
+
+        case BTN_PRI_EXIT:
+            switch_to_view(VIEW_MEMORY);
+            break;
+
+        default:
+            break;
+    }
+}
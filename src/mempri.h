@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Memory priority advisor header
+ */
+
+#ifndef MEMPRI_H
+#define MEMPRI_H
+
+#include "xsysinfo.h"
+#include "memory.h"
+
+/* Default file name for the boot script */
+#define DEFAULT_MEMPRI_SCRIPT   "RAM:SetMemPri"
+
+/* Speeds within this percentage count as equal (keeps current order) */
+#define MEMPRI_SPEED_TOLERANCE  5
+
+/* Advisor entry, one per memory region */
+typedef struct {
+    ULONG region;           /* Index into memory_regions */
+    ULONG speed;            /* Measured read speed in bytes/sec */
+    WORD current_pri;
+    WORD proposed_pri;
+} PriorityEntry;
+
+/* Proposed priority order, fastest region first */
+typedef struct {
+    PriorityEntry entries[MAX_MEMORY_REGIONS];
+    ULONG count;
+    BOOL valid;             /* TRUE once all regions are measured */
+    BOOL changes;           /* TRUE if the proposal differs from the system */
+} PriorityAdvice;
+
+/* Global priority advice */
+extern PriorityAdvice priority_advice;
+
+/* Function prototypes */
+
+/* Measure all regions and propose an order by speed */
+void build_priority_advice(void);
+
+/* Re-enqueue the MemHeaders with the proposed priorities */
+void apply_priority_advice(void);
+
+/* Write a script that restores the proposed priorities at boot */
+BOOL write_priority_script(const char *filename);
+
+/* Apply a MEMPRI argument ("$address:pri,...") - returns regions changed or -1 */
+LONG apply_memory_priorities(const char *spec);
+
+/* Draw priority advisor view */
+void draw_priority_view(void);
+
+#endif /* MEMPRI_H */
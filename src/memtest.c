@@ -0,0 +1,783 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Memory integrity tester
+ *
+ * The free chunks of one region are claimed with AllocAbs() and tested
+ * with walking ones/zeros, address-in-address and random patterns. Every
+ * pass fills all blocks before verifying any of them, so address lines
+ * that alias one part of the board onto another are caught as well.
+ * Pattern fills use movem (move16 on 68040/68060), pattern verifies
+ * movem loads, the address and random passes run in register loops.
+ * The walking patterns take 32 sub-passes each, so they dominate the
+ * run time; large boards still finish in minutes.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/execbase.h>
+#include <exec/memory.h>
+#include <dos/dos.h>
+#include <intuition/intuition.h>
+
+#include <proto/exec.h>
+#include <proto/graphics.h>
+
+#include "xsysinfo.h"
+#include "memtest.h"
+#include "memory.h"
+#include "benchmark.h"
+#include "bandwidth.h"
+#include "gui.h"
+#include "locale_str.h"
+#include "debug.h"
+
+/* Global memory test result */
+MemTestResult memtest_result;
+
+/* Longwords per pattern tile */
+#define MEMTEST_TILE_LONGS  (MEMTEST_TILE_BYTES / 4)
+
+/* Start value of the random pattern (xorshift32, never 0) */
+#define MEMTEST_SEED        0x2545F491
+
+/* View layout */
+#define MEMTEST_X           28
+#define MEMTEST_BAR_Y       62
+#define MEMTEST_BAR_WIDTH   584
+#define MEMTEST_BAR_HEIGHT  8
+#define MEMTEST_STATUS_Y    84
+#define MEMTEST_ERROR_Y     134
+#define MEMTEST_ROW_HEIGHT  10
+
+/* Claimed blocks */
+typedef struct {
+    ULONG address;
+    ULONG size;
+} MemTestBlock;
+
+static MemTestBlock memtest_blocks[MEMTEST_MAX_BLOCKS];
+static ULONG memtest_region = 0;
+
+/* Pattern tile, 16 byte aligned for move16
+ * Hunks are only loaded on 8 byte boundaries, so the tile is rounded up
+ * inside a larger buffer at runtime. */
+static ULONG memtest_tile_buffer[MEMTEST_TILE_LONGS + 3];
+static ULONG *memtest_tile;
+
+/* Progress of the running test */
+static uint64_t memtest_done;
+static uint64_t memtest_total;
+static ULONG memtest_percent;
+
+/* Pass names */
+static const LocaleStringID memtest_pass_names[MEMTEST_PASS_COUNT] = {
+    MSG_MEMTEST_WALKING_ONES,
+    MSG_MEMTEST_WALKING_ZEROS,
+    MSG_MEMTEST_ADDRESS,
+    MSG_MEMTEST_ADDRESS_INVERTED,
+    MSG_MEMTEST_RANDOM
+};
+
+/* External references */
+extern struct ExecBase *SysBase;
+extern AppContext *app;
+
+/*
+ * Get test pass name
+ */
+const char *get_memtest_pass_string(MemTestPass pass)
+{
+    if (pass >= MEMTEST_PASS_COUNT) return "---";
+    return get_string(memtest_pass_names[pass]);
+}
+
+/*
+ * Select the region tested by the memory test view
+ */
+void memtest_select_region(ULONG index)
+{
+    if (memtest_result.valid && memtest_result.region != index) {
+        memtest_result.valid = FALSE;
+    }
+    memtest_region = index;
+}
+
+/*
+ * Record a failing longword
+ */
+static void record_error(ULONG address, ULONG expected, ULONG actual, MemTestPass pass)
+{
+    if (memtest_result.error_count < MEMTEST_MAX_ERRORS) {
+        MemTestError *err = &memtest_result.errors[memtest_result.error_count];
+
+        err->address = address;
+        err->expected = expected;
+        err->actual = actual;
+        err->pass = (UBYTE)pass;
+    }
+    memtest_result.error_count++;
+}
+
+/*
+ * Fill whole tiles with the pattern tile
+ */
+static void fill_tiles(ULONG *dst, ULONG tiles, BOOL use_move16)
+{
+    const ULONG *tile = memtest_tile;
+
+    if (tiles == 0) return;
+
+    /* move16 ignores the low 4 address bits */
+    if (use_move16 && ((ULONG)dst & 15) == 0 && ((ULONG)tile & 15) == 0) {
+        /* 8x move16 (a0)+,(a1)+ per tile, hand-encoded for the 68000 build */
+        __asm__ volatile (
+            "move.l %0,%%a1\n\t"
+            "1:\n\t"
+            "move.l %2,%%a0\n\t"
+            ".rept 8\n\t"
+            ".short 0xf620,0x9000\n\t"
+            ".endr\n\t"
+            "subq.l #1,%1\n\t"
+            "bne.s 1b"
+            : "+a" (dst), "+d" (tiles)
+            : "g" (tile)
+            : "a0", "a1", "cc", "memory"
+        );
+    } else {
+        /* 4x movem.l (8 regs) = one tile per iteration */
+        __asm__ volatile (
+            "1:\n\t"
+            "move.l %2,%%a0\n\t"
+            ".rept 4\n\t"
+            "movem.l (%%a0)+,%%d1-%%d6/%%a2-%%a3\n\t"
+            "movem.l %%d1-%%d6/%%a2-%%a3,(%0)\n\t"
+            "lea 32(%0),%0\n\t"
+            ".endr\n\t"
+            "subq.l #1,%1\n\t"
+            "bne.s 1b"
+            : "+a" (dst), "+d" (tiles)
+            : "g" (tile)
+            : "d1", "d2", "d3", "d4", "d5", "d6", "a0", "a2", "a3",
+              "cc", "memory"
+        );
+    }
+}
+
+/*
+ * Compare whole tiles with the pattern tile using movem loads
+ * Returns the address behind the first mismatching 32 bytes, or NULL.
+ */
+static ULONG *compare_tiles(ULONG *src, ULONG tiles)
+{
+    const ULONG *tile = memtest_tile;
+    ULONG failed = 0;
+
+    __asm__ volatile (
+        "1:\n\t"
+        "move.l %3,%%a0\n\t"
+        ".rept 4\n\t"
+        "movem.l (%0)+,%%d1-%%d6/%%a2-%%a3\n\t"
+        "cmp.l (%%a0)+,%%d1\n\t"
+        "bne.w 2f\n\t"
+        "cmp.l (%%a0)+,%%d2\n\t"
+        "bne.w 2f\n\t"
+        "cmp.l (%%a0)+,%%d3\n\t"
+        "bne.w 2f\n\t"
+        "cmp.l (%%a0)+,%%d4\n\t"
+        "bne.w 2f\n\t"
+        "cmp.l (%%a0)+,%%d5\n\t"
+        "bne.w 2f\n\t"
+        "cmp.l (%%a0)+,%%d6\n\t"
+        "bne.w 2f\n\t"
+        "cmpa.l (%%a0)+,%%a2\n\t"
+        "bne.w 2f\n\t"
+        "cmpa.l (%%a0)+,%%a3\n\t"
+        "bne.w 2f\n\t"
+        ".endr\n\t"
+        "subq.l #1,%1\n\t"
+        "bne.w 1b\n\t"
+        "bra.s 3f\n\t"
+        "2:\n\t"
+        "moveq #1,%2\n\t"
+        "3:"
+        : "+a" (src), "+d" (tiles), "+d" (failed)
+        : "g" (tile)
+        : "d1", "d2", "d3", "d4", "d5", "d6", "a0", "a2", "a3",
+          "cc", "memory"
+    );
+
+    return failed ? src : NULL;
+}
+
+/*
+ * Verify whole tiles, locating every failing longword of a bad tile
+ */
+static void verify_tiles(ULONG *base, ULONG tiles, MemTestPass pass)
+{
+    while (tiles) {
+        ULONG *fail = compare_tiles(base, tiles);
+        volatile ULONG *p;
+        ULONG good, i;
+
+        if (!fail) break;
+
+        /* Tiles before the one holding the mismatching group are good */
+        good = (ULONG)((fail - 8) - base) / MEMTEST_TILE_LONGS;
+        p = base + good * MEMTEST_TILE_LONGS;
+
+        for (i = 0; i < MEMTEST_TILE_LONGS; i++) {
+            if (p[i] != memtest_tile[i]) {
+                record_error((ULONG)&p[i], memtest_tile[i], p[i], pass);
+            }
+        }
+
+        base += (good + 1) * MEMTEST_TILE_LONGS;
+        tiles -= good + 1;
+    }
+}
+
+/*
+ * Fill longwords with their own address, optionally inverted
+ */
+static void fill_address(ULONG *dst, ULONG longs, ULONG invert)
+{
+    if (longs == 0) return;
+
+    __asm__ volatile (
+        "1:\n\t"
+        "move.l %0,%%d1\n\t"
+        "eor.l %2,%%d1\n\t"
+        "move.l %%d1,(%0)+\n\t"
+        "subq.l #1,%1\n\t"
+        "bne.s 1b"
+        : "+a" (dst), "+d" (longs)
+        : "d" (invert)
+        : "d1", "cc", "memory"
+    );
+}
+
+/*
+ * Compare longwords with their own address, optionally inverted
+ * Returns the address behind the first mismatching longword, or NULL.
+ */
+static ULONG *compare_address(ULONG *src, ULONG longs, ULONG invert)
+{
+    ULONG failed = 0;
+
+    if (longs == 0) return NULL;
+
+    __asm__ volatile (
+        "1:\n\t"
+        "move.l %0,%%d1\n\t"
+        "eor.l %3,%%d1\n\t"
+        "cmp.l (%0)+,%%d1\n\t"
+        "bne.s 2f\n\t"
+        "subq.l #1,%1\n\t"
+        "bne.s 1b\n\t"
+        "bra.s 3f\n\t"
+        "2:\n\t"
+        "moveq #1,%2\n\t"
+        "3:"
+        : "+a" (src), "+d" (longs), "+d" (failed)
+        : "d" (invert)
+        : "d1", "cc", "memory"
+    );
+
+    return failed ? src : NULL;
+}
+
+/*
+ * Fill longwords with the random pattern (xorshift32)
+ * The state is the value of the last longword.
+ */
+static void fill_random(ULONG *dst, ULONG longs, ULONG *state)
+{
+    ULONG x = *state;
+
+    if (longs == 0) return;
+
+    __asm__ volatile (
+        "moveq #13,%%d2\n\t"
+        "moveq #17,%%d3\n\t"
+        "1:\n\t"
+        "move.l %2,%%d1\n\t"
+        "lsl.l %%d2,%%d1\n\t"
+        "eor.l %%d1,%2\n\t"
+        "move.l %2,%%d1\n\t"
+        "lsr.l %%d3,%%d1\n\t"
+        "eor.l %%d1,%2\n\t"
+        "move.l %2,%%d1\n\t"
+        "lsl.l #5,%%d1\n\t"
+        "eor.l %%d1,%2\n\t"
+        "move.l %2,(%0)+\n\t"
+        "subq.l #1,%1\n\t"
+        "bne.s 1b"
+        : "+a" (dst), "+d" (longs), "+d" (x)
+        :
+        : "d1", "d2", "d3", "cc", "memory"
+    );
+
+    *state = x;
+}
+
+/*
+ * Compare longwords with the random pattern
+ * Returns the address behind the first mismatching longword, or NULL.
+ * The state is then the value expected there.
+ */
+static ULONG *compare_random(ULONG *src, ULONG longs, ULONG *state)
+{
+    ULONG x = *state;
+    ULONG failed = 0;
+
+    if (longs == 0) return NULL;
+
+    __asm__ volatile (
+        "moveq #13,%%d2\n\t"
+        "moveq #17,%%d3\n\t"
+        "1:\n\t"
+        "move.l %3,%%d1\n\t"
+        "lsl.l %%d2,%%d1\n\t"
+        "eor.l %%d1,%3\n\t"
+        "move.l %3,%%d1\n\t"
+        "lsr.l %%d3,%%d1\n\t"
+        "eor.l %%d1,%3\n\t"
+        "move.l %3,%%d1\n\t"
+        "lsl.l #5,%%d1\n\t"
+        "eor.l %%d1,%3\n\t"
+        "cmp.l (%0)+,%3\n\t"
+        "bne.s 2f\n\t"
+        "subq.l #1,%1\n\t"
+        "bne.s 1b\n\t"
+        "bra.s 3f\n\t"
+        "2:\n\t"
+        "moveq #1,%2\n\t"
+        "3:"
+        : "+a" (src), "+d" (longs), "+d" (failed), "+d" (x)
+        :
+        : "d1", "d2", "d3", "cc", "memory"
+    );
+
+    *state = x;
+    return failed ? src : NULL;
+}
+
+/*
+ * Fill or verify one slice of a block
+ * The verify kernels stop at a mismatch, which is recorded before the
+ * rest of the slice is compared.
+ */
+static void process_slice(MemTestPass pass, BOOL verify, ULONG *start,
+                          ULONG bytes, ULONG *state, BOOL use_move16)
+{
+    ULONG *end = start + bytes / 4;
+    ULONG invert = (pass == MEMTEST_ADDRESS_INVERTED) ? 0xFFFFFFFF : 0;
+    ULONG *p = start;
+    ULONG *fail;
+
+    switch (pass) {
+        case MEMTEST_WALKING_ONES:
+        case MEMTEST_WALKING_ZEROS:
+            if (verify) {
+                verify_tiles(start, bytes / MEMTEST_TILE_BYTES, pass);
+            } else {
+                fill_tiles(start, bytes / MEMTEST_TILE_BYTES, use_move16);
+            }
+            break;
+
+        case MEMTEST_ADDRESS:
+        case MEMTEST_ADDRESS_INVERTED:
+            if (!verify) {
+                fill_address(start, bytes / 4, invert);
+                break;
+            }
+            while ((fail = compare_address(p, (ULONG)(end - p), invert)) != NULL) {
+                record_error((ULONG)(fail - 1), (ULONG)(fail - 1) ^ invert,
+                             *(volatile ULONG *)(fail - 1), pass);
+                p = fail;
+            }
+            break;
+
+        case MEMTEST_RANDOM:
+            if (!verify) {
+                fill_random(start, bytes / 4, state);
+                break;
+            }
+            while ((fail = compare_random(p, (ULONG)(end - p), state)) != NULL) {
+                record_error((ULONG)(fail - 1), *state,
+                             *(volatile ULONG *)(fail - 1), pass);
+                p = fail;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*
+ * Build the tile of a walking pass, rotated by one bit per sub-pass
+ */
+static void build_walking_tile(MemTestPass pass, ULONG step)
+{
+    ULONG i;
+
+    for (i = 0; i < MEMTEST_TILE_LONGS; i++) {
+        memtest_tile[i] = 1UL << ((i + step) & 31);
+        if (pass == MEMTEST_WALKING_ZEROS) memtest_tile[i] = ~memtest_tile[i];
+    }
+}
+
+/*
+ * Sub-passes of a test pass
+ */
+static ULONG get_pass_steps(MemTestPass pass)
+{
+    return (pass == MEMTEST_WALKING_ONES || pass == MEMTEST_WALKING_ZEROS)
+           ? MEMTEST_WALK_STEPS : 1;
+}
+
+/*
+ * Check for an abort request: ESC, a mouse click or Ctrl-C
+ * Other window messages are dropped while the test runs.
+ */
+static BOOL memtest_abort_requested(void)
+{
+    struct IntuiMessage *msg;
+    BOOL abort = FALSE;
+
+    if (SetSignal(0, SIGBREAKF_CTRL_C) & SIGBREAKF_CTRL_C) {
+        abort = TRUE;
+    }
+
+    while ((msg = (struct IntuiMessage *)GetMsg(app->window->UserPort)) != NULL) {
+        if ((msg->Class == IDCMP_VANILLAKEY && msg->Code == 0x1B) ||
+            (msg->Class == IDCMP_MOUSEBUTTONS && msg->Code == SELECTDOWN)) {
+            abort = TRUE;
+        }
+        ReplyMsg((struct Message *)msg);
+    }
+
+    return abort;
+}
+
+/*
+ * Draw progress bar and current pass
+ */
+static void draw_memtest_progress(MemTestPass pass, ULONG percent)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[64];
+    WORD width = (WORD)((MEMTEST_BAR_WIDTH * percent) / 100);
+
+    if (width > 0) {
+        SetAPen(rp, COLOR_BAR_FILL);
+        RectFill(rp, MEMTEST_X, MEMTEST_BAR_Y,
+                 MEMTEST_X + width - 1, MEMTEST_BAR_Y + MEMTEST_BAR_HEIGHT - 1);
+    }
+
+    SetAPen(rp, COLOR_PANEL_BG);
+    RectFill(rp, MEMTEST_X, MEMTEST_STATUS_Y - 7, 612, MEMTEST_STATUS_Y + 2);
+
+    snprintf(buffer, sizeof(buffer), "%s  %lu%%",
+             get_memtest_pass_string(pass), (unsigned long)percent);
+    draw_text(MEMTEST_X, MEMTEST_STATUS_Y, buffer, COLOR_HIGHLIGHT);
+}
+
+/*
+ * Fill or verify all blocks in slices
+ * Returns FALSE if the user aborted.
+ */
+static BOOL run_phase(MemTestPass pass, BOOL verify, BOOL use_move16)
+{
+    ULONG state = MEMTEST_SEED;
+    ULONG b;
+
+    for (b = 0; b < memtest_result.block_count; b++) {
+        ULONG *p = (ULONG *)memtest_blocks[b].address;
+        ULONG left = memtest_blocks[b].size;
+
+        while (left) {
+            ULONG bytes = left > MEMTEST_SLICE ? MEMTEST_SLICE : left;
+            ULONG percent;
+
+            process_slice(pass, verify, p, bytes, &state, use_move16);
+
+            p += bytes / 4;
+            left -= bytes;
+            memtest_done += bytes;
+
+            percent = (ULONG)((memtest_done * 100) / memtest_total);
+            if (percent != memtest_percent) {
+                memtest_percent = percent;
+                draw_memtest_progress(pass, percent);
+            }
+
+            if (memtest_abort_requested()) return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/*
+ * Claim the free chunks of a region with AllocAbs()
+ * Chunks are trimmed to whole tiles; some memory stays free so the
+ * system keeps working while the test runs.
+ */
+static void claim_free_chunks(ULONG index)
+{
+    const MemoryRegion *region = &memory_regions.regions[index];
+    const ChunkSnapshot *chunks;
+    ULONG reserve = (region->mem_type & MEMF_CHIP) ? MEMTEST_CHIP_RESERVE
+                                                   : MEMTEST_RESERVE;
+    ULONG left, count, i;
+
+    chunks = get_region_free_chunks(index, &count);
+    if (!chunks) return;
+
+    left = region->amount_free;
+
+    for (i = 0; i < count && memtest_result.block_count < MEMTEST_MAX_BLOCKS; i++) {
+        ULONG start = (chunks[i].address + MEMTEST_TILE_BYTES - 1) &
+                      ~(MEMTEST_TILE_BYTES - 1);
+        ULONG end = (chunks[i].address + chunks[i].bytes) & ~(MEMTEST_TILE_BYTES - 1);
+        ULONG size;
+
+        if (end <= start || end - start < MEMTEST_MIN_BLOCK) continue;
+        if (left <= reserve + MEMTEST_MIN_BLOCK) break;
+
+        size = end - start;
+        if (size > left - reserve) {
+            size = (left - reserve) & ~(MEMTEST_TILE_BYTES - 1);
+        }
+
+        /* The chunk may have changed since the snapshot */
+        if (!AllocAbs(size, (APTR)start)) continue;
+
+        memtest_blocks[memtest_result.block_count].address = start;
+        memtest_blocks[memtest_result.block_count].size = size;
+        memtest_result.block_count++;
+        memtest_result.tested_bytes += size;
+        left -= size;
+    }
+}
+
+/*
+ * Claim the free chunks of a region and test them
+ */
+void run_memory_test(ULONG index)
+{
+    const MemoryRegion *region;
+    uint64_t start_time;
+    ULONG elapsed;
+    ULONG pass, step, steps, b;
+    BOOL use_move16;
+
+    if (index >= memory_regions.count) return;
+    region = &memory_regions.regions[index];
+
+    memset(&memtest_result, 0, sizeof(memtest_result));
+    memtest_result.region = index;
+
+    memtest_tile = (ULONG *)(((ULONG)memtest_tile_buffer + 15) & ~15UL);
+
+    claim_free_chunks(index);
+    if (memtest_result.block_count == 0) {
+        memtest_result.valid = TRUE;
+        return;
+    }
+
+    /* move16 into CHIP RAM hangs some 040 boards */
+    use_move16 = (SysBase->AttnFlags & AFF_68040) && !(region->mem_type & MEMF_CHIP);
+    memtest_result.move16 = use_move16;
+
+    memtest_done = 0;
+    memtest_total = 0;
+    for (pass = 0; pass < MEMTEST_PASS_COUNT; pass++) {
+        memtest_total += (uint64_t)memtest_result.tested_bytes *
+                         get_pass_steps((MemTestPass)pass) * 2;
+    }
+    memtest_percent = 0;
+
+    debug("  memtest: region %lu, %lu blocks, %lu bytes\n",
+          (unsigned long)index, (unsigned long)memtest_result.block_count,
+          (unsigned long)memtest_result.tested_bytes);
+
+    start_time = get_timer_ticks();
+
+    for (pass = 0; pass < MEMTEST_PASS_COUNT && !memtest_result.aborted; pass++) {
+        steps = get_pass_steps((MemTestPass)pass);
+
+        for (step = 0; step < steps && !memtest_result.aborted; step++) {
+            if (steps > 1) build_walking_tile((MemTestPass)pass, step);
+
+            draw_memtest_progress((MemTestPass)pass, memtest_percent);
+
+            if (!run_phase((MemTestPass)pass, FALSE, use_move16)) {
+                memtest_result.aborted = TRUE;
+                break;
+            }
+
+            /* Verify what is in RAM, not what is still in the data cache */
+            CacheClearU();
+
+            if (!run_phase((MemTestPass)pass, TRUE, use_move16)) {
+                memtest_result.aborted = TRUE;
+            }
+        }
+    }
+
+    elapsed = (ULONG)(get_timer_ticks() - start_time);
+    if (elapsed == 0) elapsed = 1;
+
+    memtest_result.seconds = elapsed / 1000000;
+    memtest_result.speed = (ULONG)((memtest_done * 1000000) / elapsed);
+
+    for (b = 0; b < memtest_result.block_count; b++) {
+        FreeMem((APTR)memtest_blocks[b].address, memtest_blocks[b].size);
+    }
+
+    memtest_result.valid = TRUE;
+
+    debug("  memtest: %lu errors, %lu bytes/s%s\n",
+          (unsigned long)memtest_result.error_count,
+          (unsigned long)memtest_result.speed,
+          memtest_result.aborted ? ", aborted" : "");
+}
+
+/*
+ * Draw memory test view
+ */
+void draw_memtest_view(void)
+{
+    struct RastPort *rp = app->rp;
+    const MemoryRegion *region;
+    char buffer[80];
+    char label[32];
+    ULONG i;
+    WORD y;
+    Button *btn;
+
+    /* Draw title panel */
+    draw_panel(20, 0, 600, 24, NULL);
+
+    SetAPen(rp, COLOR_TEXT);
+    SetBPen(rp, COLOR_PANEL_BG);
+    Move(rp, 220, 14);
+    Text(rp, (CONST_STRPTR)get_string(MSG_MEMORY_TEST),
+         strlen(get_string(MSG_MEMORY_TEST)));
+
+    /* Draw test panel */
+    draw_panel(20, 28, 600, 156, NULL);
+
+    if (memtest_region >= memory_regions.count) return;
+    region = &memory_regions.regions[memtest_region];
+
+    /* Region under test */
+    format_region_label(memtest_region, label, sizeof(label));
+    snprintf(buffer, sizeof(buffer), "%s  $%08lX-$%08lX", label,
+             (unsigned long)region->lower_bound, (unsigned long)region->end_address);
+    draw_label_value(MEMTEST_X, 40, get_string(MSG_PRI_REGION), buffer, 96);
+
+    format_size(region->amount_free, buffer, sizeof(buffer));
+    draw_label_value(MEMTEST_X, 50, get_string(MSG_AMOUNT_FREE), buffer, 96);
+
+    /* Progress bar */
+    draw_3d_box(MEMTEST_X - 2, MEMTEST_BAR_Y - 2,
+                MEMTEST_BAR_WIDTH + 4, MEMTEST_BAR_HEIGHT + 4, TRUE);
+
+    if (!memtest_result.valid) {
+        draw_text(MEMTEST_X, MEMTEST_STATUS_Y, get_string(MSG_MEMTEST_HINT), COLOR_TEXT);
+    } else if (memtest_result.block_count == 0) {
+        draw_text(MEMTEST_X, MEMTEST_STATUS_Y, get_string(MSG_MEMTEST_NOTHING),
+                  COLOR_BAR_YOU);
+    } else {
+        /* Amount tested, time and throughput */
+        format_size(memtest_result.tested_bytes, label, sizeof(label));
+        snprintf(buffer, sizeof(buffer), "%s, %lu s, ", label,
+                 (unsigned long)memtest_result.seconds);
+        format_copy_speed(memtest_result.speed, label, sizeof(label));
+        strncat(buffer, label, sizeof(buffer) - strlen(buffer) - 1);
+        strncat(buffer, memtest_result.move16 ? " MB/s, move16" : " MB/s, movem",
+                sizeof(buffer) - strlen(buffer) - 1);
+        draw_label_value(MEMTEST_X, 100, get_string(MSG_MEMTEST_TESTED), buffer, 96);
+
+        if (memtest_result.aborted) {
+            draw_text(MEMTEST_X, MEMTEST_STATUS_Y, get_string(MSG_MEMTEST_ABORTED),
+                      COLOR_BAR_YOU);
+        }
+
+        /* Result and the first failing addresses */
+        if (memtest_result.error_count == 0) {
+            draw_label_value(MEMTEST_X, 120, get_string(MSG_MEMTEST_ERRORS),
+                             get_string(MSG_MEMTEST_PASSED), 96);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%lu",
+                     (unsigned long)memtest_result.error_count);
+            draw_text(MEMTEST_X, 120, get_string(MSG_MEMTEST_ERRORS), COLOR_TEXT);
+            draw_text(MEMTEST_X + 96, 120, buffer, COLOR_BAR_YOU);
+
+            y = MEMTEST_ERROR_Y;
+            for (i = 0; i < memtest_result.error_count && i < MEMTEST_MAX_ERRORS &&
+                        y < 184; i++) {
+                MemTestError *err = &memtest_result.errors[i];
+
+                snprintf(buffer, sizeof(buffer), "$%08lX  %s $%08lX  %s $%08lX  %s",
+                         (unsigned long)err->address,
+                         get_string(MSG_MEMTEST_EXPECTED), (unsigned long)err->expected,
+                         get_string(MSG_MEMTEST_READ), (unsigned long)err->actual,
+                         get_memtest_pass_string((MemTestPass)err->pass));
+                draw_text(MEMTEST_X, y, buffer, COLOR_HIGHLIGHT);
+                y += MEMTEST_ROW_HEIGHT;
+            }
+        }
+    }
+
+    /* Draw buttons */
+    btn = find_button(BTN_MEMTEST_EXIT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_MEMTEST_START);
+    if (btn) draw_button(btn);
+}
+
+/*
+ * Update buttons for memory test view
+ */
+void memtest_view_update_buttons(void)
+{
+    add_button(20, 188, 60, 12,
+               get_string(MSG_BTN_EXIT), BTN_MEMTEST_EXIT, TRUE);
+    add_button(100, 188, 60, 12,
+               get_string(MSG_BTN_TEST), BTN_MEMTEST_START,
+               memtest_region < memory_regions.count);
+}
+
+/*
+ * Handle button press for memory test view
+ */
+void memtest_view_handle_button(ButtonID id)
+{
+    switch (id) {
+        case BTN_MEMTEST_START:
+            /* Start from an empty bar with the abort hint */
+            memtest_result.valid = FALSE;
+            redraw_current_view();
+            draw_text(MEMTEST_X, MEMTEST_STATUS_Y + 10, get_string(MSG_MEMTEST_STOP_HINT),
+                      COLOR_TEXT);
+
+            run_memory_test(memtest_region);
+            redraw_current_view();
+            break;
+
+        case BTN_MEMTEST_EXIT:
+            switch_to_view(VIEW_MEMORY);
+            break;
+
+        default:
+            break;
+    }
+}
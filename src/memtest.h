@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Memory integrity tester header
+ */
+
+#ifndef MEMTEST_H
+#define MEMTEST_H
+
+#include "xsysinfo.h"
+
+/* Free chunks claimed per test and failures kept */
+#define MEMTEST_MAX_BLOCKS      256
+#define MEMTEST_MAX_ERRORS      8
+
+/* Claimed blocks are 128 byte aligned (one pattern tile) */
+#define MEMTEST_TILE_BYTES      128
+#define MEMTEST_MIN_BLOCK       1024
+
+/* Free memory left to the system while testing */
+#define MEMTEST_RESERVE         (64 * 1024)
+#define MEMTEST_CHIP_RESERVE    (128 * 1024)
+
+/* Sub-passes of a walking pattern, the tile is rotated by one bit
+ * each time so every longword sees all 32 bit positions */
+#define MEMTEST_WALK_STEPS      32
+
+/* Bytes between progress updates and abort checks */
+#define MEMTEST_SLICE           (256 * 1024)
+
+/* Test passes, each fills all blocks before verifying them */
+typedef enum {
+    MEMTEST_WALKING_ONES,
+    MEMTEST_WALKING_ZEROS,
+    MEMTEST_ADDRESS,
+    MEMTEST_ADDRESS_INVERTED,
+    MEMTEST_RANDOM,
+    MEMTEST_PASS_COUNT
+} MemTestPass;
+
+/* One failing longword */
+typedef struct {
+    ULONG address;
+    ULONG expected;
+    ULONG actual;
+    UBYTE pass;             /* MemTestPass */
+} MemTestError;
+
+/* Result of the last test */
+typedef struct {
+    ULONG region;           /* Index into memory_regions */
+    ULONG tested_bytes;
+    ULONG block_count;
+    ULONG error_count;
+    MemTestError errors[MEMTEST_MAX_ERRORS];
+    ULONG seconds;
+    ULONG speed;            /* Bytes written plus verified per second */
+    BOOL move16;            /* Fills used move16 */
+    BOOL aborted;
+    BOOL valid;             /* TRUE once a test ran */
+} MemTestResult;
+
+/* Global memory test result */
+extern MemTestResult memtest_result;
+
+/* Function prototypes */
+
+/* Select the region tested by the memory test view */
+void memtest_select_region(ULONG index);
+
+/* Claim the free chunks of a region and test them */
+void run_memory_test(ULONG index);
+
+/* Name of a test pass */
+const char *get_memtest_pass_string(MemTestPass pass);
+
+/* Draw memory test view */
+void draw_memtest_view(void);
+
+#endif /* MEMTEST_H */
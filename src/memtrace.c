@@ -0,0 +1,716 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Memory allocation tracing
+ *
+ * For a limited window AllocMem(), FreeMem(), AllocVec() and FreeVec()
+ * are patched with SetFunction(). The patches run in the calling task and
+ * log every call into a ring buffer that is allocated before patching, so
+ * logging never allocates memory itself. Afterwards allocations and frees
+ * are matched by address to find who keeps memory and how much of it is
+ * CHIP RAM.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/execbase.h>
+#include <exec/memory.h>
+#include <exec/tasks.h>
+#include <dos/dos.h>
+
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/graphics.h>
+
+#include "xsysinfo.h"
+#include "memtrace.h"
+#include "memory.h"
+#include "benchmark.h"
+#include "software.h"
+#include "tasks.h"
+#include "gui.h"
+#include "locale_str.h"
+#include "debug.h"
+
+/* Global trace results */
+TraceResults trace_results;
+
+/* Matching table for allocations, twice the ring size so it never fills */
+#define TRACE_HASH_SIZE     (MEMTRACE_EVENTS * 2)
+
+/* How far apart AllocVec() and its inner AllocMem() may be logged */
+#define TRACE_NEST_WINDOW   8
+
+/* Column positions: tasks left, size histogram right */
+#define TRACE_COL_TASK      28
+#define TRACE_COL_RATE      196
+#define TRACE_COL_OUTSTANDING 268
+#define TRACE_COL_CHIP      372
+#define TRACE_COL_SIZE      452
+#define TRACE_COL_COUNT     548
+#define TRACE_ROW_HEIGHT    10
+#define TRACE_STATUS_Y      178
+#define TRACE_NAME_CHARS    20
+
+/* Ring buffer slot of event number n */
+#define TRACE_EVENT(n)      (&trace_events[(n) & (MEMTRACE_EVENTS - 1)])
+
+/* Shared with the patch stubs below */
+volatile ULONG memtrace_busy = 0;           /* Calls currently inside a stub */
+APTR memtrace_original[TRACE_KIND_COUNT];   /* Vectors before patching */
+void memtrace_log(ULONG kind, ULONG address, ULONG size, ULONG flags);
+
+/*
+ * Patch stubs: exec passes arguments in registers, the logger takes
+ * them on the stack. Allocations are logged after the original returns,
+ * frees before the block is handed back. memtrace_busy counts callers
+ * inside a stub so the code is not unloaded under them.
+ */
+void memtrace_stub_allocmem(void);
+void memtrace_stub_freemem(void);
+void memtrace_stub_allocvec(void);
+void memtrace_stub_freevec(void);
+
+__asm__(
+    "    .text\n"
+    "    .even\n"
+    "    .globl _memtrace_stub_allocmem\n"
+    "_memtrace_stub_allocmem:\n"            /* d0 = size, d1 = requirements */
+    "    addq.l  #1,_memtrace_busy\n"
+    "    move.l  d1,-(sp)\n"
+    "    move.l  d0,-(sp)\n"
+    "    move.l  _memtrace_original,a0\n"
+    "    jsr     (a0)\n"
+    "    move.l  d0,-(sp)\n"
+    "    clr.l   -(sp)\n"                   /* TRACE_ALLOCMEM */
+    "    jsr     _memtrace_log\n"
+    "    addq.l  #4,sp\n"
+    "    move.l  (sp)+,d0\n"
+    "    addq.l  #8,sp\n"
+    "    subq.l  #1,_memtrace_busy\n"
+    "    rts\n"
+    "\n"
+    "    .globl _memtrace_stub_freemem\n"
+    "_memtrace_stub_freemem:\n"             /* a1 = memory, d0 = size */
+    "    addq.l  #1,_memtrace_busy\n"
+    "    movem.l d0/a1,-(sp)\n"
+    "    clr.l   -(sp)\n"
+    "    move.l  d0,-(sp)\n"
+    "    move.l  a1,-(sp)\n"
+    "    move.l  #1,-(sp)\n"                /* TRACE_FREEMEM */
+    "    jsr     _memtrace_log\n"
+    "    lea     16(sp),sp\n"
+    "    movem.l (sp)+,d0/a1\n"
+    "    move.l  _memtrace_original+4,-(sp)\n"
+    "    subq.l  #1,_memtrace_busy\n"
+    "    rts\n"
+    "\n"
+    "    .globl _memtrace_stub_allocvec\n"
+    "_memtrace_stub_allocvec:\n"            /* d0 = size, d1 = requirements */
+    "    addq.l  #1,_memtrace_busy\n"
+    "    move.l  d1,-(sp)\n"
+    "    move.l  d0,-(sp)\n"
+    "    move.l  _memtrace_original+8,a0\n"
+    "    jsr     (a0)\n"
+    "    move.l  d0,-(sp)\n"
+    "    move.l  #2,-(sp)\n"                /* TRACE_ALLOCVEC */
+    "    jsr     _memtrace_log\n"
+    "    addq.l  #4,sp\n"
+    "    move.l  (sp)+,d0\n"
+    "    addq.l  #8,sp\n"
+    "    subq.l  #1,_memtrace_busy\n"
+    "    rts\n"
+    "\n"
+    "    .globl _memtrace_stub_freevec\n"
+    "_memtrace_stub_freevec:\n"             /* a1 = memory */
+    "    addq.l  #1,_memtrace_busy\n"
+    "    movem.l d0/a1,-(sp)\n"
+    "    clr.l   -(sp)\n"
+    "    clr.l   -(sp)\n"
+    "    move.l  a1,-(sp)\n"
+    "    move.l  #3,-(sp)\n"                /* TRACE_FREEVEC */
+    "    jsr     _memtrace_log\n"
+    "    lea     16(sp),sp\n"
+    "    movem.l (sp)+,d0/a1\n"
+    "    move.l  _memtrace_original+12,-(sp)\n"
+    "    subq.l  #1,_memtrace_busy\n"
+    "    rts\n"
+);
+
+/* Library vector and stub of each traced function */
+static const LONG trace_lvo[TRACE_KIND_COUNT] = {
+    LVO_ALLOCMEM, LVO_FREEMEM, LVO_ALLOCVEC, LVO_FREEVEC
+};
+static void (*const trace_stub[TRACE_KIND_COUNT])(void) = {
+    memtrace_stub_allocmem, memtrace_stub_freemem,
+    memtrace_stub_allocvec, memtrace_stub_freevec
+};
+
+/* Ring buffer and trace state */
+static TraceEvent *trace_events = NULL;
+static volatile ULONG trace_head = 0;       /* Events logged so far */
+static volatile BOOL trace_enabled = FALSE;
+static BOOL trace_patched = FALSE;
+static ULONG trace_kinds = 0;               /* Functions patched */
+static uint64_t trace_start = 0;
+
+/* Allocation matching table (ring slot + 1, 0 = empty) */
+static UWORD trace_hash[TRACE_HASH_SIZE];
+
+/* External references */
+extern struct ExecBase *SysBase;
+extern AppContext *app;
+
+/*
+ * Log one call - runs in the context of the calling task
+ * Slots are reserved and filled under Forbid(); the patches never run
+ * in interrupts and the GUI reads the ring only after the window ended.
+ */
+void memtrace_log(ULONG kind, ULONG address, ULONG size, ULONG flags)
+{
+    TraceEvent *ev;
+
+    if (!trace_enabled) return;
+
+    Forbid();
+
+    ev = TRACE_EVENT(trace_head);
+    trace_head++;
+
+    /* AllocVec() keeps the allocation size in front of the block */
+    if (kind == TRACE_FREEVEC && address) {
+        size = ((ULONG *)address)[-1] - 4;
+    }
+
+    ev->task = SysBase->ThisTask;
+    ev->address = address;
+    ev->size = size;
+    ev->flags = flags;
+    ev->time = (ULONG)(get_timer_ticks() - trace_start);
+    ev->kind = (UBYTE)kind;
+    ev->nested = FALSE;
+    ev->freed = FALSE;
+
+    Permit();
+}
+
+/*
+ * Restore the original vectors
+ * Fails if another program patched a traced function after us; our stub
+ * then stays in the chain (logging disabled) until it can be removed.
+ */
+static BOOL remove_patches(void)
+{
+    BOOL ours = TRUE;
+    ULONG i;
+
+    if (!trace_patched) return TRUE;
+
+    Forbid();
+
+    for (i = 0; i < trace_kinds; i++) {
+        if (get_library_vector((struct Library *)SysBase, trace_lvo[i]) !=
+            (ULONG)trace_stub[i]) {
+            ours = FALSE;
+        }
+    }
+
+    if (ours) {
+        for (i = 0; i < trace_kinds; i++) {
+            SetFunction((struct Library *)SysBase, trace_lvo[i],
+                        (APTR)memtrace_original[i]);
+        }
+        trace_patched = FALSE;
+    }
+
+    Permit();
+
+    if (!ours) return FALSE;
+
+    /* Let callers still inside a stub leave it */
+    while (memtrace_busy) {
+        Delay(1);
+    }
+    Delay(1);
+
+    return TRUE;
+}
+
+/*
+ * Patch the exec allocation functions and start a trace window
+ */
+BOOL start_alloc_trace(void)
+{
+    ULONG i;
+
+    if (trace_enabled) return TRUE;
+
+    /* A stub from the last window may still be in a chain */
+    if (!remove_patches()) return FALSE;
+
+    if (!trace_events) {
+        trace_events = (TraceEvent *)AllocMem(sizeof(TraceEvent) * MEMTRACE_EVENTS,
+                                              MEMF_PUBLIC | MEMF_CLEAR);
+        if (!trace_events) return FALSE;
+    }
+
+    if (!start_live_timer(MEMTRACE_TICK_VBLANKS)) return FALSE;
+
+    memset(&trace_results, 0, sizeof(trace_results));
+    trace_head = 0;
+    trace_start = get_timer_ticks();
+
+    /* AllocVec()/FreeVec() appeared in V36 */
+    trace_kinds = SysBase->LibNode.lib_Version >= 36 ? TRACE_KIND_COUNT
+                                                      : TRACE_ALLOCVEC;
+
+    Forbid();
+
+    for (i = 0; i < trace_kinds; i++) {
+        memtrace_original[i] = SetFunction((struct Library *)SysBase, trace_lvo[i],
+                                           (APTR)trace_stub[i]);
+    }
+    trace_patched = TRUE;
+    trace_enabled = TRUE;
+
+    Permit();
+
+    debug("  memtrace: patched %lu functions\n", (unsigned long)trace_kinds);
+
+    return TRUE;
+}
+
+/*
+ * Find or add the statistics of a task (NULL if the table is full)
+ */
+static TraceTaskStats *find_task_stats(APTR task)
+{
+    TraceTaskStats *stats;
+    ULONG i;
+
+    for (i = 0; i < trace_results.task_count; i++) {
+        if (trace_results.tasks[i].task == task) {
+            return &trace_results.tasks[i];
+        }
+    }
+
+    if (trace_results.task_count >= MAX_TRACE_TASKS) return NULL;
+
+    stats = &trace_results.tasks[trace_results.task_count++];
+    stats->task = task;
+    return stats;
+}
+
+/*
+ * Hash slot of a block address
+ */
+static ULONG trace_hash_slot(ULONG address)
+{
+    return ((address >> 3) ^ (address >> 15)) & (TRACE_HASH_SIZE - 1);
+}
+
+/*
+ * Remember an allocation for matching
+ */
+static void trace_hash_insert(ULONG n)
+{
+    ULONG slot = trace_hash_slot(TRACE_EVENT(n)->address);
+
+    while (trace_hash[slot]) {
+        slot = (slot + 1) & (TRACE_HASH_SIZE - 1);
+    }
+    trace_hash[slot] = (UWORD)((n & (MEMTRACE_EVENTS - 1)) + 1);
+}
+
+/*
+ * Find the outstanding allocation of a block and mark it freed
+ */
+static TraceEvent *trace_hash_take(ULONG address)
+{
+    ULONG slot = trace_hash_slot(address);
+
+    while (trace_hash[slot]) {
+        TraceEvent *ev = &trace_events[trace_hash[slot] - 1];
+
+        if (ev->address == address && !ev->freed) {
+            /* Freed allocations stay in the table as tombstones */
+            ev->freed = TRUE;
+            return ev;
+        }
+        slot = (slot + 1) & (TRACE_HASH_SIZE - 1);
+    }
+
+    return NULL;
+}
+
+/*
+ * Mark AllocMem()/FreeMem() calls that AllocVec()/FreeVec() made through
+ * the library vector. The inner allocation is logged just before its
+ * AllocVec(), the inner free just after its FreeVec().
+ */
+static void mark_nested_calls(ULONG first, ULONG count)
+{
+    ULONG n, j;
+
+    for (n = 0; n < count; n++) {
+        TraceEvent *ev = TRACE_EVENT(first + n);
+
+        if (!ev->address) continue;
+
+        if (ev->kind == TRACE_ALLOCVEC) {
+            for (j = 1; j <= TRACE_NEST_WINDOW && j <= n; j++) {
+                TraceEvent *inner = TRACE_EVENT(first + n - j);
+
+                if (inner->kind == TRACE_ALLOCMEM && inner->task == ev->task &&
+                    inner->address == ev->address - 4) {
+                    inner->nested = TRUE;
+                    break;
+                }
+            }
+        } else if (ev->kind == TRACE_FREEVEC) {
+            for (j = 1; j <= TRACE_NEST_WINDOW && n + j < count; j++) {
+                TraceEvent *inner = TRACE_EVENT(first + n + j);
+
+                if (inner->kind == TRACE_FREEMEM && inner->task == ev->task &&
+                    inner->address == ev->address - 4) {
+                    inner->nested = TRUE;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Copy the names of tasks that still exist
+ */
+static void lookup_task_names(void)
+{
+    ULONG i;
+
+    Forbid();
+
+    for (i = 0; i < trace_results.task_count; i++) {
+        TraceTaskStats *stats = &trace_results.tasks[i];
+        struct Node *node = find_task_node(stats->task);
+
+        if (node && node->ln_Name) {
+            strncpy(stats->name, node->ln_Name, sizeof(stats->name) - 1);
+        }
+    }
+
+    Permit();
+
+    for (i = 0; i < trace_results.task_count; i++) {
+        if (trace_results.tasks[i].name[0] == '\0') {
+            strncpy(trace_results.tasks[i].name, get_string(MSG_TRACE_EXITED),
+                    sizeof(trace_results.tasks[i].name) - 1);
+        }
+    }
+}
+
+/*
+ * Match allocations with frees and build the per task statistics
+ */
+static void analyze_trace(void)
+{
+    ULONG count = trace_head < MEMTRACE_EVENTS ? trace_head : MEMTRACE_EVENTS;
+    ULONG first = trace_head - count;
+    ULONG n, i;
+
+    trace_results.events = trace_head;
+    trace_results.lost = trace_head - count;
+
+    mark_nested_calls(first, count);
+    memset(trace_hash, 0, sizeof(trace_hash));
+
+    for (n = 0; n < count; n++) {
+        TraceEvent *ev = TRACE_EVENT(first + n);
+        TraceTaskStats *stats;
+
+        if (ev->nested || !ev->address) continue;
+
+        stats = find_task_stats(ev->task);
+
+        if (ev->kind == TRACE_ALLOCMEM || ev->kind == TRACE_ALLOCVEC) {
+            trace_results.histogram[histogram_bucket(ev->size)]++;
+            if (stats) {
+                stats->allocs++;
+                stats->alloc_bytes += ev->size;
+            }
+            trace_hash_insert(first + n);
+        } else {
+            /* Blocks allocated before the window do not match */
+            trace_hash_take(ev->address);
+            if (stats) stats->frees++;
+        }
+    }
+
+    /* Whatever was not freed is still held by its allocating task */
+    for (n = 0; n < count; n++) {
+        TraceEvent *ev = TRACE_EVENT(first + n);
+        TraceTaskStats *stats;
+
+        if (ev->nested || ev->freed || !ev->address) continue;
+        if (ev->kind != TRACE_ALLOCMEM && ev->kind != TRACE_ALLOCVEC) continue;
+
+        stats = find_task_stats(ev->task);
+        if (!stats) continue;
+
+        stats->outstanding += ev->size;
+        if (TypeOfMem((APTR)ev->address) & MEMF_CHIP) {
+            stats->chip_outstanding += ev->size;
+        }
+    }
+
+    lookup_task_names();
+
+    /* Busiest task first */
+    for (i = 1; i < trace_results.task_count; i++) {
+        TraceTaskStats tmp = trace_results.tasks[i];
+        LONG j = i - 1;
+
+        while (j >= 0 && trace_results.tasks[j].allocs < tmp.allocs) {
+            trace_results.tasks[j + 1] = trace_results.tasks[j];
+            j--;
+        }
+        trace_results.tasks[j + 1] = tmp;
+    }
+
+    trace_results.valid = TRUE;
+
+    debug("  memtrace: %lu events, %lu lost, %lu tasks\n",
+          (unsigned long)trace_results.events, (unsigned long)trace_results.lost,
+          (unsigned long)trace_results.task_count);
+}
+
+/*
+ * Remove the patches and analyze the window
+ */
+void stop_alloc_trace(void)
+{
+    if (!trace_enabled) return;
+
+    stop_live_timer();
+
+    trace_enabled = FALSE;
+    trace_results.duration_us = (ULONG)(get_timer_ticks() - trace_start);
+    trace_results.unpatch_failed = !remove_patches();
+
+    /* Stubs left in a chain no longer log once they saw the flag */
+    if (trace_results.unpatch_failed) Delay(2);
+
+    analyze_trace();
+
+    if (!trace_patched) {
+        FreeMem(trace_events, sizeof(TraceEvent) * MEMTRACE_EVENTS);
+        trace_events = NULL;
+    }
+}
+
+/*
+ * TRUE while the patches log calls
+ */
+BOOL alloc_trace_active(void)
+{
+    return trace_enabled;
+}
+
+/*
+ * Remove patches left behind
+ * The stubs live in our code, so we cannot exit while one is in a chain.
+ */
+void cleanup_alloc_trace(void)
+{
+    if (trace_enabled) stop_alloc_trace();
+
+    while (!remove_patches()) {
+        Delay(TICKS_PER_SECOND);
+    }
+
+    if (trace_events) {
+        FreeMem(trace_events, sizeof(TraceEvent) * MEMTRACE_EVENTS);
+        trace_events = NULL;
+    }
+}
+
+/*
+ * Draw the status line below the tables
+ */
+static void draw_trace_status(void)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[80];
+
+    SetAPen(rp, COLOR_BACKGROUND);
+    RectFill(rp, TRACE_COL_TASK, TRACE_STATUS_Y - 7, 612, TRACE_STATUS_Y + 2);
+
+    if (trace_enabled) {
+        ULONG elapsed = (ULONG)((get_timer_ticks() - trace_start) / 1000000);
+
+        snprintf(buffer, sizeof(buffer), "%s %lu s, %lu %s",
+                 get_string(MSG_TRACE_RUNNING),
+                 (unsigned long)(MEMTRACE_SECONDS - elapsed),
+                 (unsigned long)trace_head, get_string(MSG_TRACE_EVENTS));
+        draw_text(TRACE_COL_TASK, TRACE_STATUS_Y, buffer, COLOR_HIGHLIGHT);
+    } else if (trace_results.valid) {
+        snprintf(buffer, sizeof(buffer), "%s %lu s, %lu %s, %lu %s",
+                 get_string(MSG_TRACE_WINDOW),
+                 (unsigned long)(trace_results.duration_us / 1000000),
+                 (unsigned long)trace_results.events, get_string(MSG_TRACE_EVENTS),
+                 (unsigned long)trace_results.lost, get_string(MSG_TRACE_LOST));
+        draw_text(TRACE_COL_TASK, TRACE_STATUS_Y, buffer, COLOR_TEXT);
+
+        if (trace_results.unpatch_failed) {
+            draw_text(TRACE_COL_SIZE - 64, TRACE_STATUS_Y,
+                      get_string(MSG_TRACE_UNPATCH_FAILED), COLOR_BAR_YOU);
+        }
+    }
+}
+
+/*
+ * Live timer tick: update status, end the window when it expires
+ */
+void alloc_trace_tick(void)
+{
+    if (!trace_enabled) return;
+
+    if (get_timer_ticks() - trace_start >= (uint64_t)MEMTRACE_SECONDS * 1000000) {
+        stop_alloc_trace();
+        if (app->current_view == VIEW_TRACE) redraw_current_view();
+        return;
+    }
+
+    if (app->current_view == VIEW_TRACE) draw_trace_status();
+}
+
+/*
+ * Draw allocation trace view
+ */
+void draw_trace_view(void)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[32];
+    ULONG i;
+    WORD y;
+    Button *btn;
+
+    /* Draw title panel */
+    draw_panel(20, 0, 600, 24, NULL);
+
+    SetAPen(rp, COLOR_TEXT);
+    SetBPen(rp, COLOR_PANEL_BG);
+    Move(rp, 220, 14);
+    Text(rp, (CONST_STRPTR)get_string(MSG_ALLOC_TRACE),
+         strlen(get_string(MSG_ALLOC_TRACE)));
+
+    /* Draw column headers */
+    y = 40;
+    SetAPen(rp, COLOR_TEXT);
+
+    TightText(rp, TRACE_COL_TASK, y, (CONST_STRPTR)get_string(MSG_TRACE_TASK), -1, 4);
+    TightText(rp, TRACE_COL_RATE, y, (CONST_STRPTR)get_string(MSG_ALLOC_RATE), -1, 4);
+    TightText(rp, TRACE_COL_OUTSTANDING, y,
+              (CONST_STRPTR)get_string(MSG_TRACE_OUTSTANDING), -1, 4);
+    TightText(rp, TRACE_COL_CHIP, y, (CONST_STRPTR)"CHIP", -1, 4);
+    TightText(rp, TRACE_COL_SIZE, y, (CONST_STRPTR)get_string(MSG_TRACE_SIZE), -1, 4);
+    TightText(rp, TRACE_COL_COUNT, y, (CONST_STRPTR)get_string(MSG_TRACE_COUNT), -1, 4);
+
+    /* Draw separator line */
+    SetAPen(rp, COLOR_BUTTON_DARK);
+    Move(rp, 20, y + 4);
+    Draw(rp, 628, y + 4);
+
+    if (!trace_results.valid) {
+        if (!trace_enabled) {
+            draw_text(TRACE_COL_TASK, 100, get_string(MSG_TRACE_HINT), COLOR_TEXT);
+        }
+    } else {
+        ULONG duration = trace_results.duration_us ? trace_results.duration_us : 1;
+
+        /* One row per task, busiest first */
+        y = 56;
+        for (i = 0; i < trace_results.task_count && y < 170; i++) {
+            TraceTaskStats *stats = &trace_results.tasks[i];
+
+            strncpy(buffer, stats->name, TRACE_NAME_CHARS);
+            buffer[TRACE_NAME_CHARS] = '\0';
+            draw_text(TRACE_COL_TASK, y, buffer, COLOR_HIGHLIGHT);
+
+            snprintf(buffer, sizeof(buffer), "%lu",
+                     (unsigned long)(((uint64_t)stats->allocs * 1000000) / duration));
+            draw_text(TRACE_COL_RATE, y, buffer, COLOR_HIGHLIGHT);
+
+            format_size(stats->outstanding, buffer, sizeof(buffer));
+            draw_text(TRACE_COL_OUTSTANDING, y, buffer, COLOR_HIGHLIGHT);
+
+            /* CHIP RAM kept by a task is what fragments it */
+            format_size(stats->chip_outstanding, buffer, sizeof(buffer));
+            draw_text(TRACE_COL_CHIP, y, buffer,
+                      stats->chip_outstanding ? COLOR_BAR_YOU : COLOR_HIGHLIGHT);
+
+            y += TRACE_ROW_HEIGHT;
+        }
+
+        /* Allocation sizes */
+        y = 56;
+        for (i = 0; i < FRAG_HISTOGRAM_BUCKETS && y < 170; i++) {
+            if (trace_results.histogram[i] == 0) continue;
+
+            format_histogram_bucket(i, buffer, sizeof(buffer));
+            draw_text(TRACE_COL_SIZE, y, buffer, COLOR_TEXT);
+
+            snprintf(buffer, sizeof(buffer), "%lu",
+                     (unsigned long)trace_results.histogram[i]);
+            draw_text(TRACE_COL_COUNT, y, buffer, COLOR_HIGHLIGHT);
+
+            y += TRACE_ROW_HEIGHT;
+        }
+    }
+
+    draw_trace_status();
+
+    /* Draw buttons */
+    btn = find_button(BTN_TRACE_EXIT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_TRACE_START);
+    if (btn) draw_button(btn);
+}
+
+/*
+ * Update buttons for allocation trace view
+ */
+void trace_view_update_buttons(void)
+{
+    add_button(20, 188, 60, 12,
+               get_string(MSG_BTN_EXIT), BTN_TRACE_EXIT, TRUE);
+    add_button(100, 188, 60, 12,
+               get_string(trace_enabled ? MSG_BTN_STOP : MSG_BTN_TRACE),
+               BTN_TRACE_START, TRUE);
+}
+
+/*
+ * Handle button press for allocation trace view
+ */
+void trace_view_handle_button(ButtonID id)
+{
+    switch (id) {
+        case BTN_TRACE_START:
+            if (trace_enabled) {
+                stop_alloc_trace();
+            } else {
+                start_alloc_trace();
+            }
+            redraw_current_view();
+            break;
+
+        case BTN_TRACE_EXIT:
+            switch_to_view(VIEW_MEMORY);
+            break;
+
+        default:
+            break;
+    }
+}
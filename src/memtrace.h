@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Memory allocation tracing header
+ */
+
+#ifndef MEMTRACE_H
+#define MEMTRACE_H
+
+#include "xsysinfo.h"
+#include "memory.h"
+
+/* Ring buffer size in events (power of two), allocated before patching */
+#define MEMTRACE_EVENTS         4096
+
+/* Length of a trace window and status update interval */
+#define MEMTRACE_SECONDS        10
+#define MEMTRACE_TICK_VBLANKS   50
+
+/* Tasks kept in the results, busiest first */
+#define MAX_TRACE_TASKS         32
+
+/* Traced exec functions (also the index of the saved original vector) */
+typedef enum {
+    TRACE_ALLOCMEM,
+    TRACE_FREEMEM,
+    TRACE_ALLOCVEC,
+    TRACE_FREEVEC,
+    TRACE_KIND_COUNT
+} TraceKind;
+
+/* One logged call */
+typedef struct {
+    APTR task;
+    ULONG address;          /* Result of an allocation, block of a free */
+    ULONG size;
+    ULONG flags;            /* MEMF_* requirements */
+    ULONG time;             /* Microseconds since the trace started */
+    UBYTE kind;             /* TraceKind */
+    UBYTE nested;           /* AllocMem()/FreeMem() done by AllocVec()/FreeVec() */
+    UBYTE freed;            /* Allocation freed within the window */
+} TraceEvent;
+
+/* Per task summary of a trace window */
+typedef struct {
+    APTR task;
+    char name[32];
+    ULONG allocs;
+    ULONG frees;
+    ULONG alloc_bytes;
+    ULONG outstanding;      /* Allocated in the window and not freed */
+    ULONG chip_outstanding; /* Part of outstanding that is CHIP RAM */
+} TraceTaskStats;
+
+/* Trace results */
+typedef struct {
+    TraceTaskStats tasks[MAX_TRACE_TASKS];
+    ULONG task_count;
+    ULONG histogram[FRAG_HISTOGRAM_BUCKETS];    /* Allocations by size */
+    ULONG events;           /* Calls logged */
+    ULONG lost;             /* Events overwritten in the ring */
+    ULONG duration_us;
+    BOOL valid;             /* TRUE once a window was analyzed */
+    BOOL unpatch_failed;    /* Vectors were re-patched by someone else */
+} TraceResults;
+
+/* Global trace results */
+extern TraceResults trace_results;
+
+/* Function prototypes */
+
+/* Patch the exec allocation functions and start a trace window */
+BOOL start_alloc_trace(void);
+
+/* Remove the patches and analyze the window */
+void stop_alloc_trace(void);
+
+/* TRUE while the patches log calls */
+BOOL alloc_trace_active(void);
+
+/* Live timer tick: update status, end the window when it expires */
+void alloc_trace_tick(void);
+
+/* Remove patches left behind (waits until that is possible) */
+void cleanup_alloc_trace(void);
+
+/* Draw allocation trace view */
+void draw_trace_view(void);
+
+#endif /* MEMTRACE_H */
@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - mmu.library mapping queries
+ */
+
+#include <string.h>
+
+#include <exec/lists.h>
+#include <mmu/context.h>
+#include <mmu/mmubase.h>
+
+#include <proto/exec.h>
+#include <proto/mmu.h>
+
+#include "xsysinfo.h"
+#include "mmu.h"
+#include "debug.h"
+
+/* mmu.library base (optional) */
+struct MMUBase *MMUBase = NULL;
+
+/* Number of distinct cache modes */
+#define NUM_CACHE_MODES     (CACHE_MODE_IMPRECISE + 1)
+
+/*
+ * Open mmu.library - not a failure if it is missing
+ */
+BOOL open_mmu_library(void)
+{
+    if (!MMUBase) {
+        MMUBase = (struct MMUBase *)
+            OpenLibrary((CONST_STRPTR)"mmu.library", MIN_MMU_VERSION);
+    }
+
+    return MMUBase != NULL;
+}
+
+/*
+ * Close mmu.library
+ */
+void close_mmu_library(void)
+{
+    if (MMUBase) {
+        CloseLibrary((struct Library *)MMUBase);
+        MMUBase = NULL;
+    }
+}
+
+/*
+ * Check if mmu.library is open and manages an MMU
+ */
+BOOL mmu_available(void)
+{
+    return MMUBase != NULL && GetMMUType() != 0;
+}
+
+/*
+ * Translate MAPP_* properties to a cache mode
+ */
+static CacheMode cache_mode_from_properties(ULONG props)
+{
+    if (props & MAPP_CACHEINHIBIT) {
+        return (props & MAPP_IMPRECISE) ? CACHE_MODE_IMPRECISE
+                                        : CACHE_MODE_INHIBITED;
+    }
+    if (props & MAPP_COPYBACK) {
+        return CACHE_MODE_COPYBACK;
+    }
+    return CACHE_MODE_WRITETHROUGH;
+}
+
+/*
+ * Query cache mode, page size and remapping of [lower, upper)
+ * Walks a copy of the default context mapping, so this may be
+ * called with multitasking enabled.
+ */
+BOOL mmu_query_range(ULONG lower, ULONG upper, MMURangeInfo *info)
+{
+    struct MMUContext *ctx;
+    struct MinList *mapping;
+    struct MinNode *node;
+    ULONG bytes[NUM_CACHE_MODES];
+    ULONG best = 0;
+    UWORD modes_seen = 0;
+    UWORD i;
+
+    memset(info, 0, sizeof(*info));
+    info->cache_mode = CACHE_MODE_UNKNOWN;
+
+    if (!mmu_available() || upper <= lower) {
+        return FALSE;
+    }
+
+    ctx = DefaultContext();
+    info->page_size = GetPageSize(ctx);
+
+    mapping = GetMapping(ctx);
+    if (!mapping) {
+        return FALSE;
+    }
+
+    memset(bytes, 0, sizeof(bytes));
+
+    for (node = mapping->mlh_Head; node->mln_Succ; node = node->mln_Succ) {
+        struct MappingNode *map = (struct MappingNode *)node;
+        ULONG from, to;
+        CacheMode mode;
+
+        /* map_Higher is the last address of the node (inclusive) */
+        if (map->map_Higher < lower || map->map_Lower >= upper) {
+            continue;
+        }
+
+        from = (map->map_Lower > lower) ? map->map_Lower : lower;
+        to = (map->map_Higher < upper - 1) ? map->map_Higher : upper - 1;
+
+        if (map->map_Properties & MAPP_INVALID) {
+            continue;
+        }
+
+        mode = cache_mode_from_properties(map->map_Properties);
+        if (bytes[mode] == 0) {
+            modes_seen++;
+        }
+        bytes[mode] += to - from + 1;
+
+        if (map->map_Properties & MAPP_REMAPPED) {
+            info->remapped = TRUE;
+        }
+        if (map->map_Properties & MAPP_ROM) {
+            info->rom = TRUE;
+        }
+    }
+
+    ReleaseMapping(ctx, mapping);
+
+    for (i = CACHE_MODE_COPYBACK; i < NUM_CACHE_MODES; i++) {
+        if (bytes[i] > best) {
+            best = bytes[i];
+            info->cache_mode = (CacheMode)i;
+        }
+    }
+    info->mixed = (modes_seen > 1);
+
+    debug("  mmu: $%08lx-$%08lx mode %ld%s%s\n",
+          (unsigned long)lower, (unsigned long)upper,
+          (LONG)info->cache_mode, info->mixed ? " mixed" : "",
+          info->remapped ? " remapped" : "");
+
+    return info->cache_mode != CACHE_MODE_UNKNOWN;
+}
+
+/*
+ * Get cache mode as string
+ */
+const char *get_cache_mode_string(CacheMode mode)
+{
+    switch (mode) {
+        case CACHE_MODE_COPYBACK:       return "COPYBACK";
+        case CACHE_MODE_WRITETHROUGH:   return "WRITETHROUGH";
+        case CACHE_MODE_INHIBITED:      return "INHIBITED";
+        case CACHE_MODE_IMPRECISE:      return "IMPRECISE";
+        default:                        return "---";
+    }
+}
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - mmu.library mapping queries header
+ */
+
+#ifndef MMU_H
+#define MMU_H
+
+#include "xsysinfo.h"
+
+/* Cache mode of an address range as set up in the MMU tables */
+typedef enum {
+    CACHE_MODE_UNKNOWN,     /* No mmu.library, or range not mapped */
+    CACHE_MODE_COPYBACK,
+    CACHE_MODE_WRITETHROUGH,
+    CACHE_MODE_INHIBITED,   /* Cache inhibited, serialized */
+    CACHE_MODE_IMPRECISE    /* Cache inhibited, imprecise exceptions */
+} CacheMode;
+
+/* Result of an MMU mapping query for an address range */
+typedef struct {
+    CacheMode cache_mode;   /* Mode covering most of the range */
+    BOOL mixed;             /* TRUE if parts of the range differ */
+    BOOL remapped;          /* TRUE if any page is remapped elsewhere */
+    BOOL rom;               /* TRUE if any page is marked as ROM */
+    ULONG page_size;        /* MMU page size in bytes */
+} MMURangeInfo;
+
+/* Open/close mmu.library (optional, may fail) */
+BOOL open_mmu_library(void);
+void close_mmu_library(void);
+
+/* TRUE if mmu.library is open and an MMU is in use */
+BOOL mmu_available(void);
+
+/* Query cache mode, page size and remapping of [lower, upper) */
+BOOL mmu_query_range(ULONG lower, ULONG upper, MMURangeInfo *info);
+
+/* Get cache mode as string */
+const char *get_cache_mode_string(CacheMode mode);
+
+#endif /* MMU_H */
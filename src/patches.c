@@ -0,0 +1,536 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Library patch detector and view
+ *
+ * SetFunction() replaces the jump target of a library vector. Most
+ * vectors of a library point into the same code: the ROM, a resident
+ * module or the code of a disk library, which may extend past the code
+ * range profile.c found for it. Vectors pointing into other code are
+ * reported as patched, together with the code range (module, library or
+ * process seglist) the new target lies in.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/execbase.h>
+#include <exec/libraries.h>
+#include <exec/memory.h>
+#include <exec/semaphores.h>
+
+#include <proto/exec.h>
+#include <proto/graphics.h>
+
+#include "xsysinfo.h"
+#include "patches.h"
+#include "profile.h"
+#include "software.h"
+#include "benchmark.h"
+#include "sampler.h"
+#include "gui.h"
+#include "locale_str.h"
+#include "arena.h"
+#include "debug.h"
+
+/* Global patch list */
+PatchList patch_list;
+
+/* View layout */
+#define PATCH_COL_LIBRARY   28
+#define PATCH_COL_LVO       164
+#define PATCH_COL_TARGET    212
+#define PATCH_COL_LOCATION  292
+#define PATCH_COL_OWNER     364
+#define PATCH_ROW_HEIGHT    8
+#define PATCH_PAGE_ROWS     10
+#define PATCH_PROBE_Y       144
+#define PATCH_PROBE_COL2    328
+#define PATCH_STATUS_Y      180
+#define PATCH_NAME_CHARS    16
+#define PATCH_OWNER_CHARS   30
+
+/* JMP absolute.l opcode of a library vector */
+#define JMP_ABS_OPCODE      0x4EF9
+
+/* Where a vector points, range indices otherwise */
+#define TARGET_ROM          (-2)
+#define TARGET_UNKNOWN      (-1)
+
+/* Vectors used by each probe */
+static const WORD probe_lvos[PATCH_PROBE_COUNT][2] = {
+    { LVO_FINDTASK, LVO_FINDTASK },
+    { LVO_FORBID, LVO_PERMIT },
+    { LVO_ALLOCMEM, LVO_FREEMEM },
+    { LVO_ALLOCVEC, LVO_FREEVEC },
+    { LVO_OBTAINSEMAPHORE, LVO_RELEASESEMAPHORE }
+};
+
+static const char *const probe_names[PATCH_PROBE_COUNT] = {
+    "FindTask", "Forbid/Permit", "AllocMem/FreeMem", "AllocVec/FreeVec",
+    "Obtain/ReleaseSemaphore"
+};
+
+static ULONG patch_page = 0;
+
+/* Patched vectors found by the last scan, including those that did not fit */
+static ULONG patches_seen;
+
+/* External references */
+extern struct ExecBase *SysBase;
+extern AppContext *app;
+
+/*
+ * Name of a probe
+ */
+const char *get_patch_probe_name(PatchProbe probe)
+{
+    if (probe >= PATCH_PROBE_COUNT) return "---";
+    return probe_names[probe];
+}
+
+/*
+ * Classify a vector target: ROM, a code range or unknown
+ */
+static LONG get_target_key(ULONG target)
+{
+    CodeRange *range;
+
+    if (is_rom_address(target)) return TARGET_ROM;
+
+    range = find_code_range(target);
+    if (range) return (LONG)(range - code_profile.ranges);
+
+    return TARGET_UNKNOWN;
+}
+
+/*
+ * The code most vectors of a library point into
+ * Boyer-Moore majority vote, patches are the minority.
+ */
+static LONG find_library_home(struct Library *lib, ULONG count)
+{
+    LONG candidate = TARGET_UNKNOWN;
+    ULONG votes = 0;
+    ULONG i;
+
+    for (i = 1; i <= count; i++) {
+        LONG key;
+
+        if (*(UWORD *)((UBYTE *)lib - 6 * i) != JMP_ABS_OPCODE) continue;
+
+        key = get_target_key(get_library_vector(lib, -6 * (LONG)i));
+        if (votes == 0) {
+            candidate = key;
+            votes = 1;
+        } else if (key == candidate) {
+            votes++;
+        } else {
+            votes--;
+        }
+    }
+
+    return candidate;
+}
+
+/*
+ * Span of a disk library's code
+ * The code range profile.c found only covers the vectors close to the
+ * first one, larger libraries continue past it. The span grows over the
+ * targets outside any code range that lie within LIBRARY_CODE_WINDOW of
+ * it, code SetFunction() put elsewhere stays outside.
+ */
+static void get_library_span(struct Library *lib, ULONG count, ULONG *lower, ULONG *upper)
+{
+    ULONG first = get_library_vector(lib, -6);
+    CodeRange *range = find_code_range(first);
+    BOOL grown = TRUE;
+    ULONG i;
+
+    *lower = *upper = first;
+    if (range && range->owner == (APTR)lib) {
+        *lower = range->lower;
+        *upper = range->upper;
+    }
+
+    while (grown) {
+        grown = FALSE;
+        for (i = 2; i <= count; i++) {
+            ULONG target;
+
+            if (*(UWORD *)((UBYTE *)lib - 6 * i) != JMP_ABS_OPCODE) continue;
+
+            target = get_library_vector(lib, -6 * (LONG)i);
+            if (target >= *lower && target <= *upper) continue;
+            if (get_target_key(target) != TARGET_UNKNOWN) continue;
+            if (target + LIBRARY_CODE_WINDOW < *lower ||
+                target > *upper + LIBRARY_CODE_WINDOW) continue;
+
+            if (target < *lower) *lower = target;
+            if (target > *upper) *upper = target;
+            grown = TRUE;
+        }
+    }
+}
+
+/*
+ * Record the vectors of a library that point away from its code (under Forbid)
+ * A vector is patched if it points into another owner's code range, into
+ * the ROM although the library runs from RAM, or, for a disk library,
+ * outside the span of its code. Vectors of a ROM library pointing to
+ * unknown memory are patched as well.
+ */
+static void check_library_vectors(struct Library *lib)
+{
+    ULONG count = lib->lib_NegSize / 6;
+    ULONG lower = 0, upper = 0;
+    BOOL spanned = FALSE;
+    LONG home;
+    ULONG i;
+
+    if (count == 0 || count > MAX_LIBRARY_VECTORS) return;
+
+    home = find_library_home(lib, count);
+    patch_list.libraries++;
+
+    for (i = 1; i <= count; i++) {
+        ULONG target;
+        LONG key;
+        PatchEntry *entry;
+        CodeRange *range;
+
+        if (*(UWORD *)((UBYTE *)lib - 6 * i) != JMP_ABS_OPCODE) continue;
+
+        patch_list.vectors++;
+        target = get_library_vector(lib, -6 * (LONG)i);
+        key = get_target_key(target);
+        if (key == home && key != TARGET_UNKNOWN) continue;
+
+        /* A second hunk of the library itself */
+        range = (key >= 0) ? &code_profile.ranges[key] : NULL;
+        if (range && range->owner == (APTR)lib) continue;
+
+        /* More code of a disk library than its code range covers */
+        if (key == TARGET_UNKNOWN && home != TARGET_ROM &&
+            *(UWORD *)((UBYTE *)lib - 6) == JMP_ABS_OPCODE) {
+            if (!spanned) {
+                get_library_span(lib, count, &lower, &upper);
+                spanned = TRUE;
+            }
+            if (target >= lower && target <= upper) continue;
+        }
+
+        patches_seen++;
+        if (patch_list.count >= patch_list.capacity) continue;
+
+        entry = &patch_list.entries[patch_list.count++];
+        entry->base = (APTR)lib;
+        entry->lvo = (WORD)(-6 * (LONG)i);
+        entry->target = target;
+        entry->library[0] = '\0';
+        entry->owner[0] = '\0';
+        if (lib->lib_Node.ln_Name) {
+            strncpy(entry->library, lib->lib_Node.ln_Name, sizeof(entry->library) - 1);
+        }
+        if (range) strncpy(entry->owner, range->name, sizeof(entry->owner) - 1);
+    }
+}
+
+static void check_library_list(struct List *list)
+{
+    struct Node *node;
+
+    for (node = list->lh_Head; node->ln_Succ != NULL; node = node->ln_Succ) {
+        check_library_vectors((struct Library *)node);
+    }
+}
+
+/*
+ * TRUE if a vector of exec is in the patch list
+ */
+static BOOL is_exec_vector_patched(WORD lvo)
+{
+    ULONG i;
+
+    for (i = 0; i < patch_list.count; i++) {
+        if (patch_list.entries[i].base == (APTR)SysBase &&
+            patch_list.entries[i].lvo == lvo) return TRUE;
+    }
+
+    return FALSE;
+}
+
+/*
+ * Find vectors that point outside their library's code and the ROM
+ * The code ranges of a finished or running CPU profile are reused so its
+ * results stay intact, otherwise they are collected now. The list is sized
+ * outside Forbid() and the scan repeated if it was too small.
+ */
+void scan_library_patches(void)
+{
+    ULONG needed = patch_list.capacity;
+    ULONG tries;
+    ULONG i;
+
+    if (!code_profile.valid && !cpu_sampler_profiling()) build_code_ranges();
+
+    for (tries = 0; tries < ARENA_SNAPSHOT_RETRIES; tries++) {
+        /* Out of memory: only what fits is recorded */
+        (void)ARENA_RESERVE_N(patch_list.entries, 0, patch_list.capacity, needed);
+
+        patch_list.count = 0;
+        patch_list.libraries = 0;
+        patch_list.vectors = 0;
+        patches_seen = 0;
+
+        timed_forbid();
+
+        check_library_list(&SysBase->LibList);
+        check_library_list(&SysBase->DeviceList);
+
+        timed_permit("library vectors");
+
+        if (patches_seen <= patch_list.capacity) break;
+        needed = patches_seen + ARENA_SNAPSHOT_SLACK;
+    }
+
+    memset(patch_list.probe_ns, 0, sizeof(patch_list.probe_ns));
+    patch_list.timed = FALSE;
+
+    for (i = 0; i < patch_list.count; i++) {
+        PatchEntry *entry = &patch_list.entries[i];
+        char *dot;
+
+        entry->library[sizeof(entry->library) - 1] = '\0';
+        entry->owner[sizeof(entry->owner) - 1] = '\0';
+        entry->location = determine_mem_location((APTR)entry->target);
+
+        /* "exec.library" -> "exec", as in the software lists */
+        dot = strrchr(entry->library, '.');
+        if (dot && dot > entry->library) *dot = '\0';
+    }
+
+    for (i = 0; i < PATCH_PROBE_COUNT; i++) {
+        patch_list.probe_patched[i] = is_exec_vector_patched(probe_lvos[i][0]) ||
+                                      is_exec_vector_patched(probe_lvos[i][1]);
+    }
+
+    if (patch_page * PATCH_PAGE_ROWS >= patch_list.count) patch_page = 0;
+
+    debug("  patches: %lu of %lu vectors in %lu libraries\n",
+          (unsigned long)patch_list.count, (unsigned long)patch_list.vectors,
+          (unsigned long)patch_list.libraries);
+}
+
+/*
+ * Time one probe, returns ns per call
+ */
+static ULONG time_patch_probe(PatchProbe probe)
+{
+    struct SignalSemaphore semaphore;
+    uint64_t start, elapsed;
+    ULONG i;
+    APTR mem;
+
+    if (probe == PATCH_PROBE_ALLOCVEC && SysBase->LibNode.lib_Version < 36) return 0;
+    if (probe == PATCH_PROBE_SEMAPHORE) InitSemaphore(&semaphore);
+
+    start = get_timer_ticks();
+    for (i = 0; i < PATCH_PROBE_CALLS; i++) {
+        switch (probe) {
+            case PATCH_PROBE_FINDTASK:
+                FindTask(NULL);
+                break;
+            case PATCH_PROBE_FORBID:
+                Forbid();
+                Permit();
+                break;
+            case PATCH_PROBE_ALLOCMEM:
+                mem = AllocMem(32, MEMF_ANY);
+                if (mem) FreeMem(mem, 32);
+                break;
+            case PATCH_PROBE_ALLOCVEC:
+                mem = AllocVec(32, MEMF_ANY);
+                if (mem) FreeVec(mem);
+                break;
+            case PATCH_PROBE_SEMAPHORE:
+                ObtainSemaphore(&semaphore);
+                ReleaseSemaphore(&semaphore);
+                break;
+            default:
+                break;
+        }
+    }
+    elapsed = get_timer_ticks() - start;
+
+    return (ULONG)(elapsed * 1000 / PATCH_PROBE_CALLS);
+}
+
+/*
+ * Time the exec probes through their current vectors
+ */
+void time_patch_probes(void)
+{
+    ULONG i;
+
+    for (i = 0; i < PATCH_PROBE_COUNT; i++) {
+        patch_list.probe_ns[i] = time_patch_probe((PatchProbe)i);
+    }
+
+    patch_list.timed = TRUE;
+}
+
+/*
+ * Draw one page of patched vectors
+ */
+static void draw_patch_rows(void)
+{
+    char buffer[40];
+    ULONG i;
+    WORD y = 56;
+
+    if (patch_list.count == 0) {
+        draw_text(PATCH_COL_LIBRARY, y, get_string(MSG_PATCH_NONE), COLOR_TEXT);
+        return;
+    }
+
+    for (i = patch_page * PATCH_PAGE_ROWS;
+         i < patch_list.count && i < (patch_page + 1) * PATCH_PAGE_ROWS; i++) {
+        const PatchEntry *entry = &patch_list.entries[i];
+
+        snprintf(buffer, sizeof(buffer), "%.*s", PATCH_NAME_CHARS, entry->library);
+        draw_text(PATCH_COL_LIBRARY, y, buffer, COLOR_TEXT);
+
+        snprintf(buffer, sizeof(buffer), "%5d", entry->lvo);
+        draw_text(PATCH_COL_LVO, y, buffer, COLOR_HIGHLIGHT);
+
+        snprintf(buffer, sizeof(buffer), "$%08lX", (unsigned long)entry->target);
+        draw_text(PATCH_COL_TARGET, y, buffer, COLOR_HIGHLIGHT);
+
+        draw_text(PATCH_COL_LOCATION, y, get_location_string(entry->location), COLOR_TEXT);
+
+        snprintf(buffer, sizeof(buffer), "%.*s", PATCH_OWNER_CHARS,
+                 entry->owner[0] ? entry->owner : "?");
+        draw_text(PATCH_COL_OWNER, y, buffer, COLOR_TEXT);
+
+        y += PATCH_ROW_HEIGHT;
+    }
+}
+
+/*
+ * Draw the probe timings, patched calls in the warning color
+ */
+static void draw_patch_probes(void)
+{
+    char buffer[48];
+    ULONG i;
+
+    for (i = 0; i < PATCH_PROBE_COUNT; i++) {
+        WORD x = (i & 1) ? PATCH_PROBE_COL2 : PATCH_COL_LIBRARY;
+        WORD y = PATCH_PROBE_Y + (WORD)(i / 2) * PATCH_ROW_HEIGHT;
+        ULONG ns = patch_list.probe_ns[i];
+
+        if (ns) {
+            snprintf(buffer, sizeof(buffer), "%-24s %4lu.%lu us%s", probe_names[i],
+                     (unsigned long)(ns / 1000), (unsigned long)(ns % 1000 / 100),
+                     patch_list.probe_patched[i] ? " *" : "");
+        } else {
+            snprintf(buffer, sizeof(buffer), "%-24s    -", probe_names[i]);
+        }
+        draw_text(x, y, buffer,
+                  patch_list.probe_patched[i] ? COLOR_BAR_YOU : COLOR_HIGHLIGHT);
+    }
+}
+
+/*
+ * Draw library patches view
+ */
+void draw_patches_view(void)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[80];
+    Button *btn;
+
+    /* Draw title panel */
+    draw_panel(20, 0, 600, 24, NULL);
+
+    SetAPen(rp, COLOR_TEXT);
+    SetBPen(rp, COLOR_PANEL_BG);
+    Move(rp, 220, 14);
+    Text(rp, (CONST_STRPTR)get_string(MSG_PATCHES),
+         strlen(get_string(MSG_PATCHES)));
+
+    /* Draw column headers */
+    SetAPen(rp, COLOR_TEXT);
+    TightText(rp, PATCH_COL_LIBRARY, 40, (CONST_STRPTR)get_string(MSG_PATCH_LIBRARY), -1, 4);
+    TightText(rp, PATCH_COL_LVO, 40, (CONST_STRPTR)get_string(MSG_PATCH_LVO), -1, 4);
+    TightText(rp, PATCH_COL_TARGET, 40, (CONST_STRPTR)get_string(MSG_PATCH_TARGET), -1, 4);
+    TightText(rp, PATCH_COL_OWNER, 40, (CONST_STRPTR)get_string(MSG_PATCH_OWNER), -1, 4);
+
+    /* Draw separator line */
+    SetAPen(rp, COLOR_BUTTON_DARK);
+    Move(rp, 20, 44);
+    Draw(rp, 628, 44);
+
+    draw_patch_rows();
+
+    /* Status line */
+    snprintf(buffer, sizeof(buffer), "%lu %s, %lu %s",
+             (unsigned long)patch_list.count, get_string(MSG_PATCH_PATCHED),
+             (unsigned long)patch_list.vectors, get_string(MSG_PATCH_CHECKED));
+    if (patch_list.timed) {
+        draw_patch_probes();
+        draw_text(PATCH_COL_LIBRARY, PATCH_STATUS_Y, buffer, COLOR_TEXT);
+    } else {
+        draw_text(PATCH_COL_LIBRARY, PATCH_STATUS_Y - PATCH_ROW_HEIGHT, buffer, COLOR_TEXT);
+        draw_text(PATCH_COL_LIBRARY, PATCH_STATUS_Y, get_string(MSG_PATCH_HINT), COLOR_TEXT);
+    }
+
+    /* Draw buttons */
+    btn = find_button(BTN_PATCH_EXIT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_PATCH_TIME);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_PATCH_NEXT);
+    if (btn) draw_button(btn);
+}
+
+/*
+ * Update buttons for library patches view
+ */
+void patches_view_update_buttons(void)
+{
+    add_button(20, 188, 60, 12,
+               get_string(MSG_BTN_EXIT), BTN_PATCH_EXIT, TRUE);
+    add_button(100, 188, 60, 12,
+               get_string(MSG_BTN_TIME), BTN_PATCH_TIME, TRUE);
+    add_button(180, 188, 60, 12,
+               get_string(MSG_BTN_NEXT), BTN_PATCH_NEXT, patch_list.count > PATCH_PAGE_ROWS);
+}
+
+/*
+ * Handle button press for library patches view
+ */
+void patches_view_handle_button(ButtonID id)
+{
+    switch (id) {
+        case BTN_PATCH_TIME:
+            time_patch_probes();
+            redraw_current_view();
+            break;
+
+        case BTN_PATCH_NEXT:
+            patch_page++;
+            if (patch_page * PATCH_PAGE_ROWS >= patch_list.count) patch_page = 0;
+            redraw_current_view();
+            break;
+
+        case BTN_PATCH_EXIT:
+            switch_to_view(VIEW_MAIN);
+            break;
+
+        default:
+            break;
+    }
+}
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Library patch detector header
+ */
+
+#ifndef PATCHES_H
+#define PATCHES_H
+
+#include "xsysinfo.h"
+
+/* Sanity limit for lib_NegSize */
+#define MAX_LIBRARY_VECTORS     1024
+
+/* Calls per probe when timing */
+#define PATCH_PROBE_CALLS       10000
+
+/* exec calls timed through their vectors */
+typedef enum {
+    PATCH_PROBE_FINDTASK,   /* FindTask(NULL) */
+    PATCH_PROBE_FORBID,     /* Forbid()/Permit() */
+    PATCH_PROBE_ALLOCMEM,   /* AllocMem()/FreeMem() */
+    PATCH_PROBE_ALLOCVEC,   /* AllocVec()/FreeVec(), V36 */
+    PATCH_PROBE_SEMAPHORE,  /* ObtainSemaphore()/ReleaseSemaphore() */
+    PATCH_PROBE_COUNT
+} PatchProbe;
+
+/* One vector pointing away from its library's code */
+typedef struct {
+    char library[32];
+    char owner[32];         /* Code range of the target, empty if unknown */
+    APTR base;
+    WORD lvo;
+    ULONG target;
+    MemoryLocation location;
+} PatchEntry;
+
+/* Patched vectors of all libraries and devices */
+typedef struct {
+    PatchEntry *entries;    /* Grown in the arena */
+    ULONG count;
+    ULONG capacity;
+    ULONG libraries;        /* Libraries and devices checked */
+    ULONG vectors;          /* Vectors checked */
+    ULONG probe_ns[PATCH_PROBE_COUNT];
+    BOOL probe_patched[PATCH_PROBE_COUNT];
+    BOOL timed;             /* TRUE once the probes ran */
+} PatchList;
+
+/* Global patch list */
+extern PatchList patch_list;
+
+/* Function prototypes */
+
+/* Find vectors that point outside their library's code and the ROM */
+void scan_library_patches(void);
+
+/* Time the exec probes through their current vectors */
+void time_patch_probes(void);
+
+/* Name of a probe */
+const char *get_patch_probe_name(PatchProbe probe);
+
+/* Draw library patches view */
+void draw_patches_view(void);
+
+#endif /* PATCHES_H */
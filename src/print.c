@@ -8,6 +8,7 @@
 #include <string.h>
 #include <stdio.h>
 
+#include <exec/memory.h>
 #include <dos/dos.h>
 #include <dos/datetime.h>
 
@@ -17,8 +18,19 @@
 #include "print.h"
 #include "hardware.h"
 #include "software.h"
+#include "tasks.h"
+#include "profile.h"
+#include "interrupts.h"
+#include "latency.h"
+#include "ipcbench.h"
+#include "patches.h"
+#include "residents.h"
+#include "loadtime.h"
 #include "benchmark.h"
 #include "memory.h"
+#include "bandwidth.h"
+#include "allocbench.h"
+#include "memtest.h"
 #include "boards.h"
 #include "drives.h"
 #include "locale_str.h"
@@ -36,6 +48,9 @@ extern DriveList drive_list;
 /* Helper macro for writing to file */
 #define WRITE_LINE(fh, str) FPuts(fh, (STRPTR)str); FPuts(fh, (STRPTR)"\n")
 
+/* Busiest code ranges listed in the report */
+#define PRINT_CODE_RANGES   16
+
 /*
  * Write a formatted line to file
  */
@@ -123,7 +138,8 @@ void export_hardware(BPTR fh)
     }
     write_formatted(fh, "%-16s %s", "MMU:", buffer);
 
-    snprintf(buffer, sizeof(buffer), "$%08lX", (unsigned long)hw_info.vbr);
+    snprintf(buffer, sizeof(buffer), "$%08lX (%s)", (unsigned long)hw_info.vbr,
+             get_location_string(determine_mem_location((APTR)hw_info.vbr)));
     write_formatted(fh, "%-16s %s", "VBR:", buffer);
 
     write_formatted(fh, "%-16s %s", "Comment:", hw_info.comment);
@@ -178,6 +194,29 @@ void export_hardware(BPTR fh)
     WRITE_LINE(fh, "");
 }
 
+/*
+ * Export one software list with footprint, open count and flags
+ */
+static void export_software_list(BPTR fh, const char *title, const SoftwareList *list)
+{
+    ULONG i;
+
+    WRITE_LINE(fh, title);
+    write_formatted(fh, "%-20s %-12s %-12s %-9s %8s %5s %s", "Name", "Location", "Address",
+                    "Version", "Size", "Opens", "Flags");
+    for (i = 0; i < list->count; i++) {
+        const SoftwareEntry *e = &list->entries[i];
+        char version[12];
+
+        snprintf(version, sizeof(version), "V%d.%d", e->version, e->revision);
+        write_formatted(fh, "%-20s %-12s $%08lX    %-9s %8lu %5u $%02X",
+                        e->name, get_location_string(e->location),
+                        (unsigned long)e->address, version, (unsigned long)e->footprint,
+                        (unsigned)e->open_count, (unsigned)e->flags);
+    }
+    WRITE_LINE(fh, "");
+}
+
 /*
  * Export software lists
  */
@@ -188,40 +227,254 @@ void export_software(BPTR fh)
     WRITE_LINE(fh, "=== SYSTEM SOFTWARE ===");
     WRITE_LINE(fh, "");
 
-    /* Libraries */
-    WRITE_LINE(fh, "--- Libraries ---");
-    write_formatted(fh, "%-20s %-12s %-12s %s", "Name", "Location", "Address", "Version");
-    for (i = 0; i < libraries_list.count; i++) {
-        SoftwareEntry *e = &libraries_list.entries[i];
-        write_formatted(fh, "%-20s %-12s $%08lX   V%d.%d",
-                        e->name, get_location_string(e->location),
-                        (unsigned long)e->address, e->version, e->revision);
+    export_software_list(fh, "--- Libraries ---", &libraries_list);
+    export_software_list(fh, "--- Devices ---", &devices_list);
+    export_software_list(fh, "--- Resources ---", &resources_list);
+
+    /* Tasks, fullest stack first */
+    enumerate_tasks();
+    WRITE_LINE(fh, "--- Tasks ---");
+    write_formatted(fh, "%-24s %-12s %-6s %4s %8s %8s", "Name", "Address", "State", "Pri",
+                    "Stack", "Used");
+    for (i = 0; i < task_list.count; i++) {
+        TaskEntry *t = &task_list.entries[i];
+        write_formatted(fh, "%-24s $%08lX    %-6s %4d %8lu %8lu %3lu%%%s",
+                        t->name, (unsigned long)t->address,
+                        get_task_state_string(t->state), t->priority,
+                        (unsigned long)t->stack_size, (unsigned long)t->stack_used,
+                        (unsigned long)get_stack_percent(t),
+                        t->is_process ? "" : " (task)");
     }
     WRITE_LINE(fh, "");
 
-    /* Devices */
-    WRITE_LINE(fh, "--- Devices ---");
-    write_formatted(fh, "%-20s %-12s %-12s %s", "Name", "Location", "Address", "Version");
-    for (i = 0; i < devices_list.count; i++) {
-        SoftwareEntry *e = &devices_list.entries[i];
-        write_formatted(fh, "%-20s %-12s $%08lX   V%d.%d",
-                        e->name, get_location_string(e->location),
-                        (unsigned long)e->address, e->version, e->revision);
+    /* Code profile of the last CPU sampler run in code mode */
+    if (code_profile.valid) {
+        UWORD busiest[PRINT_CODE_RANGES];
+        ULONG count = get_busiest_code_ranges(busiest, PRINT_CODE_RANGES);
+
+        WRITE_LINE(fh, "--- Code Profile ---");
+        write_formatted(fh, "%-32s %-12s %s", "Code", "Address", "CPU");
+        for (i = 0; i < count; i++) {
+            CodeRange *r = &code_profile.ranges[busiest[i]];
+            UWORD permille = get_profile_permille(r->samples);
+            write_formatted(fh, "%-32s $%08lX    %3u.%u%%", r->name, (unsigned long)r->lower,
+                            (unsigned)(permille / 10), (unsigned)(permille % 10));
+        }
+        write_formatted(fh, "Idle %lu, Kickstart (other) %lu, unknown %lu of %lu samples",
+                        (unsigned long)code_profile.idle, (unsigned long)code_profile.kickstart,
+                        (unsigned long)code_profile.unknown, (unsigned long)code_profile.samples);
+        WRITE_LINE(fh, "");
     }
+}
+
+/*
+ * Export interrupt handlers and servers, with timings if measured
+ */
+void export_interrupts(BPTR fh)
+{
+    ULONG i;
+
+    /* Keep the timings of the last measurement */
+    if (!int_list.timed) enumerate_interrupts();
+
+    WRITE_LINE(fh, "=== INTERRUPTS ===");
     WRITE_LINE(fh, "");
 
-    /* Resources */
-    WRITE_LINE(fh, "--- Resources ---");
-    write_formatted(fh, "%-20s %-12s %-12s %s", "Name", "Location", "Address", "Version");
-    for (i = 0; i < resources_list.count; i++) {
-        SoftwareEntry *e = &resources_list.entries[i];
-        write_formatted(fh, "%-20s %-12s $%08lX   V%d.%d",
-                        e->name, get_location_string(e->location),
-                        (unsigned long)e->address, e->version, e->revision);
+    write_formatted(fh, "%-10s %-24s %4s %-12s %-10s %8s %7s %7s", "Vector", "Server", "Pri",
+                    "Code", "Location", "Calls/s", "Avg us", "Max us");
+    for (i = 0; i < int_list.count; i++) {
+        IntEntry *e = &int_list.entries[i];
+        char vector[12];
+
+        snprintf(vector, sizeof(vector), "%u %s", get_int_level(e->vector),
+                 get_int_vector_name(e->vector));
+
+        if (e->timed) {
+            write_formatted(fh, "%-10s %-24s %4d $%08lX    %-10s %8lu %7lu %7lu",
+                            vector, e->name, e->priority, (unsigned long)e->code,
+                            get_location_string(e->location),
+                            (unsigned long)e->calls_per_sec,
+                            (unsigned long)e->avg_us, (unsigned long)e->max_us);
+        } else {
+            write_formatted(fh, "%-10s %-24s %4d $%08lX    %-10s%s",
+                            vector, e->name, e->priority, (unsigned long)e->code,
+                            get_location_string(e->location),
+                            e->server ? "" : " (handler)");
+        }
+    }
+    if (int_list.timed) {
+        write_formatted(fh, "Timed for %lu s, %lu us overhead subtracted per call",
+                        (unsigned long)INT_TIME_SECONDS, (unsigned long)int_list.overhead_us);
+    }
+    WRITE_LINE(fh, "");
+}
+
+/*
+ * Export resident modules
+ */
+void export_residents(BPTR fh)
+{
+    ULONG i;
+
+    enumerate_residents();
+
+    WRITE_LINE(fh, "=== RESIDENT MODULES ===");
+    WRITE_LINE(fh, "");
+
+    write_formatted(fh, "%-24s %3s %4s %-12s %-10s %-12s %s", "Module", "Ver", "Pri",
+                    "Address", "Location", "Speed", "Source");
+    for (i = 0; i < resident_list.count; i++) {
+        ResidentEntry *e = &resident_list.entries[i];
+        char speed[16];
+
+        format_speed(e->speed, speed, sizeof(speed));
+        write_formatted(fh, "%-24s %3u %4d $%08lX    %-10s %-12s %s", e->name, e->version,
+                        e->priority, (unsigned long)e->address,
+                        get_location_string(e->location), speed,
+                        e->source == RES_SOURCE_PENDING ? "KickTag (after reset)" :
+                        get_resident_source_string((ResidentSource)e->source));
+    }
+    write_formatted(fh, "KickMem:        %lu chunks, %lu bytes",
+                    (unsigned long)resident_list.kickmem_chunks,
+                    (unsigned long)resident_list.kickmem_bytes);
+    WRITE_LINE(fh, "");
+}
+
+/*
+ * Export patched library vectors
+ */
+void export_patches(BPTR fh)
+{
+    ULONG i;
+
+    /* Keep the timings of the last measurement */
+    if (!patch_list.timed) scan_library_patches();
+
+    WRITE_LINE(fh, "=== LIBRARY PATCHES ===");
+    WRITE_LINE(fh, "");
+
+    write_formatted(fh, "%lu of %lu vectors in %lu libraries and devices are patched",
+                    (unsigned long)patch_list.count, (unsigned long)patch_list.vectors,
+                    (unsigned long)patch_list.libraries);
+    if (patch_list.count > 0) {
+        write_formatted(fh, "%-24s %5s %-12s %-10s %s", "Library", "LVO", "Target",
+                        "Location", "Owner");
+    }
+    for (i = 0; i < patch_list.count; i++) {
+        PatchEntry *e = &patch_list.entries[i];
+
+        write_formatted(fh, "%-24s %5d $%08lX    %-10s %s", e->library, e->lvo,
+                        (unsigned long)e->target, get_location_string(e->location),
+                        e->owner[0] ? e->owner : "?");
+    }
+
+    if (patch_list.timed) {
+        WRITE_LINE(fh, "");
+        for (i = 0; i < PATCH_PROBE_COUNT; i++) {
+            ULONG ns = patch_list.probe_ns[i];
+
+            if (ns == 0) continue;
+            write_formatted(fh, "%-24s %5lu.%lu us%s", get_patch_probe_name((PatchProbe)i),
+                            (unsigned long)(ns / 1000), (unsigned long)(ns % 1000 / 100),
+                            patch_list.probe_patched[i] ? " (patched)" : "");
+        }
     }
     WRITE_LINE(fh, "");
 }
 
+/*
+ * Export one latency distribution in microseconds
+ */
+static void export_latency_stats(BPTR fh, const char *label, const LatencyStats *s)
+{
+    write_formatted(fh, "%-16s %6lu.%lu %6lu.%lu %6lu.%lu %6lu.%lu", label,
+                    (unsigned long)(s->min_ns / 1000), (unsigned long)(s->min_ns % 1000 / 100),
+                    (unsigned long)(s->avg_ns / 1000), (unsigned long)(s->avg_ns % 1000 / 100),
+                    (unsigned long)(s->p99_ns / 1000), (unsigned long)(s->p99_ns % 1000 / 100),
+                    (unsigned long)(s->max_ns / 1000), (unsigned long)(s->max_ns % 1000 / 100));
+}
+
+/*
+ * Export interrupt latency results
+ */
+void export_latency(BPTR fh)
+{
+    if (!latency_results.valid) return;
+
+    WRITE_LINE(fh, "=== INTERRUPT LATENCY ===");
+    WRITE_LINE(fh, "");
+
+    write_formatted(fh, "%-16s %8s %8s %8s %8s", "", "Min us", "Avg us", "P99 us", "Max us");
+    export_latency_stats(fh, "Interrupt entry", &latency_results.entry);
+    if (latency_results.wakeup_valid) {
+        export_latency_stats(fh, "Task wakeup", &latency_results.wakeup);
+    }
+    write_formatted(fh, "Samples:        %lu / %lu, %lu missed wakeups%s",
+                    (unsigned long)latency_results.entry.count,
+                    (unsigned long)latency_results.wakeup.count,
+                    (unsigned long)latency_results.missed,
+                    latency_results.aborted ? " (aborted)" : "");
+    write_formatted(fh, "VBR:            $%08lX (%s)", (unsigned long)latency_results.vbr,
+                    get_location_string(latency_results.vbr_location));
+    if (exception_results.valid) {
+        write_formatted(fh, "TRAP dispatch:  %lu ns", (unsigned long)exception_results.trap_ns);
+        if (exception_results.before_ns) {
+            write_formatted(fh, "Before move:    %lu ns with VBR $%08lX",
+                            (unsigned long)exception_results.before_ns,
+                            (unsigned long)exception_results.before_vbr);
+        }
+    }
+    WRITE_LINE(fh, "");
+}
+
+/*
+ * Export library load times, most expensive first
+ */
+void export_loadtime(BPTR fh)
+{
+    ULONG i;
+
+    if (!load_list.valid) return;
+
+    WRITE_LINE(fh, "=== LIBRARY LOAD TIMES ===");
+    WRITE_LINE(fh, "");
+
+    write_formatted(fh, "%-32s %10s %8s  %s", "Name", "ms", "KB", "Status");
+    for (i = 0; i < load_list.count; i++) {
+        LoadEntry *e = &load_list.entries[i];
+
+        write_formatted(fh, "%-32s %6lu.%03lu %8lu  %s", e->name,
+                        (unsigned long)(e->load_us / 1000), (unsigned long)(e->load_us % 1000),
+                        (unsigned long)((e->footprint + 1023) / 1024),
+                        get_load_status_string((LoadStatus)e->status));
+    }
+    write_formatted(fh, "Total:          %lu ms", (unsigned long)(load_list.total_us / 1000));
+    WRITE_LINE(fh, "");
+}
+
+/*
+ * Export exec IPC benchmark results
+ */
+void export_ipc(BPTR fh)
+{
+    ULONG i;
+
+    if (!ipc_results.valid) return;
+
+    WRITE_LINE(fh, "=== EXEC IPC ===");
+    WRITE_LINE(fh, "");
+
+    write_formatted(fh, "%-24s %10s %10s", "", "Ops/s", "us/op");
+    for (i = 0; i < IPC_TEST_COUNT; i++) {
+        write_formatted(fh, "%-24s %10lu %7lu.%lu", get_ipc_test_string((IpcTest)i),
+                        (unsigned long)ipc_results.ops_per_sec[i],
+                        (unsigned long)(ipc_results.ns_per_op[i] / 1000),
+                        (unsigned long)(ipc_results.ns_per_op[i] % 1000 / 100));
+    }
+    write_formatted(fh, "Context switch:          %lu ns", (unsigned long)ipc_results.switch_ns);
+    WRITE_LINE(fh, "");
+}
+
 /*
  * Export benchmark results
  */
@@ -271,6 +524,23 @@ void export_benchmarks(BPTR fh)
             write_formatted(fh, "Memory Speed:      CHIP %s  FAST %s  ROM %s MB/s",
                            chip_str, fast_str, rom_str);
         }
+
+        /* ROM bank sweep */
+        {
+            ULONG i;
+            char speed_str[16];
+
+            WRITE_LINE(fh, "");
+            WRITE_LINE(fh, "ROM Banks:");
+            for (i = 0; i < bench_results.rom_bank_count; i++) {
+                RomBank *b = &bench_results.rom_banks[i];
+                format_scaled(speed_str, sizeof(speed_str), b->speed / 10000, TRUE);
+                write_formatted(fh, "  $%08lX-$%08lX  %6s MB/s  %s",
+                                (unsigned long)b->address,
+                                (unsigned long)(b->address + ROM_BANK_SIZE - 1),
+                                speed_str, get_rom_bank_type_string(b->type));
+            }
+        }
     } else {
         WRITE_LINE(fh, "Benchmarks not run. Press SPEED button to run benchmarks.");
     }
@@ -299,6 +569,7 @@ void export_memory(BPTR fh)
 {
     ULONG i;
     char size_str[32];
+    char cache_str[64];
 
     WRITE_LINE(fh, "=== MEMORY ===");
     WRITE_LINE(fh, "");
@@ -316,11 +587,205 @@ void export_memory(BPTR fh)
         write_formatted(fh, "  Type:   %s", r->type_string);
         write_formatted(fh, "  Free:   %lu bytes", (unsigned long)r->amount_free);
         write_formatted(fh, "  Largest: %lu bytes", (unsigned long)r->largest_block);
-        write_formatted(fh, "  Chunks: %lu", (unsigned long)r->num_chunks);
+        write_formatted(fh, "  Chunks: %lu%s", (unsigned long)r->num_chunks,
+                        r->chunks_truncated ? " (list truncated)" : "");
+
+        format_cache_mode(r, cache_str, sizeof(cache_str));
+        write_formatted(fh, "  Cache:  %s%s", cache_str,
+                        region_is_uncached_fast(r) ? " (WARNING: FAST RAM uncached)" : "");
+
+        if (r->board_index >= 0) {
+            format_region_board(r, cache_str, sizeof(cache_str));
+            write_formatted(fh, "  Board:  %s", cache_str);
+        }
+
+        if (r->bus_width) {
+            format_bus_timing(r, cache_str, sizeof(cache_str));
+            write_formatted(fh, "  Bus:    %s", cache_str);
+            if (r->misaligned_ns) {
+                write_formatted(fh, "  Misaligned long: %u ns", (unsigned)r->misaligned_ns);
+            }
+        }
         WRITE_LINE(fh, "");
     }
 }
 
+/*
+ * Export free chunk histogram and free/used map of each region
+ */
+void export_fragmentation(BPTR fh)
+{
+    ULONG i, bucket, cell;
+    char range_str[24];
+    char map_line[80];
+
+    WRITE_LINE(fh, "=== MEMORY FRAGMENTATION ===");
+    WRITE_LINE(fh, "");
+
+    for (i = 0; i < memory_regions.count; i++) {
+        MemoryRegion *r = &memory_regions.regions[i];
+
+        write_formatted(fh, "Region %lu: %s", (unsigned long)(i + 1), r->node_name);
+        write_formatted(fh, "  Fragmentation: %u%% (largest block %lu of %lu bytes free)",
+                        (unsigned)r->frag_index, (unsigned long)r->largest_block,
+                        (unsigned long)r->amount_free);
+
+        WRITE_LINE(fh, "  Free chunks by size:");
+        for (bucket = 0; bucket < FRAG_HISTOGRAM_BUCKETS; bucket++) {
+            if (r->chunk_histogram[bucket] == 0) continue;
+            format_histogram_bucket(bucket, range_str, sizeof(range_str));
+            write_formatted(fh, "    %-10s %lu", range_str,
+                            (unsigned long)r->chunk_histogram[bucket]);
+        }
+
+        write_formatted(fh, "  Map $%08lX-$%08lX (. free, # used):",
+                        (unsigned long)r->lower_bound, (unsigned long)r->upper_bound);
+        for (cell = 0; cell < FRAG_MAP_CELLS; cell += 64) {
+            ULONG j;
+
+            strncpy(map_line, "    ", sizeof(map_line));
+            for (j = 0; j < 64; j++) {
+                map_line[4 + j] = region_cell_free(r, cell + j) ? '.' : '#';
+            }
+            map_line[4 + 64] = '\0';
+            WRITE_LINE(fh, map_line);
+        }
+        WRITE_LINE(fh, "");
+    }
+}
+
+/*
+ * Export cross-region copy bandwidth matrix
+ */
+void export_copy_matrix(BPTR fh)
+{
+    ULONG row, col;
+    char line[256];
+    char cell[16];
+
+    if (!copy_matrix.valid) return;
+
+    WRITE_LINE(fh, "=== COPY BANDWIDTH (MB/s, rows: source, columns: destination) ===");
+    WRITE_LINE(fh, "");
+
+    strncpy(line, "          ", sizeof(line));
+    for (col = 0; col < copy_matrix.count; col++) {
+        snprintf(cell, sizeof(cell), "%8lu", (unsigned long)(copy_matrix.region[col] + 1));
+        strncat(line, cell, sizeof(line) - strlen(line) - 1);
+    }
+    WRITE_LINE(fh, line);
+
+    for (row = 0; row < copy_matrix.count; row++) {
+        format_region_label(copy_matrix.region[row], cell, sizeof(cell));
+        snprintf(line, sizeof(line), "%-10s", cell);
+        for (col = 0; col < copy_matrix.count; col++) {
+            char speed_str[16];
+            format_copy_speed(copy_matrix.speed[row][col], speed_str, sizeof(speed_str));
+            snprintf(cell, sizeof(cell), "%8s", speed_str);
+            strncat(line, cell, sizeof(line) - strlen(line) - 1);
+        }
+        WRITE_LINE(fh, line);
+    }
+
+    WRITE_LINE(fh, "");
+    WRITE_LINE(fh, "Fastest kernel:");
+    for (row = 0; row < copy_matrix.count; row++) {
+        for (col = 0; col < copy_matrix.count; col++) {
+            if (copy_matrix.speed[row][col] == 0) continue;
+            write_formatted(fh, "  %lu -> %lu: %s",
+                            (unsigned long)(copy_matrix.region[row] + 1),
+                            (unsigned long)(copy_matrix.region[col] + 1),
+                            get_copy_kernel_string(copy_matrix.kernel[row][col]));
+        }
+    }
+
+    WRITE_LINE(fh, "");
+}
+
+/*
+ * Export allocator benchmark
+ */
+void export_alloc_benchmark(BPTR fh)
+{
+    ULONG i, kind;
+
+    if (!alloc_bench.valid) return;
+
+    WRITE_LINE(fh, "=== ALLOCATOR BENCHMARK ===");
+    WRITE_LINE(fh, "");
+
+    for (i = 0; i < alloc_bench.count; i++) {
+        AllocTypeResult *type = &alloc_bench.types[i];
+
+        for (kind = 0; kind < ALLOCATOR_COUNT; kind++) {
+            AllocResult *res = &type->result[kind];
+
+            if (res->pairs_per_sec == 0) {
+                write_formatted(fh, "%-6s %-12s n/a",
+                                (type->mem_flags & MEMF_CHIP) ? "CHIP" : "FAST",
+                                get_allocator_string((AllocatorKind)kind));
+                continue;
+            }
+            write_formatted(fh, "%-6s %-12s %8lu pairs/s, worst %lu us%s",
+                            (type->mem_flags & MEMF_CHIP) ? "CHIP" : "FAST",
+                            get_allocator_string((AllocatorKind)kind),
+                            (unsigned long)res->pairs_per_sec,
+                            (unsigned long)res->worst_us,
+                            res->failed ? " (allocations failed)" : "");
+        }
+    }
+
+    write_formatted(fh, "AllocMem() at $%08lX%s",
+                    (unsigned long)alloc_bench.allocmem_vector,
+                    allocmem_patched() ? " (patched)" : "");
+    WRITE_LINE(fh, "");
+}
+
+/*
+ * Export memory test result
+ */
+void export_memtest(BPTR fh)
+{
+    char label[32];
+    ULONG i;
+
+    if (!memtest_result.valid) return;
+
+    WRITE_LINE(fh, "=== MEMORY TEST ===");
+    WRITE_LINE(fh, "");
+
+    format_region_label(memtest_result.region, label, sizeof(label));
+    write_formatted(fh, "Region:         %s", label);
+
+    if (memtest_result.block_count == 0) {
+        WRITE_LINE(fh, "No free memory could be claimed for testing.");
+        WRITE_LINE(fh, "");
+        return;
+    }
+
+    write_formatted(fh, "Tested:         %lu bytes in %lu blocks",
+                    (unsigned long)memtest_result.tested_bytes,
+                    (unsigned long)memtest_result.block_count);
+    write_formatted(fh, "Time:           %lu s, %lu bytes/s (%s)",
+                    (unsigned long)memtest_result.seconds,
+                    (unsigned long)memtest_result.speed,
+                    memtest_result.move16 ? "move16" : "movem");
+    write_formatted(fh, "Errors:         %lu%s",
+                    (unsigned long)memtest_result.error_count,
+                    memtest_result.aborted ? " (aborted)" : "");
+
+    for (i = 0; i < memtest_result.error_count && i < MEMTEST_MAX_ERRORS; i++) {
+        MemTestError *err = &memtest_result.errors[i];
+
+        write_formatted(fh, "  $%08lX expected $%08lX read $%08lX (%s)",
+                        (unsigned long)err->address,
+                        (unsigned long)err->expected,
+                        (unsigned long)err->actual,
+                        get_memtest_pass_string((MemTestPass)err->pass));
+    }
+    WRITE_LINE(fh, "");
+}
+
 /*
  * Export expansion boards
  */
@@ -350,6 +815,28 @@ void export_boards(BPTR fh)
                         b->product_name,
                         b->manufacturer_name,
                         (long)b->serial_number);
+
+        /* Memory provided by the board */
+        if (b->memory_index >= 0) {
+            char label[32];
+            char speed[32];
+
+            format_region_label((ULONG)b->memory_index, label, sizeof(label));
+            format_region_speed(&memory_regions.regions[b->memory_index],
+                                speed, sizeof(speed));
+            write_formatted(fh, "             Memory: region %s, speed %s", label, speed);
+        }
+
+        /* Zorro throughput of memory boards */
+        if (b->speed_measured) {
+            char read[16];
+            char write[16];
+
+            format_copy_speed(b->read_speed, read, sizeof(read));
+            format_copy_speed(b->write_speed, write, sizeof(write));
+            write_formatted(fh, "             %s: read %s, write %s MB/s",
+                            get_board_type_string(b->board_type), read, write);
+        }
     }
 
     WRITE_LINE(fh, "");
@@ -410,8 +897,18 @@ BOOL export_to_file(const char *filename)
     export_header(fh);
     export_hardware(fh);
     export_software(fh);
+    export_interrupts(fh);
+    export_residents(fh);
+    export_patches(fh);
     export_benchmarks(fh);
     export_memory(fh);
+    export_fragmentation(fh);
+    export_copy_matrix(fh);
+    export_alloc_benchmark(fh);
+    export_memtest(fh);
+    export_latency(fh);
+    export_ipc(fh);
+    export_loadtime(fh);
     export_boards(fh);
     export_drives(fh);
 
@@ -23,8 +23,18 @@ BOOL export_to_file(const char *filename);
 void export_header(BPTR fh);
 void export_hardware(BPTR fh);
 void export_software(BPTR fh);
+void export_interrupts(BPTR fh);
+void export_patches(BPTR fh);
+void export_residents(BPTR fh);
 void export_benchmarks(BPTR fh);
 void export_memory(BPTR fh);
+void export_fragmentation(BPTR fh);
+void export_copy_matrix(BPTR fh);
+void export_alloc_benchmark(BPTR fh);
+void export_memtest(BPTR fh);
+void export_latency(BPTR fh);
+void export_loadtime(BPTR fh);
+void export_ipc(BPTR fh);
 void export_boards(BPTR fh);
 void export_drives(BPTR fh);
 
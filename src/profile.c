@@ -0,0 +1,449 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Program counter profile
+ *
+ * The CPU sampler records the interrupted program counter; this module
+ * maps each one to a range of code. Ranges come from the resident
+ * modules (ROM and modules added by SetPatch/LoadModule), from the vector
+ * tables of libraries, devices and resources loaded from disk, and from
+ * the seglists of processes.
+ */
+
+#include <string.h>
+
+#include <exec/execbase.h>
+#include <exec/resident.h>
+#include <exec/tasks.h>
+#include <dos/dosextens.h>
+
+#include <proto/exec.h>
+
+#include "xsysinfo.h"
+#include "profile.h"
+#include "software.h"
+#include "benchmark.h"
+#include "arena.h"
+#include "debug.h"
+
+/* Global code profile */
+CodeProfile code_profile;
+
+/* Sanity limits for structures read from memory */
+#define MAX_MODULE_SIZE     (1024 * 1024)
+#define MAX_HUNK_SIZE       (16 * 1024 * 1024)
+#define MAX_PROCESS_HUNKS   32
+
+/* JMP absolute.l opcode of a library vector */
+#define JMP_ABS_OPCODE      0x4EF9
+
+/* Ranges found by the last walk, including those that did not fit */
+static ULONG ranges_seen;
+
+/* External references */
+extern struct ExecBase *SysBase;
+
+/*
+ * Add a range (under Forbid), names are copied from the node
+ */
+static CodeRange *add_code_range(ULONG lower, ULONG upper, APTR owner,
+                                 const char *name, CodeKind kind)
+{
+    CodeRange *range;
+
+    if (upper <= lower) return NULL;
+
+    ranges_seen++;
+    if (code_profile.count >= code_profile.capacity) return NULL;
+
+    range = &code_profile.ranges[code_profile.count++];
+    range->lower = lower;
+    range->upper = upper;
+    range->owner = owner;
+    range->kind = (UBYTE)kind;
+    range->samples = 0;
+    range->name[0] = '\0';
+    if (name) strncpy(range->name, name, sizeof(range->name) - 1);
+
+    return range;
+}
+
+/*
+ * Range containing an address, linear search while building
+ */
+static CodeRange *find_range_linear(ULONG address)
+{
+    ULONG i;
+
+    for (i = 0; i < code_profile.count; i++) {
+        CodeRange *range = &code_profile.ranges[i];
+        if (address >= range->lower && address < range->upper) return range;
+    }
+
+    return NULL;
+}
+
+/*
+ * Resident modules: from the tag to rt_EndSkip
+ */
+static void add_resident_modules(void)
+{
+    ULONG *res = (ULONG *)SysBase->ResModules;
+
+    if (!res) return;
+
+    while (*res) {
+        struct Resident *rt;
+
+        if (*res & 0x80000000) {
+            /* Link to the next ResModules array */
+            res = (ULONG *)(*res & 0x7FFFFFFF);
+            continue;
+        }
+
+        rt = (struct Resident *)*res;
+        if ((ULONG)rt->rt_EndSkip > (ULONG)rt &&
+            (ULONG)rt->rt_EndSkip - (ULONG)rt <= MAX_MODULE_SIZE) {
+            add_code_range((ULONG)rt, (ULONG)rt->rt_EndSkip, NULL,
+                           (const char *)rt->rt_Name, CODE_MODULE);
+        }
+        res++;
+    }
+}
+
+/*
+ * Library, device or resource code
+ * Code inside a resident module makes the library that module's owner.
+ * Otherwise the library was loaded from disk; its seglist is not
+ * reachable from the base, so the range spans the vector targets close
+ * to the first vector. Vectors patched to far away code are left out.
+ */
+static void add_library_code(struct Library *lib)
+{
+    ULONG count = lib->lib_NegSize / 6;
+    ULONG first, lower, upper, i;
+    CodeRange *range;
+
+    if (count == 0 || *(UWORD *)((UBYTE *)lib - 6) != JMP_ABS_OPCODE) return;
+
+    first = get_library_vector(lib, -6);
+
+    range = find_range_linear(first);
+    if (range) {
+        if (range->kind == CODE_MODULE && !range->owner) range->owner = (APTR)lib;
+        return;
+    }
+
+    lower = upper = first;
+    for (i = 2; i <= count; i++) {
+        ULONG target;
+
+        if (*(UWORD *)((UBYTE *)lib - 6 * i) != JMP_ABS_OPCODE) continue;
+
+        target = get_library_vector(lib, -6 * (LONG)i);
+        if (target + LIBRARY_CODE_WINDOW < first ||
+            target > first + LIBRARY_CODE_WINDOW) continue;
+
+        if (target < lower) lower = target;
+        if (target > upper) upper = target;
+    }
+
+    add_code_range(lower, upper + LIBRARY_CODE_SLACK, (APTR)lib,
+                   lib->lib_Node.ln_Name, CODE_LIBRARY);
+}
+
+static void add_library_list(struct List *list)
+{
+    struct Node *node;
+
+    for (node = list->lh_Head; node->ln_Succ != NULL; node = node->ln_Succ) {
+        add_library_code((struct Library *)node);
+    }
+}
+
+/*
+ * Hunks of a seglist, each BPTR points past the hunk's size longword
+ */
+static void add_seglist(BPTR seglist, struct Task *task)
+{
+    ULONG hunks = 0;
+
+    while (seglist && hunks++ < MAX_PROCESS_HUNKS) {
+        ULONG *hunk = (ULONG *)BADDR(seglist);
+        ULONG size = hunk[-1];
+
+        if (size <= 8 || size > MAX_HUNK_SIZE) return;
+
+        add_code_range((ULONG)(hunk + 1), (ULONG)hunk - 4 + size, (APTR)task,
+                       task->tc_Node.ln_Name, CODE_TASK);
+        seglist = (BPTR)hunk[0];
+    }
+}
+
+/*
+ * Code of a process: the running command of a shell, else the
+ * program segment of its seglist array
+ */
+static void add_process_code(struct Task *task)
+{
+    struct Process *pr = (struct Process *)task;
+
+    if (task->tc_Node.ln_Type != NT_PROCESS) return;
+
+    if (pr->pr_CLI) {
+        struct CommandLineInterface *cli = BADDR(pr->pr_CLI);
+        if (cli->cli_Module) {
+            add_seglist(cli->cli_Module, task);
+            return;
+        }
+    }
+
+    if (pr->pr_SegList) {
+        BPTR *array = (BPTR *)BADDR(pr->pr_SegList);
+        if (array[0] >= 3 && array[0] <= 16) add_seglist(array[3], task);
+    }
+}
+
+/* Comparison for sorting: lowest address first */
+static int compare_ranges(const CodeRange *a, const CodeRange *b)
+{
+    if (a->lower != b->lower) return a->lower < b->lower ? -1 : 1;
+    return 0;
+}
+
+/*
+ * Collect resident modules, library code and process seglists
+ * Ranges end up sorted and clipped so that none overlaps the next,
+ * which lets profile_add_sample() use a binary search. The array is
+ * sized outside Forbid() and the walk repeated if it was too small.
+ */
+void build_code_ranges(void)
+{
+    struct Node *node;
+    ULONG needed = code_profile.capacity;
+    ULONG tries;
+    ULONG i, j;
+
+    for (tries = 0; tries < ARENA_SNAPSHOT_RETRIES; tries++) {
+        CodeRange *ranges;
+        ULONG capacity;
+
+        /* Out of memory: only what fits is collected */
+        (void)ARENA_RESERVE_N(code_profile.ranges, 0, code_profile.capacity, needed);
+
+        ranges = code_profile.ranges;
+        capacity = code_profile.capacity;
+        memset(&code_profile, 0, sizeof(code_profile));
+        code_profile.ranges = ranges;
+        code_profile.capacity = capacity;
+        ranges_seen = 0;
+
+        timed_forbid();
+
+        add_resident_modules();
+
+        /* Process code before libraries so a library does not claim it */
+        add_process_code(SysBase->ThisTask);
+        for (node = SysBase->TaskReady.lh_Head; node->ln_Succ != NULL; node = node->ln_Succ) {
+            add_process_code((struct Task *)node);
+        }
+        for (node = SysBase->TaskWait.lh_Head; node->ln_Succ != NULL; node = node->ln_Succ) {
+            add_process_code((struct Task *)node);
+        }
+
+        add_library_list(&SysBase->LibList);
+        add_library_list(&SysBase->DeviceList);
+        add_library_list(&SysBase->ResourceList);
+
+        timed_permit("code ranges");
+
+        if (ranges_seen <= code_profile.capacity) break;
+        needed = ranges_seen + ARENA_SNAPSHOT_SLACK;
+    }
+
+    for (i = 0; i < code_profile.count; i++) {
+        code_profile.ranges[i].name[sizeof(code_profile.ranges[i].name) - 1] = '\0';
+    }
+
+    /* Simple bubble sort - OK for small lists */
+    for (i = 0; i + 1 < code_profile.count; i++) {
+        for (j = 0; j < code_profile.count - i - 1; j++) {
+            if (compare_ranges(&code_profile.ranges[j], &code_profile.ranges[j + 1]) > 0) {
+                CodeRange temp = code_profile.ranges[j];
+                code_profile.ranges[j] = code_profile.ranges[j + 1];
+                code_profile.ranges[j + 1] = temp;
+            }
+        }
+    }
+
+    for (i = 0; i + 1 < code_profile.count; i++) {
+        if (code_profile.ranges[i].upper > code_profile.ranges[i + 1].lower) {
+            code_profile.ranges[i].upper = code_profile.ranges[i + 1].lower;
+        }
+    }
+
+    debug("  profile: %lu code ranges\n", (unsigned long)code_profile.count);
+}
+
+/*
+ * Count one sampled program counter, idle samples have no owner
+ */
+void profile_add_sample(ULONG pc, BOOL idle)
+{
+    CodeRange *range;
+
+    code_profile.samples++;
+
+    if (idle) {
+        code_profile.idle++;
+        return;
+    }
+
+    range = find_code_range(pc);
+    if (range) {
+        range->samples++;
+    } else if (is_rom_address(pc)) {
+        code_profile.kickstart++;
+    } else {
+        code_profile.unknown++;
+    }
+}
+
+/*
+ * Range containing an address, NULL if none does
+ */
+CodeRange *find_code_range(ULONG address)
+{
+    ULONG lo = 0, hi = code_profile.count;
+
+    /* Last range starting at or below the address */
+    while (lo < hi) {
+        ULONG mid = (lo + hi) / 2;
+
+        if (code_profile.ranges[mid].lower <= address) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo > 0 && address < code_profile.ranges[lo - 1].upper) {
+        return &code_profile.ranges[lo - 1];
+    }
+
+    return NULL;
+}
+
+/*
+ * TRUE for an address in the Kickstart or extended ROM
+ */
+BOOL is_rom_address(ULONG address)
+{
+    return (address >= KICKSTART_ROM_BASE && address < KICKSTART_ROM_BASE + KICKSTART_ROM_SIZE) ||
+           (address >= EXTENDED_ROM_BASE && address < EXTENDED_ROM_BASE + EXTENDED_ROM_SIZE);
+}
+
+/*
+ * Share of a sample count in permille of all samples
+ */
+UWORD get_profile_permille(ULONG samples)
+{
+    ULONG total = code_profile.samples;
+
+    if (total == 0) return 0;
+    if (total > 1000000) return (UWORD)(samples / (total / 1000));
+    return (UWORD)(samples * 1000 / total);
+}
+
+/*
+ * Bytes of RAM code owned by a library, device or resource
+ * Code in the ROM takes no memory and is not counted.
+ */
+ULONG get_owner_code_size(APTR owner)
+{
+    ULONG size = 0;
+    ULONG i;
+
+    for (i = 0; i < code_profile.count; i++) {
+        const CodeRange *range = &code_profile.ranges[i];
+
+        if (range->owner == owner && range->kind != CODE_TASK && !is_rom_address(range->lower)) {
+            size += range->upper - range->lower;
+        }
+    }
+
+    return size;
+}
+
+/*
+ * Add a range's share to the software entry of its owner
+ */
+static void credit_owner(const CodeRange *range)
+{
+    SoftwareList *lists[3];
+    ULONG l, i;
+
+    lists[0] = &libraries_list;
+    lists[1] = &devices_list;
+    lists[2] = &resources_list;
+
+    for (l = 0; l < 3; l++) {
+        for (i = 0; i < lists[l]->count; i++) {
+            SoftwareEntry *entry = &lists[l]->entries[i];
+
+            if (entry->address == range->owner) {
+                entry->cpu_permille += get_profile_permille(range->samples);
+                return;
+            }
+        }
+    }
+}
+
+/*
+ * Store each owner's share in the software lists
+ */
+void finish_code_profile(void)
+{
+    ULONG i;
+
+    for (i = 0; i < libraries_list.count; i++) libraries_list.entries[i].cpu_permille = 0;
+    for (i = 0; i < devices_list.count; i++) devices_list.entries[i].cpu_permille = 0;
+    for (i = 0; i < resources_list.count; i++) resources_list.entries[i].cpu_permille = 0;
+
+    for (i = 0; i < code_profile.count; i++) {
+        const CodeRange *range = &code_profile.ranges[i];
+
+        if (range->owner && range->kind != CODE_TASK && range->samples) {
+            credit_owner(range);
+        }
+    }
+
+    code_profile.valid = (code_profile.samples > 0);
+}
+
+/*
+ * Indices of the busiest ranges, returns how many were stored
+ */
+ULONG get_busiest_code_ranges(UWORD *indices, ULONG max)
+{
+    ULONG stored = 0;
+    ULONG i, j;
+
+    for (i = 0; i < code_profile.count; i++) {
+        ULONG samples = code_profile.ranges[i].samples;
+
+        if (samples == 0) continue;
+
+        /* Insert into the sorted top list */
+        for (j = stored; j > 0 && code_profile.ranges[indices[j - 1]].samples < samples; j--) {
+            if (j < max) indices[j] = indices[j - 1];
+        }
+        if (j < max) {
+            indices[j] = (UWORD)i;
+            if (stored < max) stored++;
+        }
+    }
+
+    return stored;
+}
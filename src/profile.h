@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Program counter profile header
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "xsysinfo.h"
+
+/* Disk libraries: vector targets within this distance of the first
+ * vector belong to the library, the last function gets some slack */
+#define LIBRARY_CODE_WINDOW     (64 * 1024)
+#define LIBRARY_CODE_SLACK      1024
+
+/* Kind of a code range */
+typedef enum {
+    CODE_MODULE,            /* Resident module (ROM or loaded by SetPatch) */
+    CODE_LIBRARY,           /* Library, device or resource found by vectors */
+    CODE_TASK               /* Hunk of a process' seglist */
+} CodeKind;
+
+/* One range of code */
+typedef struct {
+    ULONG lower;
+    ULONG upper;            /* First address past the code */
+    APTR owner;             /* Library base or task, NULL if unknown */
+    char name[32];
+    UBYTE kind;             /* CodeKind */
+    ULONG samples;
+} CodeRange;
+
+/* Samples bucketed by code range */
+typedef struct {
+    CodeRange *ranges;      /* Grown in the arena */
+    ULONG count;            /* Sorted by lower address */
+    ULONG capacity;
+    ULONG samples;
+    ULONG idle;             /* Exec was idle */
+    ULONG kickstart;        /* In the ROM but no module covers it */
+    ULONG unknown;
+    BOOL valid;             /* TRUE once a profile finished */
+} CodeProfile;
+
+/* Global code profile */
+extern CodeProfile code_profile;
+
+/* Function prototypes */
+
+/* Collect resident modules, library code and process seglists */
+void build_code_ranges(void);
+
+/* Count one sampled program counter, idle samples have no owner */
+void profile_add_sample(ULONG pc, BOOL idle);
+
+/* Range containing an address, NULL if none does */
+CodeRange *find_code_range(ULONG address);
+
+/* TRUE for an address in the Kickstart or extended ROM */
+BOOL is_rom_address(ULONG address);
+
+/* Bytes of RAM code owned by a library, device or resource */
+ULONG get_owner_code_size(APTR owner);
+
+/* Store each owner's share in the software lists */
+void finish_code_profile(void);
+
+/* Indices of the busiest ranges, returns how many were stored */
+ULONG get_busiest_code_ranges(UWORD *indices, ULONG max);
+
+/* Share of a sample count in permille of all samples */
+UWORD get_profile_permille(ULONG samples);
+
+#endif /* PROFILE_H */
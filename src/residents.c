@@ -0,0 +1,340 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Resident module list and view
+ *
+ * Modules come from SysBase->ResModules, the modules exec found at boot,
+ * and from KickTagPtr, the reset-proof modules added by LoadModule or a
+ * soft-kick tool. Each module's memory location and the read speed of
+ * that memory show which modules still run from slow ROM.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/execbase.h>
+#include <exec/memory.h>
+#include <exec/resident.h>
+
+#include <proto/exec.h>
+#include <proto/graphics.h>
+
+#include "xsysinfo.h"
+#include "residents.h"
+#include "profile.h"
+#include "memory.h"
+#include "benchmark.h"
+#include "gui.h"
+#include "locale_str.h"
+#include "arena.h"
+#include "debug.h"
+
+/* Global resident module list */
+ResidentList resident_list;
+
+/* View layout */
+#define RES_COL_NAME        28
+#define RES_COL_VERSION     212
+#define RES_COL_PRI         252
+#define RES_COL_ADDRESS     292
+#define RES_COL_LOCATION    372
+#define RES_COL_SPEED       444
+#define RES_COL_SOURCE      540
+#define RES_ROW_HEIGHT      8
+#define RES_PAGE_ROWS       15
+#define RES_STATUS_Y        180
+#define RES_NAME_CHARS      22
+
+/* Sanity limit for the KickMemPtr chain */
+#define MAX_KICKMEM_LISTS   64
+
+static ULONG res_page = 0;
+
+/* Modules found by the last walk, including those that did not fit */
+static ULONG residents_seen;
+
+/* External references */
+extern struct ExecBase *SysBase;
+extern AppContext *app;
+
+/*
+ * Short name of a module source
+ */
+const char *get_resident_source_string(ResidentSource source)
+{
+    switch (source) {
+        case RES_SOURCE_ROM:
+            return "ROM";
+        case RES_SOURCE_KICKTAG:
+            return "KickTag";
+        case RES_SOURCE_PENDING:
+            return get_string(MSG_RES_PENDING);
+        case RES_SOURCE_RAM:
+            return "RAM";
+        default:
+            return "---";
+    }
+}
+
+/*
+ * Entry of a module already in the list
+ */
+static ResidentEntry *find_resident(struct Resident *rt)
+{
+    ULONG i;
+
+    for (i = 0; i < resident_list.count; i++) {
+        if (resident_list.entries[i].address == (APTR)rt) return &resident_list.entries[i];
+    }
+
+    return NULL;
+}
+
+/*
+ * Add the modules of a ResModules style array (under Forbid)
+ * Entries with bit 31 set link to the next array.
+ */
+static void add_resident_array(ULONG *res, BOOL kicktags)
+{
+    while (res && *res) {
+        struct Resident *rt;
+        ResidentEntry *entry;
+
+        if (*res & 0x80000000) {
+            res = (ULONG *)(*res & 0x7FFFFFFF);
+            continue;
+        }
+
+        rt = (struct Resident *)*res++;
+        if (rt->rt_MatchWord != RTC_MATCHWORD || rt->rt_MatchTag != rt) continue;
+
+        entry = find_resident(rt);
+        if (entry) {
+            if (kicktags && entry->source != RES_SOURCE_ROM) {
+                entry->source = RES_SOURCE_KICKTAG;
+            }
+            continue;
+        }
+
+        residents_seen++;
+        if (resident_list.count >= resident_list.capacity) continue;
+
+        entry = &resident_list.entries[resident_list.count++];
+        entry->address = (APTR)rt;
+        entry->version = rt->rt_Version;
+        entry->priority = rt->rt_Pri;
+        entry->name[0] = '\0';
+        if (rt->rt_Name) strncpy(entry->name, (const char *)rt->rt_Name, sizeof(entry->name) - 1);
+
+        if (kicktags) {
+            entry->source = RES_SOURCE_PENDING;
+        } else if (is_rom_address((ULONG)rt)) {
+            entry->source = RES_SOURCE_ROM;
+        } else {
+            entry->source = RES_SOURCE_RAM;
+        }
+    }
+}
+
+/*
+ * Read speed of the memory an address lies in, 0 if not measured
+ */
+static ULONG get_address_speed(ULONG address, MemoryLocation location)
+{
+    ULONG i;
+
+    if (is_rom_address(address)) {
+        for (i = 0; i < bench_results.rom_bank_count; i++) {
+            const RomBank *bank = &bench_results.rom_banks[i];
+            if (address >= bank->address && address < bank->address + ROM_BANK_SIZE) {
+                return bank->speed;
+            }
+        }
+        return bench_results.rom_speed;
+    }
+
+    for (i = 0; i < memory_regions.count; i++) {
+        const MemoryRegion *region = &memory_regions.regions[i];
+
+        if (address >= (ULONG)region->start_address && address < (ULONG)region->end_address &&
+            region->speed_measured) {
+            return region->speed_bytes_sec;
+        }
+    }
+
+    return (location == LOC_CHIP_RAM) ? bench_results.chip_speed : bench_results.fast_speed;
+}
+
+/*
+ * Snapshot SysBase->ResModules and the KickMem/KickTag chains
+ * The list is sized outside Forbid() and the walk repeated if it was
+ * too small.
+ */
+void enumerate_residents(void)
+{
+    struct MemList *ml;
+    ULONG needed = resident_list.capacity;
+    ULONG lists;
+    ULONG tries;
+    ULONG i;
+
+    for (tries = 0; tries < ARENA_SNAPSHOT_RETRIES; tries++) {
+        /* Out of memory: only what fits is copied */
+        (void)ARENA_RESERVE_N(resident_list.entries, 0, resident_list.capacity, needed);
+
+        resident_list.count = 0;
+        resident_list.kickmem_chunks = 0;
+        resident_list.kickmem_bytes = 0;
+        residents_seen = 0;
+        lists = 0;
+
+        timed_forbid();
+
+        add_resident_array((ULONG *)SysBase->ResModules, FALSE);
+        add_resident_array((ULONG *)SysBase->KickTagPtr, TRUE);
+
+        for (ml = (struct MemList *)SysBase->KickMemPtr; ml && lists < MAX_KICKMEM_LISTS;
+             ml = (struct MemList *)ml->ml_Node.ln_Succ, lists++) {
+            for (i = 0; i < ml->ml_NumEntries; i++) {
+                resident_list.kickmem_chunks++;
+                resident_list.kickmem_bytes += ml->ml_ME[i].me_Length;
+            }
+        }
+
+        timed_permit("resident modules");
+
+        if (residents_seen <= resident_list.capacity) break;
+        needed = residents_seen + ARENA_SNAPSHOT_SLACK;
+    }
+
+    for (i = 0; i < resident_list.count; i++) {
+        ResidentEntry *entry = &resident_list.entries[i];
+
+        entry->name[sizeof(entry->name) - 1] = '\0';
+        entry->location = determine_mem_location(entry->address);
+        entry->speed = get_address_speed((ULONG)entry->address, entry->location);
+    }
+
+    if (res_page * RES_PAGE_ROWS >= resident_list.count) res_page = 0;
+
+    debug("  residents: %lu modules, %lu KickMem chunks\n",
+          (unsigned long)resident_list.count, (unsigned long)resident_list.kickmem_chunks);
+}
+
+/*
+ * Draw one page of modules
+ */
+static void draw_resident_rows(void)
+{
+    char buffer[32];
+    ULONG i;
+    WORD y = 56;
+
+    for (i = res_page * RES_PAGE_ROWS;
+         i < resident_list.count && i < (res_page + 1) * RES_PAGE_ROWS; i++) {
+        const ResidentEntry *entry = &resident_list.entries[i];
+
+        snprintf(buffer, sizeof(buffer), "%.*s", RES_NAME_CHARS, entry->name);
+        draw_text(RES_COL_NAME, y, buffer, COLOR_TEXT);
+
+        snprintf(buffer, sizeof(buffer), "%3u", entry->version);
+        draw_text(RES_COL_VERSION, y, buffer, COLOR_HIGHLIGHT);
+
+        snprintf(buffer, sizeof(buffer), "%4d", entry->priority);
+        draw_text(RES_COL_PRI, y, buffer, COLOR_HIGHLIGHT);
+
+        snprintf(buffer, sizeof(buffer), "$%08lX", (unsigned long)entry->address);
+        draw_text(RES_COL_ADDRESS, y, buffer, COLOR_HIGHLIGHT);
+
+        draw_text(RES_COL_LOCATION, y, get_location_string(entry->location), COLOR_TEXT);
+
+        format_speed(entry->speed, buffer, sizeof(buffer));
+        draw_text(RES_COL_SPEED, y, buffer, COLOR_HIGHLIGHT);
+
+        draw_text(RES_COL_SOURCE, y, get_resident_source_string((ResidentSource)entry->source),
+                  COLOR_TEXT);
+
+        y += RES_ROW_HEIGHT;
+    }
+}
+
+/*
+ * Draw resident modules view
+ */
+void draw_residents_view(void)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[80];
+    Button *btn;
+
+    /* Draw title panel */
+    draw_panel(20, 0, 600, 24, NULL);
+
+    SetAPen(rp, COLOR_TEXT);
+    SetBPen(rp, COLOR_PANEL_BG);
+    Move(rp, 220, 14);
+    Text(rp, (CONST_STRPTR)get_string(MSG_RESIDENTS),
+         strlen(get_string(MSG_RESIDENTS)));
+
+    /* Draw column headers */
+    SetAPen(rp, COLOR_TEXT);
+    TightText(rp, RES_COL_NAME, 40, (CONST_STRPTR)get_string(MSG_RES_MODULE), -1, 4);
+    TightText(rp, RES_COL_VERSION, 40, (CONST_STRPTR)get_string(MSG_RES_VERSION), -1, 4);
+    TightText(rp, RES_COL_PRI, 40, (CONST_STRPTR)get_string(MSG_INT_PRI), -1, 4);
+    TightText(rp, RES_COL_ADDRESS, 40, (CONST_STRPTR)get_string(MSG_RES_ADDRESS), -1, 4);
+    TightText(rp, RES_COL_SPEED, 40, (CONST_STRPTR)get_string(MSG_RES_SPEED), -1, 4);
+    TightText(rp, RES_COL_SOURCE, 40, (CONST_STRPTR)get_string(MSG_RES_SOURCE), -1, 4);
+
+    /* Draw separator line */
+    SetAPen(rp, COLOR_BUTTON_DARK);
+    Move(rp, 20, 44);
+    Draw(rp, 628, 44);
+
+    draw_resident_rows();
+
+    /* Status line */
+    snprintf(buffer, sizeof(buffer), "%lu %s, KickMem: %lu / %lu KB",
+             (unsigned long)resident_list.count, get_string(MSG_RES_MODULES),
+             (unsigned long)resident_list.kickmem_chunks,
+             (unsigned long)(resident_list.kickmem_bytes / 1024));
+    draw_text(RES_COL_NAME, RES_STATUS_Y, buffer, COLOR_TEXT);
+
+    /* Draw buttons */
+    btn = find_button(BTN_RES_EXIT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_RES_NEXT);
+    if (btn) draw_button(btn);
+}
+
+/*
+ * Update buttons for resident modules view
+ */
+void residents_view_update_buttons(void)
+{
+    add_button(20, 188, 60, 12,
+               get_string(MSG_BTN_EXIT), BTN_RES_EXIT, TRUE);
+    add_button(100, 188, 60, 12,
+               get_string(MSG_BTN_NEXT), BTN_RES_NEXT, resident_list.count > RES_PAGE_ROWS);
+}
+
+/*
+ * Handle button press for resident modules view
+ */
+void residents_view_handle_button(ButtonID id)
+{
+    switch (id) {
+        case BTN_RES_NEXT:
+            res_page++;
+            if (res_page * RES_PAGE_ROWS >= resident_list.count) res_page = 0;
+            redraw_current_view();
+            break;
+
+        case BTN_RES_EXIT:
+            switch_to_view(VIEW_MAIN);
+            break;
+
+        default:
+            break;
+    }
+}
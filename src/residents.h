@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Resident module list header
+ */
+
+#ifndef RESIDENTS_H
+#define RESIDENTS_H
+
+#include "xsysinfo.h"
+
+/* Where a module comes from */
+typedef enum {
+    RES_SOURCE_ROM,         /* Kickstart or extended ROM */
+    RES_SOURCE_KICKTAG,     /* Reset-proof, from KickTagPtr (LoadModule, soft-kick) */
+    RES_SOURCE_PENDING,     /* In KickTagPtr only, active after the next reset */
+    RES_SOURCE_RAM          /* Other RAM module */
+} ResidentSource;
+
+/* One resident module */
+typedef struct {
+    char name[32];
+    APTR address;           /* struct Resident */
+    UBYTE version;
+    BYTE priority;
+    UBYTE source;           /* ResidentSource */
+    MemoryLocation location;
+    ULONG speed;            /* Read speed of its memory in bytes/sec, 0 if unknown */
+} ResidentEntry;
+
+/* Resident modules in ResModules order, pending ones last */
+typedef struct {
+    ResidentEntry *entries; /* Grown in the arena */
+    ULONG count;
+    ULONG capacity;
+    ULONG kickmem_chunks;   /* KickMemPtr entries */
+    ULONG kickmem_bytes;
+} ResidentList;
+
+/* Global resident module list */
+extern ResidentList resident_list;
+
+/* Function prototypes */
+
+/* Snapshot SysBase->ResModules and the KickMem/KickTag chains */
+void enumerate_residents(void);
+
+/* Short name of a module source */
+const char *get_resident_source_string(ResidentSource source);
+
+/* Draw resident modules view */
+void draw_residents_view(void);
+
+#endif /* RESIDENTS_H */
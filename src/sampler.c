@@ -0,0 +1,674 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - CPU usage sampler and view
+ *
+ * A CIA-B timer interrupt records SysBase->ThisTask into a ring buffer at
+ * a fixed rate. The interrupt does nothing else, so sampling can stay on
+ * while real workloads run. Once per second the main loop drains the ring
+ * into a per-second bucket; the view shows the buckets of a sliding window.
+ *
+ * In code mode the level-6 autovector is patched as well: a short stub
+ * saves the program counter the interrupt stacked, and the timer
+ * interrupt records it next to the task. The main loop attributes each
+ * program counter to a code range (profile.c).
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <exec/execbase.h>
+#include <exec/interrupts.h>
+#include <exec/memory.h>
+#include <exec/tasks.h>
+#include <resources/cia.h>
+
+#include <proto/exec.h>
+#include <proto/dos.h>
+#include <proto/graphics.h>
+
+#include "xsysinfo.h"
+#include "sampler.h"
+#include "tasks.h"
+#include "profile.h"
+#include "hardware.h"
+#include "benchmark.h"
+#include "gui.h"
+#include "locale_str.h"
+#include "debug.h"
+
+/* Global CPU usage */
+CpuUsage cpu_usage;
+
+/* Level-6 autovector (CIA-B, INT6), offset from the VBR */
+#define LEVEL6_VECTOR       (0x78 / 4)
+
+/* View layout */
+#define CPU_COL_TASK        28
+#define CPU_COL_PERCENT     300
+#define CPU_COL_BAR         360
+#define CPU_BAR_WIDTH       252
+#define CPU_STATUS_Y        176
+#define CPU_CODE_ROWS       8
+
+/* Selectable sample rates */
+static const UWORD sampler_rates[SAMPLER_RATE_COUNT] = { 100, 500, 1000, 2000 };
+static ULONG sampler_rate_index = SAMPLER_DEFAULT_RATE;
+
+/* Written by the interrupt */
+static APTR *sampler_ring = NULL;
+static ULONG *sampler_pc_ring = NULL;       /* Only in code mode */
+static volatile ULONG sampler_head = 0;     /* Samples taken so far */
+
+/* Consumer state */
+static ULONG sampler_tail = 0;
+static ULONG sampler_last_idle = 0;
+static CpuSecond cpu_seconds[CPU_WINDOW_SECONDS];
+static ULONG cpu_second_count = 0;
+
+/* Claimed timer */
+static WORD sampler_timer = -1;             /* CIAICRB_TA/TB while claimed */
+static BOOL sampler_enabled = FALSE;
+static BOOL sampler_code_mode = FALSE;
+static BOOL level6_patched = FALSE;
+
+/* Shared with the level-6 stub below */
+volatile ULONG sampler_last_pc = 0;
+ULONG sampler_old_level6 = 0;
+
+/* External references */
+extern struct ExecBase *SysBase;
+extern AppContext *app;
+
+/*
+ * Level-6 stub: save the stacked program counter and continue with the
+ * original handler. The PC follows the status register in every stack
+ * frame format, so 2(sp) works on all CPUs.
+ */
+void sampler_level6(void);
+
+__asm__(
+    "    .text\n"
+    "    .even\n"
+    "    .globl _sampler_level6\n"
+    "_sampler_level6:\n"
+    "    move.l  2(sp),_sampler_last_pc\n"
+    "    move.l  _sampler_old_level6,-(sp)\n"
+    "    rts\n"
+);
+
+/*
+ * Timer interrupt: record the running task, NULL while exec is idle
+ * Exec leaves ThisTask pointing at the last task when nothing is ready,
+ * but that task is no longer in TS_RUN.
+ */
+static void sampler_interrupt(void)
+{
+    struct Task *task = SysBase->ThisTask;
+    ULONG slot = sampler_head & (SAMPLER_RING - 1);
+
+    sampler_ring[slot] = (task->tc_State == TS_RUN) ? (APTR)task : NULL;
+    if (sampler_pc_ring) sampler_pc_ring[slot] = sampler_last_pc;
+    sampler_head++;
+}
+
+static struct Interrupt sampler_int = {
+    { NULL, NULL, NT_INTERRUPT, 0, (char *)XSYSINFO_NAME " sampler" },
+    NULL,
+    (VOID (*)())sampler_interrupt
+};
+
+/*
+ * Current sample rate in Hz
+ */
+ULONG get_sampler_rate(void)
+{
+    return sampler_rates[sampler_rate_index];
+}
+
+/*
+ * Point the level-6 autovector at the stub
+ */
+static void patch_level6(void)
+{
+    ULONG *vectors = (ULONG *)hw_info.vbr;
+
+    Disable();
+    sampler_last_pc = 0;
+    sampler_old_level6 = vectors[LEVEL6_VECTOR];
+    vectors[LEVEL6_VECTOR] = (ULONG)sampler_level6;
+    level6_patched = TRUE;
+    Enable();
+
+    /* Push the new vector out of a copyback data cache */
+    CacheClearU();
+}
+
+/*
+ * Restore the level-6 autovector
+ * Fails while someone else patched it after us; the stub stays in the
+ * chain and keeps working, but our code must not be unloaded.
+ */
+static BOOL unpatch_level6(void)
+{
+    ULONG *vectors = (ULONG *)hw_info.vbr;
+
+    if (!level6_patched) return TRUE;
+
+    Disable();
+    if (vectors[LEVEL6_VECTOR] == (ULONG)sampler_level6) {
+        vectors[LEVEL6_VECTOR] = sampler_old_level6;
+        level6_patched = FALSE;
+    }
+    Enable();
+
+    CacheClearU();
+
+    return !level6_patched;
+}
+
+/*
+ * Free the sample rings
+ */
+static void free_sampler_rings(void)
+{
+    if (sampler_ring) {
+        FreeMem(sampler_ring, sizeof(APTR) * SAMPLER_RING);
+        sampler_ring = NULL;
+    }
+    if (sampler_pc_ring) {
+        FreeMem(sampler_pc_ring, sizeof(ULONG) * SAMPLER_RING);
+        sampler_pc_ring = NULL;
+    }
+}
+
+/*
+ * Claim a CIA-B timer and start sampling the running task
+ */
+BOOL start_cpu_sampler(void)
+{
+    if (sampler_enabled) return TRUE;
+
+    if (!sampler_ring) {
+        sampler_ring = (APTR *)AllocMem(sizeof(APTR) * SAMPLER_RING,
+                                        MEMF_PUBLIC | MEMF_CLEAR);
+        if (!sampler_ring) return FALSE;
+    }
+
+    if (sampler_code_mode && !sampler_pc_ring) {
+        sampler_pc_ring = (ULONG *)AllocMem(sizeof(ULONG) * SAMPLER_RING,
+                                            MEMF_PUBLIC | MEMF_CLEAR);
+        if (!sampler_pc_ring) {
+            free_sampler_rings();
+            return FALSE;
+        }
+    }
+
+    if (!start_live_timer(CPU_TICK_VBLANKS)) {
+        free_sampler_rings();
+        return FALSE;
+    }
+
+    memset(&cpu_usage, 0, sizeof(cpu_usage));
+    memset(cpu_seconds, 0, sizeof(cpu_seconds));
+    cpu_second_count = 0;
+    sampler_head = 0;
+    sampler_tail = 0;
+    sampler_last_idle = SysBase->IdleCount;
+
+    if (sampler_code_mode) {
+        build_code_ranges();
+        if (!level6_patched) patch_level6();
+    }
+
+    /* Either timer will do, whichever is free */
+    sampler_timer = claim_ciab_timer(&sampler_int);
+    if (sampler_timer < 0) {
+        stop_live_timer();
+        if (sampler_code_mode) unpatch_level6();
+        free_sampler_rings();
+        debug("  sampler: no free CIA-B timer\n");
+        return FALSE;
+    }
+
+    start_ciab_timer(sampler_timer, get_eclock_frequency() / get_sampler_rate());
+    sampler_enabled = TRUE;
+
+    debug("  sampler: CIA-B timer %c at %lu Hz\n",
+          sampler_timer == CIAICRB_TA ? 'A' : 'B', (unsigned long)get_sampler_rate());
+
+    return TRUE;
+}
+
+/*
+ * Stop the timer and release it
+ */
+void stop_cpu_sampler(void)
+{
+    if (!sampler_enabled) return;
+
+    stop_live_timer();
+
+    release_ciab_timer(sampler_timer, &sampler_int);
+    sampler_timer = -1;
+    sampler_enabled = FALSE;
+
+    if (sampler_pc_ring) {
+        unpatch_level6();
+        finish_code_profile();
+    }
+
+    free_sampler_rings();
+}
+
+/*
+ * Stop sampling and restore the level-6 vector
+ * The stub lives in our code, so we cannot exit while it is in a chain.
+ */
+void cleanup_cpu_sampler(void)
+{
+    stop_cpu_sampler();
+
+    while (!unpatch_level6()) {
+        Delay(TICKS_PER_SECOND);
+    }
+
+    free_sampler_rings();
+}
+
+/*
+ * TRUE while the timer interrupt samples
+ */
+BOOL cpu_sampler_active(void)
+{
+    return sampler_enabled;
+}
+
+/*
+ * TRUE while a code profile is collected into the code ranges
+ */
+BOOL cpu_sampler_profiling(void)
+{
+    return sampler_enabled && sampler_pc_ring != NULL;
+}
+
+/*
+ * Count one sample into a second of the window
+ */
+static void add_sample(CpuSecond *second, APTR task)
+{
+    ULONG i;
+
+    second->total++;
+
+    if (!task) {
+        second->idle++;
+        return;
+    }
+
+    for (i = 0; i < second->task_count; i++) {
+        if (second->tasks[i].task == task) {
+            second->tasks[i].samples++;
+            return;
+        }
+    }
+
+    if (second->task_count < MAX_CPU_TASKS) {
+        second->tasks[second->task_count].task = task;
+        second->tasks[second->task_count].samples = 1;
+        second->task_count++;
+    } else {
+        second->other++;
+    }
+}
+
+/*
+ * Merge the seconds of the window into cpu_usage
+ */
+static void update_cpu_usage(void)
+{
+    ULONG samples[MAX_CPU_TASKS];
+    ULONG seconds = cpu_second_count < CPU_WINDOW_SECONDS ? cpu_second_count
+                                                          : CPU_WINDOW_SECONDS;
+    ULONG total = 0, idle = 0, other = 0, idle_entries = 0;
+    ULONG s, i, j;
+
+    cpu_usage.task_count = 0;
+
+    for (s = 0; s < seconds; s++) {
+        const CpuSecond *second = &cpu_seconds[s];
+
+        total += second->total;
+        idle += second->idle;
+        other += second->other;
+        idle_entries += second->idle_entries;
+
+        for (i = 0; i < second->task_count; i++) {
+            const CpuTaskSamples *entry = &second->tasks[i];
+
+            for (j = 0; j < cpu_usage.task_count; j++) {
+                if (cpu_usage.tasks[j].task == entry->task) break;
+            }
+
+            if (j < cpu_usage.task_count) {
+                samples[j] += entry->samples;
+            } else if (cpu_usage.task_count < MAX_CPU_TASKS) {
+                cpu_usage.tasks[j].task = entry->task;
+                samples[j] = entry->samples;
+                cpu_usage.task_count++;
+            } else {
+                other += entry->samples;
+            }
+        }
+    }
+
+    cpu_usage.samples = total;
+    cpu_usage.seconds = seconds;
+    cpu_usage.idle_entries = seconds ? idle_entries / seconds : 0;
+    if (total == 0) total = 1;
+    cpu_usage.idle_permille = (UWORD)(idle * 1000 / total);
+    cpu_usage.other_permille = (UWORD)(other * 1000 / total);
+
+    for (i = 0; i < cpu_usage.task_count; i++) {
+        cpu_usage.tasks[i].permille = (UWORD)(samples[i] * 1000 / total);
+    }
+
+    /* Simple bubble sort - busiest first */
+    for (i = 0; i + 1 < cpu_usage.task_count; i++) {
+        for (j = 0; j < cpu_usage.task_count - i - 1; j++) {
+            if (cpu_usage.tasks[j].permille < cpu_usage.tasks[j + 1].permille) {
+                CpuTaskUsage temp = cpu_usage.tasks[j];
+                cpu_usage.tasks[j] = cpu_usage.tasks[j + 1];
+                cpu_usage.tasks[j + 1] = temp;
+            }
+        }
+    }
+
+    /* Copy the names of tasks that still exist */
+    Forbid();
+
+    for (i = 0; i < cpu_usage.task_count; i++) {
+        struct Node *node = find_task_node(cpu_usage.tasks[i].task);
+
+        cpu_usage.tasks[i].name[0] = '\0';
+        if (node && node->ln_Name) {
+            strncpy(cpu_usage.tasks[i].name, node->ln_Name,
+                    sizeof(cpu_usage.tasks[i].name) - 1);
+        }
+    }
+
+    Permit();
+
+    for (i = 0; i < cpu_usage.task_count; i++) {
+        if (cpu_usage.tasks[i].name[0] == '\0') {
+            strncpy(cpu_usage.tasks[i].name, get_string(MSG_TRACE_EXITED),
+                    sizeof(cpu_usage.tasks[i].name) - 1);
+        }
+    }
+}
+
+/*
+ * Format a permille value as percent ("12.3%")
+ */
+static void format_permille(UWORD permille, char *buffer, ULONG size)
+{
+    snprintf(buffer, size, "%3u.%u%%", (unsigned)(permille / 10), (unsigned)(permille % 10));
+}
+
+/*
+ * Draw one usage row: name, percent and bar
+ */
+static void draw_cpu_row(WORD y, const char *name, UWORD permille, WORD color)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[32];
+    WORD width = (WORD)((ULONG)CPU_BAR_WIDTH * permille / 1000);
+
+    snprintf(buffer, sizeof(buffer), "%.30s", name);
+    draw_text(CPU_COL_TASK, y, buffer, COLOR_TEXT);
+
+    format_permille(permille, buffer, sizeof(buffer));
+    draw_text(CPU_COL_PERCENT, y, buffer, COLOR_HIGHLIGHT);
+
+    if (width > 0) {
+        SetAPen(rp, color);
+        RectFill(rp, CPU_COL_BAR, y - 6, CPU_COL_BAR + width - 1, y);
+    }
+}
+
+/*
+ * Draw the busiest code ranges since sampling started
+ */
+static void draw_code_usage(void)
+{
+    UWORD busiest[CPU_CODE_ROWS];
+    char buffer[80];
+    ULONG count, i;
+    WORD y = 56;
+
+    draw_cpu_row(y, get_string(MSG_CPU_IDLE),
+                 get_profile_permille(code_profile.idle), COLOR_BUTTON_DARK);
+    y += 10;
+
+    count = get_busiest_code_ranges(busiest, CPU_CODE_ROWS);
+    for (i = 0; i < count; i++) {
+        const CodeRange *range = &code_profile.ranges[busiest[i]];
+
+        draw_cpu_row(y, range->name, get_profile_permille(range->samples),
+                     range->kind == CODE_TASK ? COLOR_BAR_YOU : COLOR_BAR_FILL);
+        y += 10;
+    }
+
+    if (code_profile.kickstart > 0) {
+        draw_cpu_row(y, get_string(MSG_CPU_KICKSTART),
+                     get_profile_permille(code_profile.kickstart), COLOR_BAR_FILL);
+        y += 10;
+    }
+    if (code_profile.unknown > 0) {
+        draw_cpu_row(y, get_string(MSG_CPU_UNKNOWN),
+                     get_profile_permille(code_profile.unknown), COLOR_BAR_FILL);
+    }
+
+    snprintf(buffer, sizeof(buffer), "%lu Hz, %lu s, %lu %s, %lu %s, %lu %s",
+             (unsigned long)get_sampler_rate(), (unsigned long)cpu_second_count,
+             (unsigned long)code_profile.samples, get_string(MSG_CPU_SAMPLES),
+             (unsigned long)code_profile.count, get_string(MSG_CPU_RANGES),
+             (unsigned long)cpu_usage.lost, get_string(MSG_TRACE_LOST));
+    draw_text(CPU_COL_TASK, CPU_STATUS_Y, buffer,
+              sampler_enabled ? COLOR_HIGHLIGHT : COLOR_TEXT);
+
+    if (level6_patched && !sampler_enabled) {
+        draw_text(CPU_COL_BAR, CPU_STATUS_Y, get_string(MSG_TRACE_UNPATCH_FAILED),
+                  COLOR_BAR_YOU);
+    }
+}
+
+/*
+ * Draw the usage rows and the status line
+ */
+static void draw_cpu_usage(void)
+{
+    struct RastPort *rp = app->rp;
+    char buffer[80];
+    ULONG i;
+    WORD y;
+
+    SetAPen(rp, COLOR_BACKGROUND);
+    RectFill(rp, CPU_COL_TASK, 49, 628, CPU_STATUS_Y + 2);
+
+    if (sampler_code_mode) {
+        if (code_profile.samples == 0) {
+            draw_text(CPU_COL_TASK, 100,
+                      get_string(sampler_enabled ? MSG_CPU_WAITING : MSG_CPU_CODE_HINT),
+                      COLOR_TEXT);
+        } else {
+            draw_code_usage();
+        }
+        return;
+    }
+
+    if (cpu_usage.seconds == 0) {
+        draw_text(CPU_COL_TASK, 100,
+                  get_string(sampler_enabled ? MSG_CPU_WAITING : MSG_CPU_HINT), COLOR_TEXT);
+        return;
+    }
+
+    /* Idle first, then the busiest tasks */
+    y = 56;
+    draw_cpu_row(y, get_string(MSG_CPU_IDLE), cpu_usage.idle_permille, COLOR_BUTTON_DARK);
+    y += 10;
+
+    for (i = 0; i < cpu_usage.task_count && y < 160; i++) {
+        draw_cpu_row(y, cpu_usage.tasks[i].name, cpu_usage.tasks[i].permille,
+                     COLOR_BAR_FILL);
+        y += 10;
+    }
+
+    if (cpu_usage.other_permille > 0 && y < 170) {
+        draw_cpu_row(y, get_string(MSG_CPU_OTHER), cpu_usage.other_permille,
+                     COLOR_BAR_FILL);
+    }
+
+    snprintf(buffer, sizeof(buffer), "%lu Hz, %lu s, %lu %s, %lu %s, %lu %s",
+             (unsigned long)get_sampler_rate(), (unsigned long)cpu_usage.seconds,
+             (unsigned long)cpu_usage.samples, get_string(MSG_CPU_SAMPLES),
+             (unsigned long)cpu_usage.idle_entries, get_string(MSG_CPU_IDLE_ENTRIES),
+             (unsigned long)cpu_usage.lost, get_string(MSG_TRACE_LOST));
+    draw_text(CPU_COL_TASK, CPU_STATUS_Y, buffer,
+              sampler_enabled ? COLOR_HIGHLIGHT : COLOR_TEXT);
+}
+
+/*
+ * Live timer tick: drain the ring into the next second of the window
+ */
+void cpu_sampler_tick(void)
+{
+    ULONG head = sampler_head;
+    ULONG idle_count = SysBase->IdleCount;
+    CpuSecond *second;
+
+    if (!sampler_enabled) return;
+
+    /* The interrupt overwrote samples we did not read in time */
+    if (head - sampler_tail > SAMPLER_RING) {
+        cpu_usage.lost += head - sampler_tail - SAMPLER_RING;
+        sampler_tail = head - SAMPLER_RING;
+    }
+
+    second = &cpu_seconds[cpu_second_count % CPU_WINDOW_SECONDS];
+    memset(second, 0, sizeof(*second));
+
+    while (sampler_tail != head) {
+        ULONG slot = sampler_tail & (SAMPLER_RING - 1);
+
+        add_sample(second, sampler_ring[slot]);
+        if (sampler_pc_ring) {
+            profile_add_sample(sampler_pc_ring[slot], sampler_ring[slot] == NULL);
+        }
+        sampler_tail++;
+    }
+
+    second->idle_entries = idle_count - sampler_last_idle;
+    sampler_last_idle = idle_count;
+    cpu_second_count++;
+
+    update_cpu_usage();
+
+    if (app->current_view == VIEW_CPU) draw_cpu_usage();
+}
+
+/*
+ * Draw CPU usage view
+ */
+void draw_cpu_view(void)
+{
+    struct RastPort *rp = app->rp;
+    Button *btn;
+
+    /* Draw title panel */
+    draw_panel(20, 0, 600, 24, NULL);
+
+    SetAPen(rp, COLOR_TEXT);
+    SetBPen(rp, COLOR_PANEL_BG);
+    Move(rp, 220, 14);
+    Text(rp, (CONST_STRPTR)get_string(MSG_CPU_USAGE),
+         strlen(get_string(MSG_CPU_USAGE)));
+
+    /* Draw column headers */
+    SetAPen(rp, COLOR_TEXT);
+    TightText(rp, CPU_COL_TASK, 40,
+              (CONST_STRPTR)get_string(sampler_code_mode ? MSG_CPU_CODE : MSG_TRACE_TASK), -1, 4);
+    TightText(rp, CPU_COL_PERCENT, 40, (CONST_STRPTR)"CPU", -1, 4);
+
+    /* Draw separator line */
+    SetAPen(rp, COLOR_BUTTON_DARK);
+    Move(rp, 20, 44);
+    Draw(rp, 628, 44);
+
+    draw_cpu_usage();
+
+    /* Draw buttons */
+    btn = find_button(BTN_CPU_EXIT);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_CPU_START);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_CPU_RATE);
+    if (btn) draw_button(btn);
+    btn = find_button(BTN_CPU_MODE);
+    if (btn) draw_button(btn);
+}
+
+/*
+ * Update buttons for CPU usage view
+ */
+void cpu_view_update_buttons(void)
+{
+    static char rate_label[12];
+
+    snprintf(rate_label, sizeof(rate_label), "%lu HZ", (unsigned long)get_sampler_rate());
+
+    add_button(20, 188, 60, 12,
+               get_string(MSG_BTN_EXIT), BTN_CPU_EXIT, TRUE);
+    add_button(100, 188, 60, 12,
+               get_string(sampler_enabled ? MSG_BTN_STOP : MSG_BTN_START),
+               BTN_CPU_START, TRUE);
+    add_button(180, 188, 60, 12, rate_label, BTN_CPU_RATE, !sampler_enabled);
+    add_button(260, 188, 60, 12,
+               get_string(sampler_code_mode ? MSG_BTN_CODE : MSG_BTN_TASKS),
+               BTN_CPU_MODE, !sampler_enabled);
+}
+
+/*
+ * Handle button press for CPU usage view
+ */
+void cpu_view_handle_button(ButtonID id)
+{
+    switch (id) {
+        case BTN_CPU_START:
+            if (sampler_enabled) {
+                stop_cpu_sampler();
+            } else {
+                start_cpu_sampler();
+            }
+            redraw_current_view();
+            break;
+
+        case BTN_CPU_RATE:
+            sampler_rate_index = (sampler_rate_index + 1) % SAMPLER_RATE_COUNT;
+            redraw_current_view();
+            break;
+
+        case BTN_CPU_MODE:
+            sampler_code_mode = !sampler_code_mode;
+            redraw_current_view();
+            break;
+
+        case BTN_CPU_EXIT:
+            switch_to_view(VIEW_MAIN);
+            break;
+
+        default:
+            break;
+    }
+}
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - CPU usage sampler header
+ */
+
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include "xsysinfo.h"
+
+/* Ring buffer size in samples (power of two), allocated before starting */
+#define SAMPLER_RING            4096
+
+/* Sample rates selectable in the view (Hz) */
+#define SAMPLER_RATE_COUNT      4
+#define SAMPLER_DEFAULT_RATE    2   /* Index into the rate table (1000 Hz) */
+
+/* Sliding window in seconds and update interval */
+#define CPU_WINDOW_SECONDS      5
+#define CPU_TICK_VBLANKS        50
+
+/* Tasks kept per second and in the results, busiest first */
+#define MAX_CPU_TASKS           32
+
+/* Samples of one task */
+typedef struct {
+    APTR task;
+    ULONG samples;
+} CpuTaskSamples;
+
+/* Samples of one second of the window */
+typedef struct {
+    CpuTaskSamples tasks[MAX_CPU_TASKS];
+    ULONG task_count;
+    ULONG other;            /* Samples of tasks beyond MAX_CPU_TASKS */
+    ULONG idle;             /* No task was running */
+    ULONG total;
+    ULONG idle_entries;     /* IdleCount increase */
+} CpuSecond;
+
+/* CPU usage of one task over the window */
+typedef struct {
+    APTR task;
+    char name[32];
+    UWORD permille;
+} CpuTaskUsage;
+
+/* CPU usage over the window */
+typedef struct {
+    CpuTaskUsage tasks[MAX_CPU_TASKS];
+    ULONG task_count;
+    UWORD idle_permille;
+    UWORD other_permille;
+    ULONG samples;          /* Samples in the window */
+    ULONG idle_entries;     /* Per second, from IdleCount */
+    ULONG lost;             /* Samples overwritten in the ring */
+    ULONG seconds;          /* Seconds in the window so far */
+} CpuUsage;
+
+/* Global CPU usage */
+extern CpuUsage cpu_usage;
+
+/* Function prototypes */
+
+/* Claim a CIA-B timer and start sampling the running task,
+ * in code mode also the interrupted program counter */
+BOOL start_cpu_sampler(void);
+
+/* Stop the timer and release it */
+void stop_cpu_sampler(void);
+
+/* Stop sampling and restore the level-6 vector before exit */
+void cleanup_cpu_sampler(void);
+
+/* TRUE while the timer interrupt samples */
+BOOL cpu_sampler_active(void);
+
+/* TRUE while a code profile is collected, the code ranges must not be rebuilt */
+BOOL cpu_sampler_profiling(void);
+
+/* Live timer tick: drain the ring and update the window */
+void cpu_sampler_tick(void);
+
+/* Current sample rate in Hz */
+ULONG get_sampler_rate(void);
+
+/* Draw CPU usage view */
+void draw_cpu_view(void);
+
+#endif /* SAMPLER_H */
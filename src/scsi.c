@@ -28,6 +28,7 @@
 #include "scsi.h"
 #include "gui.h"
 #include "locale_str.h"
+#include "arena.h"
 #include "debug.h"
 
 /* Global SCSI device list */
@@ -393,7 +394,8 @@ void scan_scsi_devices(const char *handler_name, ULONG base_unit)
 
     (void)base_unit;  /* Not used in current implementation */
 
-    memset(&scsi_device_list, 0, sizeof(scsi_device_list));
+    scsi_device_list.count = 0;
+    memset(scsi_device_list.device_name, 0, sizeof(scsi_device_list.device_name));
     strncpy(scsi_device_list.device_name, handler_name,
             sizeof(scsi_device_list.device_name) - 1);
 
@@ -430,9 +432,13 @@ void scan_scsi_devices(const char *handler_name, ULONG base_unit)
             /* Try INQUIRY command */
             if (scsi_inquiry(target, lun, &inquiry_data)) {
                 /* Check if device is present (not 0x7F = no device) */
-                if ((inquiry_data.device_type & 0x1F) != 0x1F) {
+                if ((inquiry_data.device_type & 0x1F) != 0x1F &&
+                    ARENA_RESERVE(scsi_device_list.devices, scsi_device_list.count,
+                                  scsi_device_list.capacity)) {
                     ScsiDeviceInfo *dev = &scsi_device_list.devices[scsi_device_list.count];
 
+                    memset(dev, 0, sizeof(*dev));
+
                     dev->target_id = target;
                     dev->lun = lun;
                     dev->device_type = convert_device_type(inquiry_data.device_type);
@@ -476,19 +482,11 @@ void scan_scsi_devices(const char *handler_name, ULONG base_unit)
 
                     debug("  scsi: Found device ID %ld: %s %s\n",
                           (LONG)target, (LONG)dev->manufacturer, (LONG)dev->model);
-
-                    if (scsi_device_list.count >= MAX_SCSI_DEVICES) {
-                        break;
-                    }
                 }
             }
 
             CloseDevice((struct IORequest *)io);
         }
-
-        if (scsi_device_list.count >= MAX_SCSI_DEVICES) {
-            break;
-        }
     }
 
     DeleteIORequest((struct IORequest *)io);
@@ -10,9 +10,6 @@
 
 #include "xsysinfo.h"
 
-/* Maximum SCSI devices we'll track */
-#define MAX_SCSI_DEVICES    64
-
 /* Wide SCSI indicator (from Phase V scheme) */
 #define HD_WIDESCSI     0x80
 
@@ -56,10 +53,11 @@ typedef struct {
     BOOL is_valid;                  /* Entry contains valid data */
 } ScsiDeviceInfo;
 
-/* SCSI device list */
+/* SCSI device list, grown in the arena */
 typedef struct {
-    ScsiDeviceInfo devices[MAX_SCSI_DEVICES];
+    ScsiDeviceInfo *devices;
     ULONG count;
+    ULONG capacity;
     char device_name[64];           /* Device driver name */
 } ScsiDeviceList;
 
@@ -6,6 +6,7 @@
  */
 
 #include <string.h>
+#include <stdlib.h>
 
 #include <exec/execbase.h>
 #include <exec/libraries.h>
@@ -16,13 +17,41 @@
 
 #include "xsysinfo.h"
 #include "software.h"
+#include "tasks.h"
 #include "hardware.h"
+#include "benchmark.h"
+#include "profile.h"
+#include "sampler.h"
+#include "arena.h"
 
 /* Global software lists */
 SoftwareList libraries_list;
 SoftwareList devices_list;
 SoftwareList resources_list;
 
+/* Raw copy of a list node, taken under Forbid() */
+typedef struct {
+    char name[64];
+    APTR address;
+    APTR code;
+    UWORD version;
+    UWORD revision;
+    UWORD neg_size;
+    UWORD pos_size;
+    UWORD open_count;
+    UBYTE flags;
+} LibrarySnapshot;
+
+/* Library vectors are "jmp abs.l" instructions */
+#define JMP_ABS_OPCODE      0x4EF9
+
+/* Name of the artificial first library entry, also what marks it */
+static const char kickstart_name[] = "kickstart";
+
+/* Snapshot buffer, reused for every list */
+static LibrarySnapshot *library_snapshot = NULL;
+static ULONG snapshot_capacity = 0;
+
 /* External references */
 extern struct ExecBase *SysBase;
 
@@ -53,7 +82,7 @@ static void copy_base_name(char *dest, const char *src, size_t destsize)
     }
 }
 
-/* Comparison function for sorting */
+/* Comparison functions for sorting */
 static int compare_entries(const void *a, const void *b)
 {
     const SoftwareEntry *ea = (const SoftwareEntry *)a;
@@ -61,84 +90,225 @@ static int compare_entries(const void *a, const void *b)
     return stricmp(ea->name, eb->name);
 }
 
+static int compare_entry_addresses(const void *a, const void *b)
+{
+    const SoftwareEntry *ea = (const SoftwareEntry *)a;
+    const SoftwareEntry *eb = (const SoftwareEntry *)b;
+
+    if (ea->address != eb->address) return (ULONG)ea->address < (ULONG)eb->address ? -1 : 1;
+    return 0;
+}
+
+static int compare_entry_sizes(const void *a, const void *b)
+{
+    const SoftwareEntry *ea = (const SoftwareEntry *)a;
+    const SoftwareEntry *eb = (const SoftwareEntry *)b;
+
+    if (ea->footprint != eb->footprint) return ea->footprint > eb->footprint ? -1 : 1;
+    return compare_entries(a, b);
+}
+
+static int compare_entry_opens(const void *a, const void *b)
+{
+    const SoftwareEntry *ea = (const SoftwareEntry *)a;
+    const SoftwareEntry *eb = (const SoftwareEntry *)b;
+
+    if (ea->open_count != eb->open_count) return ea->open_count > eb->open_count ? -1 : 1;
+    return compare_entries(a, b);
+}
+
 /*
- * Sort a software list alphabetically
+ * Sort a software list, the kickstart entry stays first
+ * qsort() instead of a bubble sort, busy systems have hundreds of
+ * entries.
  */
-void sort_software_list(SoftwareList *list)
+void sort_software_list(SoftwareList *list, SoftwareSort order)
 {
-    if (list && list->count > 1) {
-        /* Simple bubble sort - OK for small lists */
-        ULONG i, j;
-        for (i = 0; i < list->count - 1; i++) {
-            for (j = 0; j < list->count - i - 1; j++) {
-                if (compare_entries(&list->entries[j],
-                                    &list->entries[j + 1]) > 0) {
-                    SoftwareEntry temp = list->entries[j];
-                    list->entries[j] = list->entries[j + 1];
-                    list->entries[j + 1] = temp;
-                }
+    int (*compare)(const void *, const void *);
+    ULONG first = 0;
+
+    if (!list) return;
+
+    switch (order) {
+        case SOFTWARE_SORT_ADDRESS:
+            compare = compare_entry_addresses;
+            break;
+        case SOFTWARE_SORT_SIZE:
+            compare = compare_entry_sizes;
+            break;
+        case SOFTWARE_SORT_OPENS:
+            compare = compare_entry_opens;
+            break;
+        default:
+            compare = compare_entries;
+            break;
+    }
+
+    if (list->count > 0 && list->entries[0].name == kickstart_name) first = 1;
+
+    if (list->count > first + 1) {
+        qsort(&list->entries[first], list->count - first, sizeof(SoftwareEntry), compare);
+    }
+}
+
+/*
+ * Sort the library, device and resource lists
+ */
+void sort_all_software(SoftwareSort order)
+{
+    sort_software_list(&libraries_list, order);
+    sort_software_list(&devices_list, order);
+    sort_software_list(&resources_list, order);
+}
+
+/*
+ * Copy the raw fields of a library-style list under Forbid()
+ * Names are copied bounded and unformatted, everything else is done by
+ * fill_software_list() after Permit(). The buffer is sized beforehand,
+ * allocating under Forbid() could expunge the nodes being walked. A list
+ * that outgrew it is copied again. Returns the number of copied nodes.
+ */
+static ULONG snapshot_library_list(struct List *list, const char *what)
+{
+    struct Node *node;
+    ULONG count = 0;
+    ULONG nodes;
+    ULONG tries;
+
+    for (tries = 0; tries < ARENA_SNAPSHOT_RETRIES; tries++) {
+        /* Out of memory: only what fits is copied */
+        (void)ARENA_RESERVE_N(library_snapshot, 0, snapshot_capacity,
+                              arena_count_nodes(list) + ARENA_SNAPSHOT_SLACK);
+
+        count = 0;
+        nodes = 0;
+
+        timed_forbid();
+
+        for (node = list->lh_Head; node->ln_Succ != NULL; node = node->ln_Succ) {
+            struct Library *lib = (struct Library *)node;
+            LibrarySnapshot *snap;
+
+            if (nodes++ >= snapshot_capacity) continue;
+
+            snap = &library_snapshot[count++];
+            snap->address = (APTR)lib;
+            /* The base is always in RAM, the first vector tells where the code runs */
+            snap->code = (APTR)lib;
+            if (lib->lib_NegSize >= 6 && *(UWORD *)((UBYTE *)lib - 6) == JMP_ABS_OPCODE) {
+                snap->code = (APTR)get_library_vector(lib, -6);
+            }
+            snap->version = lib->lib_Version;
+            snap->revision = lib->lib_Revision;
+            snap->neg_size = lib->lib_NegSize;
+            snap->pos_size = lib->lib_PosSize;
+            snap->open_count = lib->lib_OpenCnt;
+            snap->flags = lib->lib_Flags;
+            snap->name[0] = '\0';
+            if (node->ln_Name) {
+                strncpy(snap->name, node->ln_Name, sizeof(snap->name) - 1);
             }
         }
+
+        timed_permit(what);
+
+        if (nodes <= snapshot_capacity) break;
     }
+
+    return count;
 }
 
 /*
- * Enumerate all open libraries
+ * Append a cleared entry, NULL if the arena is out of memory
  */
-void enumerate_libraries(void)
+static SoftwareEntry *add_software_entry(SoftwareList *list)
 {
-    struct Library *lib;
-    ULONG i;
     SoftwareEntry *entry;
 
-    memset(&libraries_list, 0, sizeof(libraries_list));
+    if (!ARENA_RESERVE(list->entries, list->count, list->capacity)) return NULL;
 
-    Forbid();
+    entry = &list->entries[list->count++];
+    memset(entry, 0, sizeof(*entry));
 
-    for (lib = (struct Library *)SysBase->LibList.lh_Head;
-         (struct Node *)lib != (struct Node *)&SysBase->LibList.lh_Tail;
-         lib = (struct Library *)lib->lib_Node.ln_Succ) {
+    return entry;
+}
 
-        if (libraries_list.count >= MAX_SOFTWARE_ENTRIES) break;
+/*
+ * Build a software list from the snapshot (outside Forbid)
+ */
+static void fill_software_list(SoftwareList *list, ULONG count)
+{
+    char name[64];
+    ULONG i;
 
-        entry = &libraries_list.entries[libraries_list.count];
+    list->count = 0;
 
-        if (lib->lib_Node.ln_Name) {
-            copy_base_name(entry->name, lib->lib_Node.ln_Name, sizeof(entry->name));
-        } else {
-            strncpy(entry->name, "(unknown)", sizeof(entry->name) - 1);
-        }
+    for (i = 0; i < count; i++) {
+        LibrarySnapshot *snap = &library_snapshot[i];
+        SoftwareEntry *entry = add_software_entry(list);
 
-        entry->address = (APTR)lib;
-        entry->version = lib->lib_Version;
-        entry->revision = lib->lib_Revision;
-        entry->location = determine_mem_location((APTR)lib);
+        if (!entry) break;
 
-        libraries_list.count++;
+        snap->name[sizeof(snap->name) - 1] = '\0';
+        copy_base_name(name, snap->name, sizeof(name));
+        entry->name = name[0] ? arena_intern(name) : NULL;
+        if (!entry->name) entry->name = "(unknown)";
+
+        entry->address = snap->address;
+        entry->code = snap->code;
+        entry->version = snap->version;
+        entry->revision = snap->revision;
+        entry->footprint = (ULONG)snap->neg_size + snap->pos_size;
+        entry->open_count = snap->open_count;
+        entry->flags = snap->flags;
+        entry->location = determine_mem_location(snap->code);
     }
 
-    Permit();
+    sort_software_list(list, SOFTWARE_SORT_NAME);
+}
 
-    sort_software_list(&libraries_list);
+/*
+ * Location of the kickstart entry
+ * Its ROM size is shown unless the sweep found the ROM shadowed or
+ * remapped to RAM.
+ */
+static MemoryLocation kickstart_location(APTR rom_base)
+{
+    switch (get_rom_bank_type((ULONG)rom_base)) {
+        case ROM_BANK_SHADOWED: return LOC_SHADOWED_ROM;
+        case ROM_BANK_REMAPPED: return LOC_REMAPPED_ROM;
+        default:                return LOC_KICKSTART;
+    }
+}
+
+/*
+ * Enumerate all open libraries
+ */
+void enumerate_libraries(void)
+{
+    ULONG i;
+    SoftwareEntry *entry;
+
+    fill_software_list(&libraries_list,
+                       snapshot_library_list(&SysBase->LibList, "library list"));
 
     /* Insert artificial "kickstart" entry at the beginning */
-    if (libraries_list.count < MAX_SOFTWARE_ENTRIES) {
+    if (add_software_entry(&libraries_list)) {
         /* Shift all entries by 1 position */
-        for (i = libraries_list.count; i > 0; i--) {
+        for (i = libraries_list.count - 1; i > 0; i--) {
             libraries_list.entries[i] = libraries_list.entries[i - 1];
         }
 
         /* Insert kickstart entry at position 0 */
         entry = &libraries_list.entries[0];
-        strncpy(entry->name, "kickstart", sizeof(entry->name) - 1);
-        entry->name[sizeof(entry->name) - 1] = '\0';
-        entry->location = LOC_KICKSTART;
+        memset(entry, 0, sizeof(*entry));
+        entry->name = kickstart_name;
         /* ROM base: 0x00f80000 for 512K, 0x00fc0000 for 256K */
         entry->address = (APTR)(hw_info.kickstart_size >= 512 ? 0x00f80000 : 0x00fc0000);
+        entry->code = entry->address;
+        entry->location = kickstart_location(entry->address);
         entry->version = hw_info.kickstart_version;
         entry->revision = hw_info.kickstart_revision;
-
-        libraries_list.count++;
     }
 }
 
@@ -147,38 +317,8 @@ void enumerate_libraries(void)
  */
 void enumerate_devices(void)
 {
-    struct Device *dev;
-
-    memset(&devices_list, 0, sizeof(devices_list));
-
-    Forbid();
-
-    for (dev = (struct Device *)SysBase->DeviceList.lh_Head;
-         (struct Node *)dev != (struct Node *)&SysBase->DeviceList.lh_Tail;
-         dev = (struct Device *)dev->dd_Library.lib_Node.ln_Succ) {
-
-        if (devices_list.count >= MAX_SOFTWARE_ENTRIES) break;
-
-        SoftwareEntry *entry = &devices_list.entries[devices_list.count];
-
-        if (dev->dd_Library.lib_Node.ln_Name) {
-            copy_base_name(entry->name, dev->dd_Library.lib_Node.ln_Name,
-                           sizeof(entry->name));
-        } else {
-            strncpy(entry->name, "(unknown)", sizeof(entry->name) - 1);
-        }
-
-        entry->address = (APTR)dev;
-        entry->version = dev->dd_Library.lib_Version;
-        entry->revision = dev->dd_Library.lib_Revision;
-        entry->location = determine_mem_location((APTR)dev);
-
-        devices_list.count++;
-    }
-
-    Permit();
-
-    sort_software_list(&devices_list);
+    fill_software_list(&devices_list,
+                       snapshot_library_list(&SysBase->DeviceList, "device list"));
 }
 
 /*
@@ -186,37 +326,35 @@ void enumerate_devices(void)
  */
 void enumerate_resources(void)
 {
-    struct Library *res;
-
-    memset(&resources_list, 0, sizeof(resources_list));
-
-    Forbid();
+    fill_software_list(&resources_list,
+                       snapshot_library_list(&SysBase->ResourceList, "resource list"));
+}
 
-    for (res = (struct Library *)SysBase->ResourceList.lh_Head;
-         (struct Node *)res != (struct Node *)&SysBase->ResourceList.lh_Tail;
-         res = (struct Library *)res->lib_Node.ln_Succ) {
+/*
+ * Add the code each entry has in RAM to its footprint
+ * Disk libraries' seglists are not reachable from the base, so the code
+ * ranges of the profiler are used. They are collected unless a finished
+ * or running CPU profile still uses them.
+ */
+static void add_code_footprints(void)
+{
+    SoftwareList *lists[3];
+    ULONG i, j;
 
-        if (resources_list.count >= MAX_SOFTWARE_ENTRIES) break;
+    if (!code_profile.valid && !cpu_sampler_profiling()) build_code_ranges();
 
-        SoftwareEntry *entry = &resources_list.entries[resources_list.count];
+    lists[0] = &libraries_list;
+    lists[1] = &devices_list;
+    lists[2] = &resources_list;
 
-        if (res->lib_Node.ln_Name) {
-            copy_base_name(entry->name, res->lib_Node.ln_Name, sizeof(entry->name));
-        } else {
-            strncpy(entry->name, "(unknown)", sizeof(entry->name) - 1);
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < lists[i]->count; j++) {
+            SoftwareEntry *entry = &lists[i]->entries[j];
+            if (entry->name != kickstart_name) {
+                entry->footprint += get_owner_code_size(entry->address);
+            }
         }
-
-        entry->address = (APTR)res;
-        entry->version = res->lib_Version;
-        entry->revision = res->lib_Revision;
-        entry->location = determine_mem_location((APTR)res);
-
-        resources_list.count++;
     }
-
-    Permit();
-
-    sort_software_list(&resources_list);
 }
 
 /*
@@ -227,6 +365,43 @@ void enumerate_all_software(void)
     enumerate_libraries();
     enumerate_devices();
     enumerate_resources();
+    enumerate_tasks();
+    add_code_footprints();
+}
+
+/*
+ * Re-evaluate the memory location of all entries
+ * Libraries are classified by their code, so ROM modules running from
+ * MapROM or MMU remapped memory change once the ROM banks were swept.
+ */
+void update_software_locations(void)
+{
+    SoftwareList *lists[3];
+    ULONG i, j;
+
+    lists[0] = &libraries_list;
+    lists[1] = &devices_list;
+    lists[2] = &resources_list;
+
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < lists[i]->count; j++) {
+            SoftwareEntry *entry = &lists[i]->entries[j];
+            if (entry->name == kickstart_name) {
+                entry->location = kickstart_location(entry->code);
+            } else {
+                entry->location = determine_mem_location(entry->code);
+            }
+        }
+    }
+}
+
+/*
+ * Get the current entry point of a library function
+ * Library vectors are "jmp abs.l" instructions, the target follows the opcode.
+ */
+ULONG get_library_vector(struct Library *lib, LONG lvo)
+{
+    return *(ULONG *)((UBYTE *)lib + lvo + 2);
 }
 
 /*
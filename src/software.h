@@ -10,22 +10,36 @@
 
 #include "xsysinfo.h"
 
-/* Maximum entries we'll track */
-#define MAX_SOFTWARE_ENTRIES    256
+/* exec library vector offsets */
+#define LVO_FORBID          (-132)
+#define LVO_PERMIT          (-138)
+#define LVO_ALLOCMEM        (-198)
+#define LVO_FREEMEM         (-210)
+#define LVO_FINDTASK        (-294)
+#define LVO_OBTAINSEMAPHORE (-564)
+#define LVO_RELEASESEMAPHORE (-570)
+#define LVO_ALLOCVEC        (-684)
+#define LVO_FREEVEC         (-690)
 
 /* Software entry */
 typedef struct {
-    char name[64];
+    const char *name;       /* Interned, without the ".library" suffix */
     MemoryLocation location;
     APTR address;
+    APTR code;              /* First function, tells ROM from RAM modules */
     UWORD version;
     UWORD revision;
+    UWORD cpu_permille;     /* Share of the last code profile */
+    ULONG footprint;        /* lib_NegSize + lib_PosSize, plus code loaded to RAM */
+    UWORD open_count;
+    UBYTE flags;            /* LIBF_* */
 } SoftwareEntry;
 
-/* Software list */
+/* Software list, grown in the arena */
 typedef struct {
-    SoftwareEntry entries[MAX_SOFTWARE_ENTRIES];
+    SoftwareEntry *entries;
     ULONG count;
+    ULONG capacity;
 } SoftwareList;
 
 /* Global software lists */
@@ -42,7 +56,16 @@ void enumerate_all_software(void);
 /* Get the current list based on type */
 SoftwareList *get_software_list(SoftwareType type);
 
-/* Sort entries alphabetically by name */
-void sort_software_list(SoftwareList *list);
+/* Re-evaluate entry locations (e.g. after the ROM bank sweep) */
+void update_software_locations(void);
+
+/* Sort entries, the kickstart entry stays first */
+void sort_software_list(SoftwareList *list, SoftwareSort order);
+
+/* Sort the library, device and resource lists */
+void sort_all_software(SoftwareSort order);
+
+/* Current entry point of a library function (lvo is negative) */
+ULONG get_library_vector(struct Library *lib, LONG lvo);
 
 #endif /* SOFTWARE_H */
@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Task list with stack high-water marks
+ */
+
+#include <string.h>
+
+#include <exec/execbase.h>
+#include <exec/tasks.h>
+
+#include <proto/exec.h>
+
+#include "xsysinfo.h"
+#include "tasks.h"
+#include "benchmark.h"
+#include "locale_str.h"
+#include "arena.h"
+
+/* Global task list */
+TaskList task_list;
+
+/* External references */
+extern struct ExecBase *SysBase;
+
+/*
+ * Get short task state name
+ */
+const char *get_task_state_string(UBYTE state)
+{
+    switch (state) {
+        case TS_RUN:
+            return get_string(MSG_TASK_RUN);
+        case TS_READY:
+            return get_string(MSG_TASK_READY);
+        case TS_WAIT:
+            return get_string(MSG_TASK_WAIT);
+        default:
+            return "---";
+    }
+}
+
+/*
+ * Find a task in an exec task list (under Forbid())
+ */
+static struct Node *find_in_task_list(struct List *list, APTR task)
+{
+    struct Node *node;
+
+    for (node = list->lh_Head; node->ln_Succ; node = node->ln_Succ) {
+        if ((APTR)node == task) return node;
+    }
+
+    return NULL;
+}
+
+/*
+ * Find a task that still exists: the running one or one on
+ * TaskReady/TaskWait. Must be called under Forbid().
+ */
+struct Node *find_task_node(APTR task)
+{
+    struct Node *node;
+
+    if (task == (APTR)SysBase->ThisTask) return (struct Node *)SysBase->ThisTask;
+
+    node = find_in_task_list(&SysBase->TaskReady, task);
+    if (!node) node = find_in_task_list(&SysBase->TaskWait, task);
+
+    return node;
+}
+
+/*
+ * Stack fill of a task in percent
+ */
+ULONG get_stack_percent(const TaskEntry *entry)
+{
+    if (entry->stack_size == 0) return 0;
+    return entry->stack_used * 100 / entry->stack_size;
+}
+
+/* Tasks seen by the last snapshot, including those that did not fit */
+static ULONG tasks_seen;
+
+/*
+ * Copy one task into the list (under Forbid)
+ */
+static void snapshot_task(struct Task *task)
+{
+    TaskEntry *entry;
+
+    tasks_seen++;
+    if (task_list.count >= task_list.capacity) return;
+
+    entry = &task_list.entries[task_list.count++];
+    entry->address = (APTR)task;
+    entry->state = task->tc_State;
+    entry->priority = task->tc_Node.ln_Pri;
+    entry->is_process = (task->tc_Node.ln_Type == NT_PROCESS);
+    entry->stack_lower = (ULONG)task->tc_SPLower;
+    entry->stack_size = (ULONG)task->tc_SPUpper - (ULONG)task->tc_SPLower;
+    entry->name[0] = '\0';
+    if (task->tc_Node.ln_Name) {
+        strncpy(entry->name, task->tc_Node.ln_Name, sizeof(entry->name) - 1);
+    }
+}
+
+/*
+ * Measure the stack high-water mark
+ * Stacks grow down from tc_SPUpper. Memory at tc_SPLower still holds the
+ * value it had when the stack was allocated (usually cleared), so the
+ * longwords equal to the lowest one were never touched.
+ */
+static ULONG measure_stack_used(ULONG lower, ULONG size)
+{
+    const ULONG *p = (const ULONG *)((lower + 3) & ~3);
+    const ULONG *end = (const ULONG *)((lower + size) & ~3);
+    ULONG fill;
+
+    if (p >= end) return 0;
+
+    fill = *p;
+    while (p < end && *p == fill) p++;
+
+    return (ULONG)end - (ULONG)p;
+}
+
+/* Comparison for sorting: fullest stack first */
+static int compare_tasks(const TaskEntry *a, const TaskEntry *b)
+{
+    ULONG pa = get_stack_percent(a);
+    ULONG pb = get_stack_percent(b);
+
+    if (pa != pb) return pa > pb ? -1 : 1;
+    return stricmp(a->name, b->name);
+}
+
+/*
+ * Snapshot TaskReady/TaskWait and the running task, then measure stacks
+ * Stacks are scanned after Permit(); a task that exits meanwhile only
+ * leaves a stale value behind. The list is sized outside Forbid() and
+ * copied again if more tasks turned up than fit.
+ */
+void enumerate_tasks(void)
+{
+    struct Node *node;
+    ULONG needed = task_list.capacity;
+    ULONG tries;
+    ULONG i, j;
+
+    for (tries = 0; tries < ARENA_SNAPSHOT_RETRIES; tries++) {
+        /* Out of memory: only what fits is copied */
+        (void)ARENA_RESERVE_N(task_list.entries, 0, task_list.capacity, needed);
+
+        task_list.count = 0;
+        tasks_seen = 0;
+
+        timed_forbid();
+
+        snapshot_task(SysBase->ThisTask);
+
+        for (node = SysBase->TaskReady.lh_Head; node->ln_Succ != NULL; node = node->ln_Succ) {
+            snapshot_task((struct Task *)node);
+        }
+        for (node = SysBase->TaskWait.lh_Head; node->ln_Succ != NULL; node = node->ln_Succ) {
+            snapshot_task((struct Task *)node);
+        }
+
+        timed_permit("task lists");
+
+        if (tasks_seen <= task_list.capacity) break;
+        needed = tasks_seen + ARENA_SNAPSHOT_SLACK;
+    }
+
+    for (i = 0; i < task_list.count; i++) {
+        TaskEntry *entry = &task_list.entries[i];
+
+        entry->name[sizeof(entry->name) - 1] = '\0';
+        if (entry->name[0] == '\0') {
+            strncpy(entry->name, "(unnamed)", sizeof(entry->name) - 1);
+        }
+
+        entry->stack_used = measure_stack_used(entry->stack_lower, entry->stack_size);
+    }
+
+    /* Simple bubble sort - OK for small lists */
+    for (i = 0; i + 1 < task_list.count; i++) {
+        for (j = 0; j < task_list.count - i - 1; j++) {
+            if (compare_tasks(&task_list.entries[j], &task_list.entries[j + 1]) > 0) {
+                TaskEntry temp = task_list.entries[j];
+                task_list.entries[j] = task_list.entries[j + 1];
+                task_list.entries[j + 1] = temp;
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-FileCopyrightText: 2025 Stefan Reinauer
+
+/*
+ * xSysInfo - Task list header
+ */
+
+#ifndef TASKS_H
+#define TASKS_H
+
+#include "xsysinfo.h"
+
+/* Stack fill above which a task is shown as nearly overflowing (percent) */
+#define STACK_WARN_PERCENT  90
+
+/* Task entry */
+typedef struct {
+    char name[32];
+    APTR address;
+    UBYTE state;            /* TS_RUN, TS_READY or TS_WAIT */
+    BYTE priority;
+    BOOL is_process;
+    ULONG stack_lower;      /* tc_SPLower */
+    ULONG stack_size;
+    ULONG stack_used;       /* High-water mark, untouched memory not counted */
+} TaskEntry;
+
+/* Task list, grown in the arena */
+typedef struct {
+    TaskEntry *entries;
+    ULONG count;
+    ULONG capacity;
+} TaskList;
+
+/* Global task list */
+extern TaskList task_list;
+
+/* Function prototypes */
+
+/* Snapshot TaskReady/TaskWait and measure stack usage */
+void enumerate_tasks(void);
+
+/* Find a task that still exists, NULL if it exited (call under Forbid()) */
+struct Node *find_task_node(APTR task);
+
+/* Short state name ("Run", "Ready", "Wait") */
+const char *get_task_state_string(UBYTE state);
+
+/* Stack fill of a task in percent */
+ULONG get_stack_percent(const TaskEntry *entry);
+
+#endif /* TASKS_H */
@@ -45,6 +45,7 @@ extern struct TextAttr Topaz8Font;
 #define MIN_DOS_VERSION         37
 #define MIN_EXPANSION_VERSION   33
 #define MIN_ICON_VERSION        36
+#define MIN_MMU_VERSION         40
 
 /* Screen dimensions */
 #define SCREEN_WIDTH        640
@@ -78,23 +79,48 @@ typedef enum {
     VIEW_MEMORY,
     VIEW_DRIVES,
     VIEW_BOARDS,
-    VIEW_SCSI
+    VIEW_SCSI,
+    VIEW_COPY,
+    VIEW_PRIORITY,
+    VIEW_ALLOC,
+    VIEW_TRACE,
+    VIEW_MEMTEST,
+    VIEW_CPU,
+    VIEW_INTERRUPTS,
+    VIEW_LATENCY,
+    VIEW_IPC,
+    VIEW_PATCHES,
+    VIEW_RESIDENTS,
+    VIEW_LOADTIME
 } ViewMode;
 
 /* Software list types */
 typedef enum {
     SOFTWARE_LIBRARIES,
     SOFTWARE_DEVICES,
-    SOFTWARE_RESOURCES
+    SOFTWARE_RESOURCES,
+    SOFTWARE_TASKS,
+    SOFTWARE_TYPE_COUNT
 } SoftwareType;
 
+/* Software list order */
+typedef enum {
+    SOFTWARE_SORT_NAME,
+    SOFTWARE_SORT_ADDRESS,
+    SOFTWARE_SORT_SIZE,     /* Largest footprint first */
+    SOFTWARE_SORT_OPENS,    /* Most opened first */
+    SOFTWARE_SORT_COUNT
+} SoftwareSort;
+
 /* Memory location classification */
 typedef enum {
     LOC_ROM,
     LOC_32BIT_RAM,
     LOC_24BIT_RAM,
     LOC_CHIP_RAM,
-    LOC_KICKSTART       /* Special: shows ROM size (256K/512K) */
+    LOC_KICKSTART,      /* Special: shows ROM size (256K/512K) */
+    LOC_SHADOWED_ROM,   /* ROM address served by 32-bit RAM (MapROM) */
+    LOC_REMAPPED_ROM    /* ROM address remapped to RAM by the MMU */
 } MemoryLocation;
 
 /* Bar graph scale modes */
@@ -135,6 +161,7 @@ typedef struct {
     /* Main view state */
     SoftwareType software_type;     /* Which list is shown */
     LONG software_scroll;           /* Scroll offset */
+    SoftwareSort software_sort;     /* Order of the software lists */
     BarScale bar_scale;             /* Current bar graph scale */
     BOOL benchmarks_run;            /* Have benchmarks been executed? */
     BOOL scrollbar_dragging;        /* TRUE while dragging scrollbar */
@@ -143,6 +170,7 @@ typedef struct {
     /* Memory view state */
     LONG memory_region_index;       /* Currently displayed region */
     LONG memory_region_count;       /* Total regions */
+    BOOL memory_live;               /* Live refresh timer running */
 
     /* Drives view state */
     LONG selected_drive;            /* Currently selected drive */